@@ -1,19 +1,21 @@
 /**
  * @file Ejercicio-Final-V.2.0.c
- * @brief Programa que genera números aleatorios, los ordena usando inserción directa
+ * @brief Programa que genera números aleatorios, los ordena con pdqsort
  *        y realiza una búsqueda binaria. Incluye además un ejemplo de estructura
  *        `Asignatura`.
  *
  * Este programa demuestra:
  *   - Generación de números aleatorios.
- *   - Ordenación mediante Inserción Directa.
- *   - Búsqueda binaria sobre un vector ordenado.
+ *   - Ordenación mediante pdqsort (`ordenacion_pdq.h`).
+ *   - Búsqueda binaria sin saltos sobre un vector ordenado.
  *   - Uso básico de estructuras en C.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include "ordenacion_pdq.h"
+#include "busqueda_eytzinger.h"
 
 /**
  * @brief Estructura que representa una asignatura universitaria.
@@ -28,65 +30,39 @@ typedef struct {
 } Asignatura;
 
 /**
- * @brief Ordena un vector de números en orden ascendente usando el método
- *        de Inserción Directa.
+ * @brief Ordena un vector de números en orden ascendente con pdqsort.
  *
- * Este algoritmo compara cada elemento con los anteriores y lo sitúa
- * en su posición correcta desplazando los mayores hacia la derecha.
+ * Quicksort con pivote por mediana de tres que recurre a heapsort si las
+ * particiones salen desequilibradas y ordena los tramos pequeños con una red
+ * de ordenación (AVX2 si está disponible). Ver `ordenacion_pdq.h`.
  *
  * @param v Puntero al vector de números reales.
  * @param n Número de elementos del vector.
  */
 void ordenacion(double *v, int n) {
-    int i, j;
-    double aux;
-
-    for (i = 0; i < n; i++) {
-        aux = v[i];
-        j = i;
-
-        while (j > 0 && v[j - 1] > aux) {
-            v[j] = v[j - 1];
-            j--;
-        }
-
-        v[j] = aux;
-    }
+    ordenar_doubles(v, n);
 }
 
 /**
- * @brief Realiza una búsqueda binaria sobre un vector ordenado.
+ * @brief Realiza una búsqueda binaria sin saltos sobre un vector ordenado.
  *
  * El usuario debe introducir el valor que quiere buscar. Si el valor
- * se encuentra en el vector, se muestra la posición real (comenzando en 1).
+ * se encuentra en el vector, se muestra la posición real (comenzando en 1)
+ * y las comparaciones realizadas. Ver busqueda_sin_saltos_double() en
+ * `busqueda_eytzinger.h`.
  *
  * @param v Puntero al vector ordenado.
  * @param n Número de elementos del vector.
  * @param x Valor que se desea buscar en el vector.
  */
 void binaria(double *v, int n, double x) {
-    int izq = 0;
-    int der = n - 1;
-    int cen;
-    int encontrado = 0;
-
-    while (izq <= der) {
-        cen = (izq + der) / 2;
-
-        if (v[cen] == x) {
-            printf("Valor %.2f encontrado en la posicion real %d\n", x, cen + 1);
-            encontrado = 1;
-            break;
-        }
-
-        if (v[cen] > x)
-            der = cen - 1;
-        else
-            izq = cen + 1;
-    }
+    int comps;
+    int pos = busqueda_sin_saltos_double(v, n, x, &comps);
 
-    if (!encontrado)
-        printf("El valor %.2f NO se encuentra en el vector.\n", x);
+    if (pos >= 0)
+        printf("Valor %.2f encontrado en la posicion real %d (%d comparaciones)\n", x, pos + 1, comps);
+    else
+        printf("El valor %.2f NO se encuentra en el vector (%d comparaciones).\n", x, comps);
 }
 
 /**
@@ -124,7 +100,7 @@ void imprimir(double *v, int n) {
  * Ejecuta los siguientes pasos:
  *   1. Generación de un vector de números aleatorios.
  *   2. Impresión del vector original.
- *   3. Ordenación mediante Inserción Directa.
+ *   3. Ordenación mediante pdqsort.
  *   4. Impresión del vector ordenado.
  *   5. Solicitud al usuario de un número a buscar.
  *   6. Búsqueda binaria del número indicado.
@@ -0,0 +1,280 @@
+#ifndef ALMACEN_VUELOS_H
+#define ALMACEN_VUELOS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tabla_codigos.h"
+
+/**
+ * @file almacen_vuelos.h
+ * @brief Almacén columnar de vuelos (estructura de arrays) con las cadenas codificadas por diccionario.
+ *
+ * En lugar de un nodo por vuelo con tres cadenas de 50 bytes y dos punteros, cada campo es
+ * un vector propio y el vuelo i es la posición i de todos ellos:
+ * - `codigos`: el código empaquetado en un `uint64_t` (tabla_codigo_clave).
+ * - `origenes`, `destinos`, `aerolineas`: identificador de 1 byte de la ciudad o la aerolínea
+ *   en su diccionario (origen y destino comparten el de ciudades).
+ * - `salidas`: fecha y hora juntas, AAAAMMDDHHMM, en un `int64_t`.
+ *
+ * Son 19 bytes por vuelo. Un recorrido que filtra por destino y aerolínea solo lee dos
+ * vectores de bytes consecutivos, y los bucles de recuento y de mínimo no tienen saltos
+ * dependientes de los datos, así que el compilador puede vectorizarlos.
+ *
+ * Solo caben códigos de hasta TABLA_CODIGO_MAX caracteres y ALMACEN_MAX_VALORES valores
+ * distintos por diccionario.
+ */
+
+/** @brief Valores distintos por diccionario (los identificadores caben en un uint8_t). */
+#define ALMACEN_MAX_VALORES 256
+
+/** @brief Capacidad mínima de las columnas. */
+#define ALMACEN_INICIAL 16
+
+/** @brief Bytes de columna que ocupa cada vuelo. */
+#define ALMACEN_BYTES_POR_VUELO (sizeof(uint64_t) + 3 * sizeof(uint8_t) + sizeof(int64_t))
+
+/**
+ * @struct DiccionarioColumna
+ * @brief Valores distintos de una columna de texto; el identificador es la posición.
+ */
+typedef struct {
+    char *valores[ALMACEN_MAX_VALORES];
+    int num_valores;
+} DiccionarioColumna;
+
+/**
+ * @struct AlmacenVuelos
+ * @brief Columnas de vuelos y sus diccionarios.
+ */
+typedef struct {
+    uint64_t *codigos;             /**< Códigos empaquetados. */
+    uint8_t *origenes;             /**< Identificador de la ciudad de origen. */
+    uint8_t *destinos;             /**< Identificador de la ciudad de destino. */
+    uint8_t *aerolineas;           /**< Identificador de la aerolínea. */
+    int64_t *salidas;              /**< Salida AAAAMMDDHHMM. */
+    int tamano;                    /**< Vuelos almacenados. */
+    int capacidad;                 /**< Vuelos que caben en las columnas reservadas. */
+    DiccionarioColumna ciudades;   /**< Diccionario de origen y destino. */
+    DiccionarioColumna companias;  /**< Diccionario de aerolíneas. */
+} AlmacenVuelos;
+
+/**
+ * @brief Identificador de un valor del diccionario.
+ * @return Su identificador, o -1 si no está.
+ */
+static inline int diccionario_columna_id(const DiccionarioColumna *d, const char *valor) {
+    for (int i = 0; i < d->num_valores; i++) {
+        if (strcmp(d->valores[i], valor) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Añade al diccionario un valor que no está en él.
+ * @return Su identificador, o -1 si el diccionario está lleno o falla la memoria.
+ */
+static inline int diccionario_columna_anadir(DiccionarioColumna *d, const char *valor) {
+    if (d->num_valores == ALMACEN_MAX_VALORES) return -1;
+
+    size_t len = strlen(valor) + 1;
+    char *copia = (char *)malloc(len);
+    if (copia == NULL) return -1;
+    memcpy(copia, valor, len);
+    d->valores[d->num_valores] = copia;
+    return d->num_valores++;
+}
+
+/**
+ * @brief Identificador de un valor, añadiéndolo al diccionario si es nuevo.
+ * @return Su identificador, o -1 si el diccionario está lleno o falla la memoria.
+ */
+static inline int diccionario_columna_codificar(DiccionarioColumna *d, const char *valor) {
+    int id = diccionario_columna_id(d, valor);
+    return id >= 0 ? id : diccionario_columna_anadir(d, valor);
+}
+
+/** @brief Quita del diccionario los valores a partir del identificador @p num_valores. */
+static inline void diccionario_columna_recortar(DiccionarioColumna *d, int num_valores) {
+    while (d->num_valores > num_valores) free(d->valores[--d->num_valores]);
+}
+
+/** @brief Libera las cadenas del diccionario. */
+static inline void diccionario_columna_liberar(DiccionarioColumna *d) {
+    diccionario_columna_recortar(d, 0);
+}
+
+/**
+ * @brief Amplía las columnas para que quepan @p capacidad vuelos.
+ *
+ * Si falla una reserva las columnas ya ampliadas se quedan así, pero la capacidad no
+ * cambia y el almacén sigue siendo válido.
+ *
+ * @return 1 si se consigue, 0 si falla la memoria.
+ */
+static inline int almacen_reservar(AlmacenVuelos *a, int capacidad) {
+    if (capacidad <= a->capacidad) return 1;
+
+    uint64_t *codigos = (uint64_t *)realloc(a->codigos, sizeof(uint64_t) * capacidad);
+    if (codigos == NULL) return 0;
+    a->codigos = codigos;
+    uint8_t *origenes = (uint8_t *)realloc(a->origenes, capacidad);
+    if (origenes == NULL) return 0;
+    a->origenes = origenes;
+    uint8_t *destinos = (uint8_t *)realloc(a->destinos, capacidad);
+    if (destinos == NULL) return 0;
+    a->destinos = destinos;
+    uint8_t *aerolineas = (uint8_t *)realloc(a->aerolineas, capacidad);
+    if (aerolineas == NULL) return 0;
+    a->aerolineas = aerolineas;
+    int64_t *salidas = (int64_t *)realloc(a->salidas, sizeof(int64_t) * capacidad);
+    if (salidas == NULL) return 0;
+    a->salidas = salidas;
+
+    a->capacidad = capacidad;
+    return 1;
+}
+
+/** @brief Libera las columnas y los diccionarios; el almacén queda vacío. */
+static inline void almacen_liberar(AlmacenVuelos *a) {
+    free(a->codigos);
+    free(a->origenes);
+    free(a->destinos);
+    free(a->aerolineas);
+    free(a->salidas);
+    a->codigos = NULL;
+    a->origenes = a->destinos = a->aerolineas = NULL;
+    a->salidas = NULL;
+    a->tamano = a->capacidad = 0;
+    diccionario_columna_liberar(&a->ciudades);
+    diccionario_columna_liberar(&a->companias);
+}
+
+/**
+ * @brief Inicializa un almacén vacío con sitio para @p capacidad vuelos.
+ * @return 1 si se crea, 0 si falla la memoria (el almacén queda vacío).
+ */
+static inline int almacen_crear(AlmacenVuelos *a, int capacidad) {
+    memset(a, 0, sizeof(*a));
+    if (!almacen_reservar(a, capacidad > ALMACEN_INICIAL ? capacidad : ALMACEN_INICIAL)) {
+        almacen_liberar(a);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Añade un vuelo al final de las columnas.
+ *
+ * Antes de dar de alta ningún valor nuevo se comprueba que caben todos en sus diccionarios y
+ * se amplían las columnas; si algo falla, los diccionarios quedan como estaban y un vuelo
+ * rechazado no gasta identificadores.
+ *
+ * @param a Almacén.
+ * @param codigo Código del vuelo (hasta TABLA_CODIGO_MAX caracteres).
+ * @param origen Ciudad de origen.
+ * @param destino Ciudad de destino.
+ * @param aerolinea Aerolínea.
+ * @param salida Fecha y hora de salida AAAAMMDDHHMM.
+ * @return Posición del vuelo, o -1 si el código no cabe, un diccionario está lleno o falla la memoria.
+ */
+static inline int almacen_agregar(AlmacenVuelos *a, const char *codigo, const char *origen,
+                                  const char *destino, const char *aerolinea, int64_t salida) {
+    uint64_t clave;
+    if (!tabla_codigo_clave(codigo, &clave)) return -1;
+
+    int id_origen = diccionario_columna_id(&a->ciudades, origen);
+    int id_destino = diccionario_columna_id(&a->ciudades, destino);
+    int id_aerolinea = diccionario_columna_id(&a->companias, aerolinea);
+    int ciudades_nuevas = (id_origen < 0) + (id_destino < 0 && strcmp(origen, destino) != 0);
+    if (a->ciudades.num_valores + ciudades_nuevas > ALMACEN_MAX_VALORES) return -1;
+    if (id_aerolinea < 0 && a->companias.num_valores == ALMACEN_MAX_VALORES) return -1;
+    if (a->tamano == a->capacidad && !almacen_reservar(a, a->capacidad * 2)) return -1;
+
+    // Solo puede fallar la copia de una cadena: se deshacen las altas de este vuelo
+    int num_ciudades = a->ciudades.num_valores;
+    int num_companias = a->companias.num_valores;
+    if (id_origen < 0) id_origen = diccionario_columna_anadir(&a->ciudades, origen);
+    if (id_destino < 0) id_destino = diccionario_columna_codificar(&a->ciudades, destino);
+    if (id_aerolinea < 0) id_aerolinea = diccionario_columna_anadir(&a->companias, aerolinea);
+    if (id_origen < 0 || id_destino < 0 || id_aerolinea < 0) {
+        diccionario_columna_recortar(&a->ciudades, num_ciudades);
+        diccionario_columna_recortar(&a->companias, num_companias);
+        return -1;
+    }
+
+    int i = a->tamano++;
+    a->codigos[i] = clave;
+    a->origenes[i] = (uint8_t)id_origen;
+    a->destinos[i] = (uint8_t)id_destino;
+    a->aerolineas[i] = (uint8_t)id_aerolinea;
+    a->salidas[i] = salida;
+    return i;
+}
+
+/**
+ * @brief Escribe el código del vuelo @p i como cadena.
+ * @param buffer Buffer de al menos TABLA_CODIGO_MAX + 1 caracteres.
+ */
+static inline void almacen_codigo(const AlmacenVuelos *a, int i, char *buffer) {
+    memcpy(buffer, &a->codigos[i], TABLA_CODIGO_MAX);
+    buffer[TABLA_CODIGO_MAX] = '\0';
+}
+
+/**
+ * @brief Cuenta los vuelos con un destino y una aerolínea dados.
+ *
+ * Se suma el resultado de la comparación en lugar de saltar, así que el bucle se vectoriza.
+ *
+ * @param id_destino Identificador de la ciudad en `ciudades`.
+ * @param id_aerolinea Identificador en `companias`.
+ */
+static inline int almacen_contar(const AlmacenVuelos *a, int id_destino, int id_aerolinea) {
+    const uint8_t *destinos = a->destinos, *aerolineas = a->aerolineas;
+    const uint8_t d = (uint8_t)id_destino, l = (uint8_t)id_aerolinea;
+    int n = 0;
+    for (int i = 0; i < a->tamano; i++) {
+        n += (destinos[i] == d) & (aerolineas[i] == l);
+    }
+    return n;
+}
+
+/**
+ * @brief Posiciones de los vuelos con un destino y una aerolínea dados, en orden de almacén.
+ *
+ * Cada posición se escribe siempre y solo avanza el contador si el vuelo cumple el filtro.
+ *
+ * @param posiciones Vector de al menos `tamano` enteros.
+ * @return Número de posiciones escritas.
+ */
+static inline int almacen_filtrar(const AlmacenVuelos *a, int id_destino, int id_aerolinea, int *posiciones) {
+    const uint8_t *destinos = a->destinos, *aerolineas = a->aerolineas;
+    const uint8_t d = (uint8_t)id_destino, l = (uint8_t)id_aerolinea;
+    int n = 0;
+    for (int i = 0; i < a->tamano; i++) {
+        posiciones[n] = i;
+        n += (destinos[i] == d) & (aerolineas[i] == l);
+    }
+    return n;
+}
+
+/**
+ * @brief Posición del vuelo con la salida más temprana.
+ *
+ * Primero se reduce la columna al mínimo (sin saltos) y después se busca su posición.
+ *
+ * @return La posición, o -1 si el almacén está vacío.
+ */
+static inline int almacen_primera_salida(const AlmacenVuelos *a) {
+    if (a->tamano == 0) return -1;
+    const int64_t *salidas = a->salidas;
+    int64_t minimo = salidas[0];
+    for (int i = 1; i < a->tamano; i++) {
+        minimo = salidas[i] < minimo ? salidas[i] : minimo;
+    }
+    int i = 0;
+    while (salidas[i] != minimo) i++;
+    return i;
+}
+
+#endif
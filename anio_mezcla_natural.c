@@ -5,6 +5,17 @@
  * Este módulo permite ordenar un archivo binario de registros de tipo `Libro` 
  * por año de publicación usando el método de mezcla natural. 
  * Se crean archivos auxiliares para manejar secuencias parciales ordenadas.
+ *
+ * La primera separación genera las secuencias por selección con reemplazo
+ * (ver `seleccion_reemplazo.h`) con un búfer de M registros, de modo que
+ * miden de media 2·M registros en lugar de las que ya trae la entrada.
+ *
+ * Por defecto el archivo se ordena con la mezcla de K vías de
+ * `ordenacion_externa.h`, que necesita muchas menos pasadas; `--natural`
+ * conserva la mezcla natural con los dos auxiliares.
+ *
+ * Uso: `anio_mezcla_natural [--natural] [--memoria=M] [--vias=K] [--polifasica] [--radix]`
+ * (con `--natural`, M = 0 usa solo las secuencias naturales).
  */
 
 #include <stdio.h>
@@ -12,6 +23,9 @@
 #include <string.h>
 #include <stdbool.h>
 #include "common.h" // Define la estructura Libro y NOMBRE_ARCHIVO
+#include "libros_io.h" // Lectura y escritura del formato binario con cabecera
+#include "seleccion_reemplazo.h" // Generación de secuencias iniciales largas
+#include "ordenacion_externa.h" // Mezcla de K vías con árbol de perdedores
 
 #define AUX1 "aux1.bin" /**< Archivo auxiliar 1 */
 #define AUX2 "aux2.bin" /**< Archivo auxiliar 2 */
@@ -25,8 +39,10 @@
  * @param NOMBRE_F Archivo principal a ordenar.
  * @param NOMBRE_F1 Archivo auxiliar 1.
  * @param NOMBRE_F2 Archivo auxiliar 2.
+ * @param MEMORIA Registros en memoria para la primera separación por selección
+ *        con reemplazo (0 para separar solo las secuencias naturales).
  */
-void clasificacion_mezcla_natural(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2);
+void clasificacion_mezcla_natural(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2, long MEMORIA);
 
 /**
  * @brief Separa el archivo principal en dos archivos auxiliares con secuencias ordenadas.
@@ -38,13 +54,23 @@ void clasificacion_mezcla_natural(const char *NOMBRE_F, const char *NOMBRE_F1, c
  */
 void separar(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2);
 
+/**
+ * @brief Primera separación: genera secuencias por selección con reemplazo.
+ * @param NOMBRE_F Archivo principal.
+ * @param NOMBRE_F1 Archivo auxiliar 1 (secuencias pares).
+ * @param NOMBRE_F2 Archivo auxiliar 2 (secuencias impares).
+ * @param MEMORIA Registros que caben en el montículo.
+ * @return Número de secuencias generadas.
+ */
+long separar_seleccion_reemplazo(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2, long MEMORIA);
+
 /**
  * @brief Copia una secuencia ordenada desde un archivo origen a uno destino.
  * @param F_O Archivo origen.
  * @param F_D Archivo destino.
  * @param REG Registro actual de tipo Libro.
  */
-void copiar_secuencia(FILE *F_O, FILE *F_D, Libro *REG);
+void copiar_secuencia(ArchivoLibros *F_O, ArchivoLibros *F_D, Libro *REG);
 
 /**
  * @brief Lee el siguiente registro y determina si continúa la secuencia.
@@ -52,7 +78,7 @@ void copiar_secuencia(FILE *F_O, FILE *F_D, Libro *REG);
  * @param REG Registro actual que se actualizará.
  * @param PARAR Puntero a variable bool que se establece en true si la secuencia termina.
  */
-void leer_y_chequear(FILE *FICH, Libro *REG, bool *PARAR);
+void leer_y_chequear(ArchivoLibros *FICH, Libro *REG, bool *PARAR);
 
 /**
  * @brief Mezcla secuencias alternas de los archivos auxiliares en el archivo principal.
@@ -73,53 +99,96 @@ void mostrar_libros(const char *nombreArchivo);
 // IMPLEMENTACIÓN DE FUNCIONES
 // ------------------------------------------------------
 
-void clasificacion_mezcla_natural(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2) {
+void clasificacion_mezcla_natural(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2, long MEMORIA) {
     int L; /**< Número de secuencias resultantes tras cada pasada */
+    bool PRIMERA = MEMORIA > 0;
 
     do {
-        separar(NOMBRE_F, NOMBRE_F1, NOMBRE_F2);
+        if (PRIMERA) {
+            long S = separar_seleccion_reemplazo(NOMBRE_F, NOMBRE_F1, NOMBRE_F2, MEMORIA);
+            printf("Secuencias iniciales por selección con reemplazo (M=%ld): %ld\n", MEMORIA, S);
+            PRIMERA = false;
+        } else {
+            separar(NOMBRE_F, NOMBRE_F1, NOMBRE_F2);
+        }
         L = mezcla_natural(NOMBRE_F, NOMBRE_F1, NOMBRE_F2);
         printf("Secuencias mezcladas en esta pasada: %d\n", L);
     } while (L > 1);
 }
 
 void separar(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2) {
-    FILE *F = fopen(NOMBRE_F, "rb");
-    FILE *F1 = fopen(NOMBRE_F1, "wb");
-    FILE *F2 = fopen(NOMBRE_F2, "wb");
+    ArchivoLibros F, F1, F2;
     Libro REG;
 
-    if (!F || !F1 || !F2) {
+    if (!libros_abrir(&F, NOMBRE_F) ||
+        !libros_crear(&F1, NOMBRE_F1, ORDEN_NINGUNO) ||
+        !libros_crear(&F2, NOMBRE_F2, ORDEN_NINGUNO)) {
         perror("Error al abrir archivos en separar()");
         exit(EXIT_FAILURE);
     }
 
-    if (fread(&REG, sizeof(Libro), 1, F) != 1) {
-        fclose(F); fclose(F1); fclose(F2);
+    if (!libros_leer(&F, &REG)) {
+        libros_cerrar(&F); libros_cerrar(&F1); libros_cerrar(&F2);
         return;
     }
 
     do {
-        copiar_secuencia(F, F1, &REG);
-        if (!feof(F)) {
-            copiar_secuencia(F, F2, &REG);
+        copiar_secuencia(&F, &F1, &REG);
+        if (!libros_fin(&F)) {
+            copiar_secuencia(&F, &F2, &REG);
         }
-    } while (!feof(F));
+    } while (!libros_fin(&F));
 
-    fclose(F); fclose(F1); fclose(F2);
+    libros_cerrar(&F); libros_cerrar(&F1); libros_cerrar(&F2);
 }
 
-void copiar_secuencia(FILE *F_O, FILE *F_D, Libro *REG) {
+/**
+ * @brief Auxiliares de destino de las secuencias generadas.
+ */
+typedef struct {
+    ArchivoLibros *AUX[2];
+} RepartoSecuencias;
+
+/**
+ * @brief Escribe cada registro en el auxiliar de su secuencia (alternando entre los dos).
+ */
+static int repartir_secuencia(const Libro *REG, long SECUENCIA, void *CTX) {
+    RepartoSecuencias *R = (RepartoSecuencias *)CTX;
+    return libros_anadir(R->AUX[SECUENCIA % 2], REG);
+}
+
+long separar_seleccion_reemplazo(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2, long MEMORIA) {
+    ArchivoLibros F, F1, F2;
+
+    if (!libros_abrir(&F, NOMBRE_F) ||
+        !libros_crear(&F1, NOMBRE_F1, ORDEN_NINGUNO) ||
+        !libros_crear(&F2, NOMBRE_F2, ORDEN_NINGUNO)) {
+        perror("Error al abrir archivos en separar_seleccion_reemplazo()");
+        exit(EXIT_FAILURE);
+    }
+
+    RepartoSecuencias R = { { &F1, &F2 } };
+    long S = seleccion_reemplazo(&F, MEMORIA, comparar_libros_anio, repartir_secuencia, &R);
+
+    libros_cerrar(&F);
+    if (!libros_cerrar(&F1) || !libros_cerrar(&F2) || S < 0) {
+        perror("Error en la selección con reemplazo");
+        exit(EXIT_FAILURE);
+    }
+    return S;
+}
+
+void copiar_secuencia(ArchivoLibros *F_O, ArchivoLibros *F_D, Libro *REG) {
     bool PARAR = false;
     do {
-        fwrite(REG, sizeof(Libro), 1, F_D);
+        libros_anadir(F_D, REG);
         leer_y_chequear(F_O, REG, &PARAR);
     } while (!PARAR);
 }
 
-void leer_y_chequear(FILE *FICH, Libro *REG, bool *PARAR) {
+void leer_y_chequear(ArchivoLibros *FICH, Libro *REG, bool *PARAR) {
     Libro REG_SIG;
-    if (fread(&REG_SIG, sizeof(Libro), 1, FICH) == 1) {
+    if (libros_leer(FICH, &REG_SIG)) {
         if (REG->anioPublicacion > REG_SIG.anioPublicacion) {
             *PARAR = true;
         }
@@ -130,57 +199,83 @@ void leer_y_chequear(FILE *FICH, Libro *REG, bool *PARAR) {
 }
 
 int mezcla_natural(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2) {
-    FILE *F = fopen(NOMBRE_F, "wb");
-    FILE *F1 = fopen(NOMBRE_F1, "rb");
-    FILE *F2 = fopen(NOMBRE_F2, "rb");
+    ArchivoLibros F, F1, F2;
     Libro R1, R2;
     bool FIN_ORDEN1 = false, FIN_ORDEN2 = false;
     int L = 0;
 
-    if (!F || !F1 || !F2) {
+    if (!libros_crear(&F, NOMBRE_F, ORDEN_NINGUNO) ||
+        !libros_abrir(&F1, NOMBRE_F1) ||
+        !libros_abrir(&F2, NOMBRE_F2)) {
         perror("Error al abrir archivos en mezcla_natural()");
         exit(EXIT_FAILURE);
     }
 
-    size_t leido1 = fread(&R1, sizeof(Libro), 1, F1);
-    size_t leido2 = fread(&R2, sizeof(Libro), 1, F2);
+    size_t leido1 = libros_leer(&F1, &R1);
+    size_t leido2 = libros_leer(&F2, &R2);
 
     while (leido1 == 1 || leido2 == 1) {
         L++;
         FIN_ORDEN1 = (leido1 != 1);
         FIN_ORDEN2 = (leido2 != 1);
 
-        while (!FIN_ORDEN1 || !FIN_ORDEN2) {
-            if (!FIN_ORDEN1 && (FIN_ORDEN2 || R1.anioPublicacion <= R2.anioPublicacion)) {
-                fwrite(&R1, sizeof(Libro), 1, F);
-                leer_y_chequear(F1, &R1, &FIN_ORDEN1);
-                leido1 = (FIN_ORDEN1 && feof(F1)) ? 0 : 1;
-                if (FIN_ORDEN1) { copiar_secuencia(F2, F, &R2); leido2 = 0; break; }
-            } else if (!FIN_ORDEN2) {
-                fwrite(&R2, sizeof(Libro), 1, F);
-                leer_y_chequear(F2, &R2, &FIN_ORDEN2);
-                leido2 = (FIN_ORDEN2 && feof(F2)) ? 0 : 1;
-                if (FIN_ORDEN2) { copiar_secuencia(F1, F, &R1); leido1 = 0; break; }
+        while (!FIN_ORDEN1 && !FIN_ORDEN2) {
+            if (R1.anioPublicacion <= R2.anioPublicacion) {
+                libros_anadir(&F, &R1);
+                leer_y_chequear(&F1, &R1, &FIN_ORDEN1);
             } else {
-                break;
+                libros_anadir(&F, &R2);
+                leer_y_chequear(&F2, &R2, &FIN_ORDEN2);
             }
         }
 
-        if (leido1 == 0 && !feof(F1)) leido1 = fread(&R1, sizeof(Libro), 1, F1);
-        if (leido2 == 0 && !feof(F2)) leido2 = fread(&R2, sizeof(Libro), 1, F2);
+        // Copiar el resto de la secuencia que no ha terminado
+        if (!FIN_ORDEN1) copiar_secuencia(&F1, &F, &R1);
+        if (!FIN_ORDEN2) copiar_secuencia(&F2, &F, &R2);
+
+        // Si el archivo no se ha agotado, R1/R2 ya contiene el primer registro
+        // de su siguiente secuencia: no hay que volver a leer
+        leido1 = libros_fin(&F1) ? 0 : 1;
+        leido2 = libros_fin(&F2) ? 0 : 1;
     }
 
-    fclose(F); fclose(F1); fclose(F2);
+    if (L <= 1) libros_fijar_orden(&F, ORDEN_ANIO); // Una sola secuencia: archivo ordenado
+
+    libros_cerrar(&F); libros_cerrar(&F1); libros_cerrar(&F2);
     return L;
 }
 
-int main(void) {
+int main(int argc, char *argv[]) {
+    long MEMORIA = -1;       /**< Registros en memoria (-1: valor por defecto del método) */
+    bool NATURAL = false;    /**< true para usar la mezcla natural con dos auxiliares */
+    OpcionesOrdenacion OP;   /**< Opciones de la ordenación externa de K vías */
+    opciones_ordenacion_defecto(&OP, ORDEN_ANIO);
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--memoria=", 10) == 0) MEMORIA = atol(argv[i] + 10);
+        else if (strcmp(argv[i], "--natural") == 0) NATURAL = true;
+        else if (strncmp(argv[i], "--vias=", 7) == 0) OP.fan_in = atoi(argv[i] + 7);
+        else if (strcmp(argv[i], "--polifasica") == 0) OP.polifasica = 1;
+        else if (strcmp(argv[i], "--radix") == 0) OP.radix = 1;
+    }
+
     printf("=== ORDENACIÓN POR MEZCLA NATURAL (AÑO) ===\n");
 
     printf("\nArchivo original ('%s'):\n", NOMBRE_ARCHIVO);
     mostrar_libros(NOMBRE_ARCHIVO);
 
-    clasificacion_mezcla_natural(NOMBRE_ARCHIVO, AUX1, AUX2);
+    if (NATURAL) {
+        clasificacion_mezcla_natural(NOMBRE_ARCHIVO, AUX1, AUX2, MEMORIA < 0 ? SELECCION_MEMORIA_DEFECTO : MEMORIA);
+    } else {
+        EstadisticasOrdenacion EST;
+        if (MEMORIA > 0) OP.memoria = MEMORIA;
+        if (!ordenar_externo(NOMBRE_ARCHIVO, NOMBRE_ARCHIVO, &OP, &EST)) {
+            fprintf(stderr, "Error en la ordenación externa.\n");
+            return 1;
+        }
+        printf("Secuencias iniciales: %ld | %s de mezcla de %d vías: %d\n", EST.secuencias,
+               OP.polifasica ? "Fases" : "Pasadas", OP.fan_in, EST.pasadas);
+    }
 
     printf("\n=== ARCHIVO FINAL ORDENADO ===\n");
     mostrar_libros(NOMBRE_ARCHIVO);
@@ -189,8 +284,8 @@ int main(void) {
 }
 
 void mostrar_libros(const char *nombreArchivo) {
-    FILE *f = fopen(nombreArchivo, "rb");
-    if (!f) { 
+    ArchivoLibros f;
+    if (!libros_abrir(&f, nombreArchivo)) { 
         printf("¡ERROR! Archivo '%s' no encontrado.\n", nombreArchivo);
         return; 
     }
@@ -201,12 +296,12 @@ void mostrar_libros(const char *nombreArchivo) {
     printf("----------------------------------------------------------------------------------------------------------------\n");
 
     int i = 0;
-    while (fread(&libro, sizeof(Libro), 1, f) == 1) {
+    while (libros_leer(&f, &libro)) {
         printf("%-5d | %-5d | %-40s | %-25s | %-8.2f |\n",
                ++i, libro.anioPublicacion, libro.titulo, libro.autor, libro.precio);
     }
 
     printf("----------------------------------------------------------------------------------------------------------------\n");
-    fclose(f);
+    libros_cerrar(&f);
 }
 
@@ -0,0 +1,155 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+ * @file arena.h
+ * @brief Reserva por bloques (slab) de nodos de tamaño fijo, con lista libre y liberación en bloque.
+ *
+ * En lugar de un `malloc` por nodo, la arena pide al sistema bloques de
+ * muchos nodos y los va entregando uno a uno. Los nodos devueltos con
+ * @ref arena_liberar se encadenan en una lista libre (usando su propia
+ * memoria como enlace) y son los primeros en reutilizarse, así que reservar
+ * y liberar cuestan O(1) sin llamar a `malloc`/`free`.
+ *
+ * Cada bloque nuevo tiene el doble de nodos que el anterior, hasta
+ * @ref ARENA_BLOQUE_MAX. @ref arena_destruir libera todos los nodos a la vez
+ * devolviendo solo los bloques, sin recorrer las estructuras que los usan.
+ *
+ * Los nodos quedan alineados a @ref ARENA_ALINEACION bytes.
+ */
+
+/** @brief Alineación de cada nodo entregado. */
+#define ARENA_ALINEACION 16
+
+/** @brief Nodos máximos por bloque. */
+#define ARENA_BLOQUE_MAX 65536
+
+/** @brief Tamaño de nodo que usa la arena: el pedido, con sitio para el enlace y redondeado a la alineación. */
+#define ARENA_TAM_NODO(tam) \
+    ((((tam) < sizeof(void *) ? sizeof(void *) : (tam)) + ARENA_ALINEACION - 1) / ARENA_ALINEACION * ARENA_ALINEACION)
+
+/** @brief Inicializador estático de una arena de nodos de @p tam bytes con bloques iniciales de @p n nodos. */
+#define ARENA_INICIAL(tam, n) { ARENA_TAM_NODO(tam), (n), (n), NULL, NULL, NULL, NULL, 0 }
+
+/**
+ * @struct BloqueArena
+ * @brief Cabecera de cada bloque pedido al sistema; los nodos van a continuación.
+ */
+typedef struct BloqueArena {
+    struct BloqueArena *siguiente;
+    size_t nodos;
+} BloqueArena;
+
+/** @brief Espacio reservado para la cabecera de un bloque (mantiene la alineación de los nodos). */
+#define ARENA_CABECERA ((sizeof(BloqueArena) + ARENA_ALINEACION - 1) / ARENA_ALINEACION * ARENA_ALINEACION)
+
+/**
+ * @struct Arena
+ * @brief Arena de nodos de un mismo tamaño.
+ */
+typedef struct {
+    size_t tam_nodo;       /**< Bytes por nodo (ARENA_TAM_NODO). */
+    size_t nodos_inicial;  /**< Nodos del primer bloque. */
+    size_t nodos_bloque;   /**< Nodos del próximo bloque. */
+    BloqueArena *bloques;  /**< Bloques pedidos al sistema, el más reciente primero. */
+    char *libre;           /**< Primer nodo sin estrenar del bloque actual. */
+    char *fin;             /**< Fin del bloque actual. */
+    void *lista_libre;     /**< Nodos devueltos, encadenados por su primera palabra. */
+    size_t vivos;          /**< Nodos entregados y no devueltos. */
+} Arena;
+
+/**
+ * @brief Inicializa una arena vacía (no reserva memoria hasta el primer nodo).
+ * @param a Arena.
+ * @param tam Tamaño de cada nodo (normalmente `sizeof` del struct).
+ * @param nodos_bloque Nodos del primer bloque.
+ */
+static inline void arena_iniciar(Arena *a, size_t tam, size_t nodos_bloque) {
+    Arena vacia = ARENA_INICIAL(tam, nodos_bloque > 0 ? nodos_bloque : 1);
+    *a = vacia;
+}
+
+/**
+ * @brief Entrega un nodo sin inicializar.
+ * @param a Arena.
+ * @return Puntero al nodo, o NULL si no hay memoria.
+ */
+static inline void *arena_reservar(Arena *a) {
+    void *nodo = a->lista_libre;
+    if (nodo != NULL) {
+        a->lista_libre = *(void **)nodo;
+    } else {
+        if (a->libre == a->fin) {
+            BloqueArena *b = malloc(ARENA_CABECERA + a->tam_nodo * a->nodos_bloque);
+            if (b == NULL) return NULL;
+            b->siguiente = a->bloques;
+            b->nodos = a->nodos_bloque;
+            a->bloques = b;
+            a->libre = (char *)b + ARENA_CABECERA;
+            a->fin = a->libre + a->tam_nodo * a->nodos_bloque;
+            if (a->nodos_bloque < ARENA_BLOQUE_MAX) a->nodos_bloque *= 2;
+        }
+        nodo = a->libre;
+        a->libre += a->tam_nodo;
+    }
+    a->vivos++;
+    return nodo;
+}
+
+/**
+ * @brief Entrega @p n nodos contiguos en un bloque propio (cargas masivas).
+ *
+ * El bloque queda registrado en la arena: sus nodos se pueden devolver uno a
+ * uno con @ref arena_liberar y se liberan con @ref arena_destruir.
+ *
+ * @param a Arena.
+ * @param n Número de nodos.
+ * @return Puntero al primero de los @p n nodos, o NULL si no hay memoria.
+ */
+static inline void *arena_reservar_bloque(Arena *a, size_t n) {
+    if (n == 0) return NULL;
+    BloqueArena *b = malloc(ARENA_CABECERA + a->tam_nodo * n);
+    if (b == NULL) return NULL;
+    b->siguiente = a->bloques;
+    b->nodos = n;
+    a->bloques = b;
+    a->vivos += n;
+    return (char *)b + ARENA_CABECERA;
+}
+
+/**
+ * @brief Devuelve un nodo a la arena para reutilizarlo.
+ * @param a Arena de la que salió el nodo.
+ * @param nodo Nodo a devolver (NULL no hace nada).
+ */
+static inline void arena_liberar(Arena *a, void *nodo) {
+    if (nodo == NULL) return;
+    *(void **)nodo = a->lista_libre;
+    a->lista_libre = nodo;
+    a->vivos--;
+}
+
+/**
+ * @brief Libera de golpe todos los nodos de la arena, devolviendo sus bloques al sistema.
+ *
+ * Los punteros a nodos de la arena dejan de ser válidos. La arena queda
+ * vacía y se puede volver a usar.
+ *
+ * @param a Arena.
+ */
+static inline void arena_destruir(Arena *a) {
+    while (a->bloques != NULL) {
+        BloqueArena *b = a->bloques;
+        a->bloques = b->siguiente;
+        free(b);
+    }
+    a->nodos_bloque = a->nodos_inicial;
+    a->libre = a->fin = NULL;
+    a->lista_libre = NULL;
+    a->vivos = 0;
+}
+
+#endif // ARENA_H
@@ -2,29 +2,32 @@
 #include <stdlib.h>
 #include <string.h>
 #include "common.h"  // Contiene la definición de la estructura Libro, NOMBRE_ARCHIVO y CAD_TITULO
+#include "libros_io.h" // Lectura del archivo binario con cabecera
+#include "libros_mapa.h" // Recorrido sin copias sobre el archivo proyectado con mmap
+#include "indice_titulos.h" // Índice B+ de títulos (libros_biblioteca.idx)
 
 /**
  * @brief Realiza una búsqueda lineal de un libro en el archivo binario por título.
  *
- * La función abre el archivo binario definido en NOMBRE_ARCHIVO y recorre
+ * La función abre el archivo binario indicado y recorre
  * secuencialmente todos los registros (estructura Libro) hasta encontrar
  * un título que coincida exactamente con el proporcionado por el usuario.
  *
  * Si el título es encontrado, muestra su información completa (título, autor y estado de préstamo)
  * y la posición del registro en el archivo. Si no se encuentra, informa al usuario.
  *
+ * @param nombre_archivo Archivo binario de libros.
  * @param titulo_buscado Cadena de texto con el título a buscar.
  */
-void busqueda_lineal_archivo(const char *titulo_buscado) {
-    FILE *archivo = NULL;
+void busqueda_lineal_archivo(const char *nombre_archivo, const char *titulo_buscado) {
+    ArchivoLibros archivo;
     Libro libro_actual;              // Estructura para almacenar temporalmente cada registro leído
     long posicion_registro = 0;      // Contador de posición (índice del registro dentro del archivo)
-    size_t elementos_leidos;         // Controla la cantidad de registros leídos con fread()
 
     // 1. Abrir el archivo en modo lectura binaria
-    archivo = fopen(NOMBRE_ARCHIVO, "rb");
-    if (archivo == NULL) {
-        perror("Error al abrir el archivo binario");
+    if (!libros_abrir(&archivo, nombre_archivo)) {
+        fprintf(stderr, "Error al abrir el archivo binario %s: ", nombre_archivo);
+        perror(NULL);
         return;
     }
 
@@ -32,7 +35,7 @@ void busqueda_lineal_archivo(const char *titulo_buscado) {
 
     // 2. Leer secuencialmente los registros hasta el final del archivo
     // Implementación clásica del algoritmo de búsqueda lineal
-    while ((elementos_leidos = fread(&libro_actual, sizeof(Libro), 1, archivo)) == 1) {
+    while (libros_leer(&archivo, &libro_actual)) {
 
         // 3. Comparar el título del registro actual con el buscado (strcmp retorna 0 si son iguales)
         if (strcmp(libro_actual.titulo, titulo_buscado) == 0) {
@@ -46,7 +49,7 @@ void busqueda_lineal_archivo(const char *titulo_buscado) {
             printf("Estado Préstamo: %s\n", libro_actual.prestado);
             printf("----------------------------------------\n");
 
-            fclose(archivo);
+            libros_cerrar(&archivo);
             return; // Se termina la función al encontrar el libro
         }
 
@@ -55,47 +58,221 @@ void busqueda_lineal_archivo(const char *titulo_buscado) {
     }
 
     // 5. Evaluar si la lectura terminó correctamente o por error
-    if (feof(archivo)) {
+    if (!libros_error(&archivo)) {
         printf("----------------------------------------\n");
         printf("BÚSQUEDA FINALIZADA: El título \"%s\" no fue encontrado.\n", titulo_buscado);
         printf("----------------------------------------\n");
-    } else if (ferror(archivo)) {
+    } else {
         perror("Error de lectura durante la búsqueda");
     }
 
-    fclose(archivo);
+    libros_cerrar(&archivo);
+}
+
+/**
+ * @brief Contexto de la búsqueda por título sobre los registros proyectados.
+ */
+typedef struct {
+    const char *titulo;   // Título buscado
+    long posicion;        // Posición del registro encontrado (-1 si no se ha encontrado)
+    Libro libro;          // Copia del registro encontrado
+} BusquedaTitulo;
+
+/**
+ * @brief Condición evaluada directamente sobre cada registro proyectado.
+ * @return 1 para detener el recorrido al encontrar el título, 0 para seguir.
+ */
+static int coincide_titulo(const Libro *libro, long pos, void *ctx) {
+    BusquedaTitulo *b = (BusquedaTitulo *)ctx;
+    if (strcmp(libro->titulo, b->titulo) != 0) return 0;
+    b->posicion = pos;
+    b->libro = *libro; // Solo se copia el registro encontrado
+    return 1;
+}
+
+/**
+ * @brief Búsqueda lineal por título sin copiar los registros.
+ *
+ * Recorre el archivo proyectado en memoria con mmap y compara cada título
+ * en su sitio. Si el archivo no se puede proyectar (por ejemplo si se lee
+ * de una tubería con el nombre "-") se lee por bloques con un búfer.
+ *
+ * @param nombre_archivo Archivo binario de libros, o "-" para la entrada estándar.
+ * @param titulo_buscado Cadena de texto con el título a buscar.
+ */
+void busqueda_lineal_mapeada(const char *nombre_archivo, const char *titulo_buscado) {
+    BusquedaTitulo b = { .titulo = titulo_buscado, .posicion = -1 };
+
+    printf("Buscando el título: \"%s\" en el archivo (modo mmap)...\n", titulo_buscado);
+
+    if (libros_escanear(nombre_archivo, coincide_titulo, &b) < 0) {
+        perror("Error al abrir el archivo binario");
+        return;
+    }
+
+    printf("----------------------------------------\n");
+    if (b.posicion >= 0) {
+        printf("¡LIBRO ENCONTRADO!\n");
+        printf("Posición del registro (índice 0): %ld\n", b.posicion);
+        printf("Título: %s\n", b.libro.titulo);
+        printf("Autor: %s\n", b.libro.autor);
+        printf("Estado Préstamo: %s\n", b.libro.prestado);
+    } else {
+        printf("BÚSQUEDA FINALIZADA: El título \"%s\" no fue encontrado.\n", titulo_buscado);
+    }
+    printf("----------------------------------------\n");
+}
+
+/**
+ * @brief Nombre del índice de títulos que corresponde a un archivo de datos.
+ *
+ * Se sustituye la extensión `.bin` por `.idx` (o se añade si no la tiene),
+ * así que para `libros_biblioteca.bin` es @ref NOMBRE_INDICE_TITULOS.
+ *
+ * @param nombre_archivo Archivo binario de libros.
+ * @param nombre_indice Buffer donde se escribe el nombre.
+ * @param tam Tamaño del buffer.
+ * @return 1 si el nombre cabe en el buffer, 0 en caso contrario.
+ */
+static int nombre_indice_titulos(const char *nombre_archivo, char *nombre_indice, size_t tam) {
+    size_t len = strlen(nombre_archivo);
+    if (len >= 4 && strcmp(nombre_archivo + len - 4, ".bin") == 0) len -= 4;
+    int n = snprintf(nombre_indice, tam, "%.*s.idx", (int)len, nombre_archivo);
+    return n >= 0 && (size_t)n < tam;
+}
+
+/**
+ * @brief Busca un título usando el índice B+ del archivo (`libros_biblioteca.idx`).
+ *
+ * Desciende por el árbol del índice leyendo una página por nivel (O(log N)
+ * lecturas) y después lee directamente el registro indicado del archivo de
+ * datos. Si el índice no existe o no corresponde al contenido actual del
+ * archivo, avisa y recurre a la búsqueda lineal.
+ *
+ * @param nombre_archivo Archivo binario de libros (de él sale el nombre del índice).
+ * @param titulo_buscado Cadena de texto con el título a buscar.
+ */
+void busqueda_indexada(const char *nombre_archivo, const char *titulo_buscado) {
+    ArchivoLibros archivo;
+    IndiceTitulos indice;
+    Libro libro;
+    char nombre_indice[FILENAME_MAX];
+
+    if (!libros_abrir(&archivo, nombre_archivo)) {
+        fprintf(stderr, "Error al abrir el archivo binario %s: ", nombre_archivo);
+        perror(NULL);
+        return;
+    }
+
+    if (!nombre_indice_titulos(nombre_archivo, nombre_indice, sizeof(nombre_indice))) {
+        printf("Aviso: ruta demasiado larga para el índice. Se usa la búsqueda lineal.\n");
+        libros_cerrar(&archivo);
+        busqueda_lineal_archivo(nombre_archivo, titulo_buscado);
+        return;
+    }
+
+    if (!indice_titulos_abrir(&indice, nombre_indice) || !indice_titulos_vigente(&indice, &archivo)) {
+        printf("Aviso: índice '%s' ausente o desactualizado (ejecute indexar_biblioteca). "
+               "Se usa la búsqueda lineal.\n", nombre_indice);
+        indice_titulos_cerrar(&indice);
+        libros_cerrar(&archivo);
+        busqueda_lineal_archivo(nombre_archivo, titulo_buscado);
+        return;
+    }
+
+    printf("Buscando el título: \"%s\" en el índice...\n", titulo_buscado);
+
+    long posicion = indice_titulos_buscar(&indice, titulo_buscado);
+
+    printf("----------------------------------------\n");
+    if (posicion >= 0 && libros_leer_en(&archivo, posicion, &libro)) {
+        printf("¡LIBRO ENCONTRADO!\n");
+        printf("Posición del registro (índice 0): %ld\n", posicion);
+        printf("Título: %s\n", libro.titulo);
+        printf("Autor: %s\n", libro.autor);
+        printf("Estado Préstamo: %s\n", libro.prestado);
+    } else if (posicion >= 0) {
+        perror("Error de lectura durante la búsqueda");
+    } else {
+        printf("BÚSQUEDA FINALIZADA: El título \"%s\" no fue encontrado.\n", titulo_buscado);
+    }
+    printf("Páginas del índice leídas: %ld (altura %u)\n", indice.paginas_leidas, indice.cab.altura);
+    printf("----------------------------------------\n");
+
+    indice_titulos_cerrar(&indice);
+    libros_cerrar(&archivo);
 }
 
 /**
  * @brief Programa principal para ejecutar la búsqueda de un libro por título.
  *
  * Solicita al usuario un título de libro por consola, elimina el salto de línea
- * generado por fgets() y llama a la función busqueda_lineal_archivo() para
- * realizar la búsqueda en el archivo binario.
+ * generado por fgets() y llama a la función de búsqueda elegida.
+ *
+ * Por defecto la búsqueda usa el índice de títulos (`libros_biblioteca.idx`).
+ *
+ * Opciones de línea de órdenes:
+ *  - `--lineal`: fuerza el recorrido secuencial clásico con fread (para comparar).
+ *  - `--mmap`: recorre el archivo proyectado en memoria en lugar de usar fread.
+ *  - `--archivo=RUTA`: archivo a consultar en cualquier modo; su índice es
+ *    `RUTA` con `.bin` cambiado por `.idx`. "-" lee de una tubería (solo por
+ *    recorrido: la búsqueda pasa a `--mmap`).
+ *  - `TITULO`: título a buscar; si se omite se pregunta por consola.
  *
  * @return int Devuelve 0 si la ejecución fue correcta, o 1 si hubo error de lectura.
  */
-int main(void) {
+int main(int argc, char *argv[]) {
 
     char titulo[CAD_TITULO]; // Buffer para almacenar el título introducido por el usuario
+    const char *archivo = NOMBRE_ARCHIVO;
+    const char *titulo_arg = NULL;
+    int modo_mmap = 0;
+    int modo_lineal = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lineal") == 0) {
+            modo_lineal = 1;
+        } else if (strcmp(argv[i], "--mmap") == 0) {
+            modo_mmap = 1;
+        } else if (strncmp(argv[i], "--archivo=", 10) == 0) {
+            archivo = argv[i] + 10;
+        } else {
+            titulo_arg = argv[i];
+        }
+    }
 
     printf("=======================================\n");
     printf("   BÚSQUEDA DE LIBRO EN ARCHIVO BINARIO\n");
     printf("=======================================\n");
 
-    printf("Introduzca el TÍTULO a buscar (máx. %d caracteres): \n", CAD_TITULO - 1);
-    
-    // Lectura segura del título desde stdin
-    if (fgets(titulo, CAD_TITULO, stdin) == NULL) {
-        printf("Error de lectura.\n");
-        return 1;
+    if (titulo_arg) {
+        snprintf(titulo, sizeof(titulo), "%s", titulo_arg);
+    } else {
+        if (strcmp(archivo, "-") == 0) {
+            printf("Con --archivo=- el título debe indicarse como argumento.\n");
+            return 1;
+        }
+
+        printf("Introduzca el TÍTULO a buscar (máx. %d caracteres): \n", CAD_TITULO - 1);
+        
+        // Lectura segura del título desde stdin
+        if (fgets(titulo, CAD_TITULO, stdin) == NULL) {
+            printf("Error de lectura.\n");
+            return 1;
+        }
+        
+        // Eliminar el salto de línea '\n' que fgets deja al final
+        titulo[strcspn(titulo, "\n")] = 0; 
     }
     
-    // Eliminar el salto de línea '\n' que fgets deja al final
-    titulo[strcspn(titulo, "\n")] = 0; 
-    
     // Llamada a la función de búsqueda
-    busqueda_lineal_archivo(titulo);
+    if (modo_mmap || strcmp(archivo, "-") == 0) {
+        busqueda_lineal_mapeada(archivo, titulo);
+    } else if (modo_lineal) {
+        busqueda_lineal_archivo(archivo, titulo);
+    } else {
+        busqueda_indexada(archivo, titulo);
+    }
 
     return 0;
 }
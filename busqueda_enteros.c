@@ -4,9 +4,12 @@
  *
  * Se compara un valor X con el elemento central del intervalo. 
  * En cada iteración se reduce a la mitad el intervalo, midiendo comparaciones.
+ * Los resultados se comparan con la búsqueda sin saltos y la disposición de
+ * Eytzinger de busqueda_eytzinger.h, individual y por lotes.
  */
 
 #include <stdio.h>
+#include "busqueda_eytzinger.h"
 
 #define TAM 10
 
@@ -81,6 +84,35 @@ int main() {
         printf("%4d\t%4d\t%6d\n", valores[i], idx, comps);
     }
 
+    // Mismas búsquedas sin saltos y con el vector en disposición de Eytzinger
+    Eytzinger_int E;
+    if (!eytzinger_int_construir(&E, V, TAM)) {
+        printf("Error al reservar memoria para la disposición de Eytzinger\n");
+        return 1;
+    }
+
+    int comps_sin_saltos, comps_eytz;
+    printf("\nRESULTADOS BÚSQUEDA SIN SALTOS / EYTZINGER\n");
+    printf("Valor\tÍndice\tComps. sin saltos\tComps. Eytzinger\n");
+    printf("-----------------------------------------------------------\n");
+
+    for (int i = 0; i < 6; i++) {
+        idx = busqueda_sin_saltos_int(V, TAM, valores[i], &comps_sin_saltos);
+        if (eytzinger_int_buscar(&E, valores[i], &comps_eytz) != idx)
+            printf("Aviso: las búsquedas no coinciden para %d\n", valores[i]);
+        printf("%4d\t%4d\t%10d\t\t%10d\n", valores[i], idx, comps_sin_saltos, comps_eytz);
+    }
+
+    // Todas las consultas de una vez, intercaladas
+    int resultados[6];
+    long comps_lote;
+    eytzinger_int_buscar_lote(&E, valores, 6, resultados, &comps_lote);
+    printf("\nLote de 6 consultas: %ld comparaciones en total\n", comps_lote);
+    for (int i = 0; i < 6; i++) {
+        printf("%4d -> %4d\n", valores[i], resultados[i]);
+    }
+
+    eytzinger_int_liberar(&E);
     return 0;
 }
 
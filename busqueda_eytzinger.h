@@ -0,0 +1,201 @@
+#ifndef BUSQUEDA_EYTZINGER_H
+#define BUSQUEDA_EYTZINGER_H
+
+#include <stdlib.h>
+
+/**
+ * @file busqueda_eytzinger.h
+ * @brief Búsqueda binaria sin saltos y en disposición de Eytzinger, con consultas por lotes.
+ *
+ * La búsqueda binaria clásica tiene dos problemas con vectores grandes: el
+ * procesador no puede predecir hacia qué lado se va (un fallo de predicción
+ * por nivel) y cada nivel toca una línea de caché distinta y alejada.
+ *
+ *  - Búsqueda sin saltos (`busqueda_sin_saltos_T`): trabaja sobre el vector
+ *    ordenado tal cual; en cada nivel el avance se calcula con una
+ *    comparación convertida en aritmética, sin bifurcaciones.
+ *  - Disposición de Eytzinger (`Eytzinger_T`): el vector ordenado se copia
+ *    en el orden de un recorrido en anchura de un árbol binario completo
+ *    (raíz en la posición 1, hijos de k en 2k y 2k+1). Los primeros niveles
+ *    de todas las búsquedas comparten las mismas líneas de caché, y los 16
+ *    descendientes de un nodo a cuatro niveles de distancia son contiguos,
+ *    así que se pueden pedir por adelantado (prefetch) mientras se compara:
+ *    son una línea de caché con claves `int` y dos con `double`.
+ *  - Lotes (`eytzinger_T_buscar_lote`): se avanzan varias búsquedas a la vez,
+ *    un nivel cada una por turno, para que los fallos de caché de todas se
+ *    solapen en lugar de esperarse uno tras otro.
+ *
+ * Todas las funciones cuentan las comparaciones con la clave en @p comps
+ * (una por nivel más la comprobación final de igualdad), igual que las
+ * búsquedas binarias clásicas del resto de programas.
+ *
+ * El módulo se genera para cada tipo de clave con @ref EYTZINGER_DEFINIR; ya
+ * vienen instanciados `int` y `double`.
+ */
+
+/** @brief Búsquedas que se avanzan a la vez en las consultas por lotes. */
+#define EYTZ_LOTE 8
+
+/** @brief Alineación de las claves (una línea de caché). */
+#define EYTZ_LINEA 64
+
+/** @brief Descendientes de un nodo a cuatro niveles de distancia (2^4), los que se piden por adelantado. */
+#define EYTZ_DESCENDIENTES 16
+
+#if defined(__GNUC__)
+#define EYTZ_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define EYTZ_PREFETCH(p) ((void)0)
+#endif
+
+/**
+ * @brief Deshace los últimos giros a la derecha de un recorrido de Eytzinger.
+ *
+ * La búsqueda termina en un k fuera del árbol. El resultado (el primer
+ * elemento >= clave) es el último nodo en el que se giró a la izquierda:
+ * se quitan los unos finales de k y un cero más.
+ *
+ * @return Posición en el árbol (1..n), o 0 si todas las claves son menores.
+ */
+static inline int eytzinger_deshacer(unsigned k) {
+    unsigned unos = 0;
+    while (k & (1u << unos)) unos++;
+    return (int)(k >> (unos + 1));
+}
+
+/**
+ * @brief Genera la disposición de Eytzinger y las búsquedas para el tipo @p Tipo.
+ *
+ * Define:
+ *  - `Eytzinger_S`: claves en disposición de Eytzinger y su posición en el
+ *    vector ordenado original.
+ *  - `eytzinger_S_construir(E, v, n)`: 1 si se construye, 0 sin memoria.
+ *  - `eytzinger_S_buscar(E, x, comps)`: posición de x en el vector original
+ *    (la primera si hay repetidos) o -1.
+ *  - `eytzinger_S_buscar_lote(E, xs, m, res, comps)`: resuelve m claves; deja
+ *    las posiciones en res y suma las comparaciones de todas en comps.
+ *  - `eytzinger_S_liberar(E)`.
+ *  - `busqueda_sin_saltos_S(v, n, x, comps)`: búsqueda sin saltos sobre el
+ *    vector ordenado; posición de x (la primera) o -1.
+ *
+ * @param S Sufijo de los nombres generados.
+ * @param Tipo Tipo de las claves (con < y ==).
+ */
+#define EYTZINGER_DEFINIR(S, Tipo)                                                          \
+                                                                                            \
+typedef struct {                                                                            \
+    Tipo *claves;      /* Claves en orden de Eytzinger (índices 1..n). */                   \
+    int *posicion;     /* Posición de cada clave en el vector ordenado. */                  \
+    int n;             /* Número de claves. */                                              \
+} Eytzinger_##S;                                                                            \
+                                                                                            \
+static inline int eytzinger_##S##_construir(Eytzinger_##S *e, const Tipo *v, int n) {      \
+    size_t bytes = sizeof(Tipo) * (size_t)(n + 1);                                          \
+    bytes = (bytes + EYTZ_LINEA - 1) / EYTZ_LINEA * EYTZ_LINEA;                             \
+    e->n = n;                                                                               \
+    e->claves = aligned_alloc(EYTZ_LINEA, bytes);                                           \
+    e->posicion = malloc(sizeof(int) * (size_t)(n + 1));                                    \
+    if (!e->claves || !e->posicion) {                                                       \
+        free(e->claves); free(e->posicion);                                                 \
+        e->claves = NULL; e->posicion = NULL;                                               \
+        return 0;                                                                           \
+    }                                                                                       \
+    /* Recorrido en orden del árbol: el i-ésimo nodo visitado recibe v[i] */                \
+    unsigned k = 1;                                                                         \
+    while (n > 0 && 2 * k <= (unsigned)n) k *= 2;                                           \
+    for (int i = 0; i < n; i++) {                                                           \
+        e->claves[k] = v[i];                                                                \
+        e->posicion[k] = i;                                                                 \
+        if (2 * k + 1 <= (unsigned)n) {                                                     \
+            k = 2 * k + 1;                                                                  \
+            while (2 * k <= (unsigned)n) k *= 2;                                            \
+        } else {                                                                            \
+            while (k & 1) k >>= 1;                                                          \
+            k >>= 1;                                                                        \
+        }                                                                                   \
+    }                                                                                       \
+    return 1;                                                                               \
+}                                                                                           \
+                                                                                            \
+/* Pide las líneas de caché de los EYTZ_DESCENDIENTES descendientes de k */                 \
+static inline void eytzinger_##S##_prefetch(const Tipo *c, unsigned k) {                   \
+    const char *p = (const char *)(c + (size_t)k * EYTZ_DESCENDIENTES);                     \
+    for (size_t b = 0; b < EYTZ_DESCENDIENTES * sizeof(Tipo); b += EYTZ_LINEA)              \
+        EYTZ_PREFETCH(p + b);                                                               \
+}                                                                                           \
+                                                                                            \
+static inline void eytzinger_##S##_liberar(Eytzinger_##S *e) {                             \
+    free(e->claves); free(e->posicion);                                                     \
+    e->claves = NULL; e->posicion = NULL; e->n = 0;                                         \
+}                                                                                           \
+                                                                                            \
+static inline int eytzinger_##S##_buscar(const Eytzinger_##S *e, Tipo x, int *comps) {     \
+    const Tipo *c = e->claves;                                                              \
+    unsigned k = 1, n = (unsigned)e->n;                                                     \
+    *comps = 0;                                                                             \
+    while (k <= n) {                                                                        \
+        eytzinger_##S##_prefetch(c, k);                                                     \
+        k = 2 * k + (c[k] < x);                                                             \
+        (*comps)++;                                                                         \
+    }                                                                                       \
+    int r = eytzinger_deshacer(k);                                                          \
+    if (r == 0) return -1;                                                                  \
+    (*comps)++;                                                                             \
+    return c[r] == x ? e->posicion[r] : -1;                                                 \
+}                                                                                           \
+                                                                                            \
+static inline void eytzinger_##S##_buscar_lote(const Eytzinger_##S *e, const Tipo *xs,    \
+                                               int m, int *res, long *comps) {             \
+    const Tipo *c = e->claves;                                                              \
+    unsigned n = (unsigned)e->n;                                                            \
+    *comps = 0;                                                                             \
+    for (int b = 0; b < m; b += EYTZ_LOTE) {                                                \
+        int g = m - b < EYTZ_LOTE ? m - b : EYTZ_LOTE;                                      \
+        unsigned k[EYTZ_LOTE];                                                              \
+        int activas = n > 0 ? g : 0;                                                        \
+        for (int j = 0; j < g; j++) k[j] = 1;                                               \
+        /* Un nivel de cada búsqueda por turno: los accesos se solapan */                   \
+        while (activas > 0) {                                                               \
+            activas = 0;                                                                    \
+            for (int j = 0; j < g; j++) {                                                   \
+                if (k[j] > n) continue;                                                     \
+                eytzinger_##S##_prefetch(c, k[j]);                                          \
+                k[j] = 2 * k[j] + (c[k[j]] < xs[b + j]);                                    \
+                (*comps)++;                                                                 \
+                activas += k[j] <= n;                                                       \
+            }                                                                               \
+        }                                                                                   \
+        for (int j = 0; j < g; j++) {                                                       \
+            int r = eytzinger_deshacer(k[j]);                                               \
+            if (r != 0) (*comps)++;                                                         \
+            res[b + j] = r != 0 && c[r] == xs[b + j] ? e->posicion[r] : -1;                 \
+        }                                                                                   \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+static inline int busqueda_sin_saltos_##S(const Tipo *v, int n, Tipo x, int *comps) {      \
+    const Tipo *base = v;                                                                   \
+    int resto = n;                                                                          \
+    *comps = 0;                                                                             \
+    if (n <= 0) return -1;                                                                  \
+    /* Invariante: el primer elemento >= x está en [base, base + resto] */                  \
+    while (resto > 1) {                                                                     \
+        int mitad = resto / 2;                                                              \
+        EYTZ_PREFETCH(base + mitad / 2);                                                    \
+        EYTZ_PREFETCH(base + mitad + mitad / 2);                                            \
+        base = (base[mitad] < x) ? base + mitad : base;                                     \
+        resto -= mitad;                                                                     \
+        (*comps)++;                                                                         \
+    }                                                                                       \
+    base += (*base < x);                                                                    \
+    (*comps)++;                                                                             \
+    int pos = (int)(base - v);                                                              \
+    if (pos == n) return -1;                                                                \
+    (*comps)++;                                                                             \
+    return *base == x ? pos : -1;                                                           \
+}
+
+EYTZINGER_DEFINIR(int, int)
+EYTZINGER_DEFINIR(double, double)
+
+#endif // BUSQUEDA_EYTZINGER_H
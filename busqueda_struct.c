@@ -1,10 +1,15 @@
 /**
  * @file busqueda_struct.c
  * @brief Búsqueda binaria sobre un vector de structs "Alumno" ordenado por id.
+ *
+ * También se buscan los ids con la disposición de Eytzinger de
+ * busqueda_eytzinger.h, que guarda solo las claves y devuelve la posición
+ * del alumno en el vector original.
  */
 
 #include <stdio.h>
 #include <string.h>
+#include "busqueda_eytzinger.h"
 
 /**
  * @struct Alumno
@@ -82,6 +87,30 @@ int main() {
         printf("%2d\t%4d\t%6d\n", ids[i], idx, comps);
     }
 
+    // Índice de ids en disposición de Eytzinger y consultas por lotes
+    int claves[10];
+    for (int i = 0; i < 10; i++) claves[i] = lista[i].id;
+
+    Eytzinger_int E;
+    if (!eytzinger_int_construir(&E, claves, 10)) {
+        printf("Error al reservar memoria para el índice de ids\n");
+        return 1;
+    }
+
+    int resultados[6];
+    long comps_lote;
+    eytzinger_int_buscar_lote(&E, ids, 6, resultados, &comps_lote);
+
+    printf("\nRESULTADOS EYTZINGER POR LOTES (ALUMNOS)\n");
+    printf("ID\tÍndice\tNombre\n");
+    printf("-----------------------------------\n");
+    for (int i = 0; i < 6; i++) {
+        printf("%2d\t%4d\t%s\n", ids[i], resultados[i],
+               resultados[i] >= 0 ? lista[resultados[i]].nombre : "-");
+    }
+    printf("Comparaciones del lote: %ld\n", comps_lote);
+
+    eytzinger_int_liberar(&E);
     return 0;
 }
 
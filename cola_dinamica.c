@@ -11,6 +11,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "arena.h"
+
+/** @brief Nodos del primer bloque de la arena de cada cola. */
+#define COLA_NODOS_BLOQUE 64
 
 // ==========================================================
 // ========== DEFINICIÓN DE ESTRUCTURAS DE DATOS =========
@@ -45,10 +49,13 @@ typedef struct nodo {
  * @brief Representa una cola dinámica de procesos.
  *
  * Utiliza punteros al inicio (frente) y al final (último elemento).
+ * Los nodos salen de una arena propia de la cola (arena.h), que los
+ * reutiliza al desencolar y los libera todos de golpe al vaciarla.
  */
 typedef struct {
     NODO *inicio; /**< Primer nodo de la cola */
     NODO *fin;    /**< Último nodo de la cola */
+    Arena nodos;  /**< Arena de la que salen los nodos */
 } COLA;
 
 // ==========================================================
@@ -193,6 +200,7 @@ int main() {
 void crearCola(COLA *c) {
     c->inicio = NULL;
     c->fin = NULL;
+    arena_iniciar(&c->nodos, sizeof(NODO), COLA_NODOS_BLOQUE);
 }
 
 int colaVacia(COLA c) {
@@ -200,7 +208,11 @@ int colaVacia(COLA c) {
 }
 
 void encolar(COLA *c, PROCESO nuevo) {
-    NODO *nuevoNodo = (NODO *)malloc(sizeof(NODO));
+    NODO *nuevoNodo = (NODO *)arena_reservar(&c->nodos);
+    if (nuevoNodo == NULL) {
+        fprintf(stderr, "ERROR: Sin memoria para encolar.\n");
+        return;
+    }
     nuevoNodo->dato = nuevo;
     nuevoNodo->sig = NULL;
 
@@ -227,7 +239,7 @@ void desencolar(COLA *c, PROCESO *atendido) {
         c->fin = NULL;
     }
 
-    free(aux);
+    arena_liberar(&c->nodos, aux);
 }
 
 PROCESO primero(COLA c) {
@@ -255,11 +267,8 @@ void mostrarCola(COLA c) {
 }
 
 void liberarCola(COLA *c) {
-    while (c->inicio != NULL) {
-        NODO *aux = c->inicio;
-        c->inicio = c->inicio->sig;
-        free(aux);
-    }
+    arena_destruir(&c->nodos); // Todos los nodos a la vez, sin recorrer la cola
+    c->inicio = NULL;
     c->fin = NULL;
 }
 
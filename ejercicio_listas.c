@@ -14,6 +14,10 @@
 #include <stdlib.h> 
 #include <string.h> 
 #include <assert.h> 
+#include "arena.h"
+
+/** @brief Nodos del primer bloque de la arena de pacientes. */
+#define PACIENTES_NODOS_BLOQUE 64
 
 
 /*======================================================
@@ -51,6 +55,14 @@ typedef struct nodo {
 	struct nodo *sig;      /**< Puntero al siguiente nodo. */
 } NODO; 
 
+/**
+ * @brief Arena de la que salen los nodos de todas las listas (arena.h).
+ *
+ * Los nodos eliminados se reutilizan en las siguientes inserciones y la
+ * memoria de todos se devuelve de una vez al terminar el programa.
+ */
+static Arena arena_pacientes = ARENA_INICIAL(sizeof(NODO), PACIENTES_NODOS_BLOQUE);
+
 
 /*======================================================
  *                 PROTOTIPOS DE FUNCIONES
@@ -89,6 +101,7 @@ int main(void) {
 	if (c == 's' || c == 'S') 
 		menu_urgencias(); 
 	
+	arena_destruir(&arena_pacientes); 
 	return 0; 
 } 
 
@@ -121,7 +134,7 @@ int listaVacia(NODO *ultimo) {
  * @return Nuevo puntero al último nodo.
  */
 NODO* insertarPaciente(NODO *ultimo, PACIENTE nuevo) {
-    NODO *nuevoNodo = (NODO*) malloc(sizeof(NODO));
+    NODO *nuevoNodo = (NODO*) arena_reservar(&arena_pacientes);
     assert(nuevoNodo != NULL);
 
     nuevoNodo->info = nuevo;
@@ -179,7 +192,7 @@ NODO* eliminarPorNombre(NODO *ultimo, char nombre[]) {
         if (strcmp(actual->info.nombre, nombre) == 0) {
             if (actual == prev) { 
                 // Solo un nodo en la lista
-                free(actual);
+                arena_liberar(&arena_pacientes, actual);
                 return NULL;
             } else {
                 prev->sig = actual->sig;
@@ -187,7 +200,7 @@ NODO* eliminarPorNombre(NODO *ultimo, char nombre[]) {
                     // Si eliminamos el último, actualizamos puntero
                     ultimo = prev;
                 }
-                free(actual);
+                arena_liberar(&arena_pacientes, actual);
                 return ultimo;
             }
         }
@@ -212,7 +225,7 @@ NODO* eliminarPorPosicion(NODO *ultimo, int pos) {
     
     if (pos == 0) {  
         NODO *next = temp->sig;
-        free(temp);
+        arena_liberar(&arena_pacientes, temp);
         return next;
     }
     
@@ -225,7 +238,7 @@ NODO* eliminarPorPosicion(NODO *ultimo, int pos) {
     if (temp == NULL) return ultimo;
     
     anterior->sig = temp->sig;
-    free(temp);
+    arena_liberar(&arena_pacientes, temp);
     return ultimo;
 }
 
@@ -256,7 +269,11 @@ void atenderPaciente(NODO *actual) {
 }
 
 /**
- * @brief Libera la memoria de todos los nodos de la lista.
+ * @brief Devuelve a la arena todos los nodos de la lista.
+ *
+ * La arena es común a todas las listas, así que los nodos se devuelven uno
+ * a uno para reutilizarlos; la memoria se libera con arena_destruir.
+ *
  * @param ultimo Doble puntero al último nodo.
  */
 void liberarLista(NODO **ultimo) {
@@ -265,7 +282,7 @@ void liberarLista(NODO **ultimo) {
     NODO *temp = start;
     do {
         NODO *next = temp->sig;
-        free(temp);
+        arena_liberar(&arena_pacientes, temp);
         temp = next;
     } while (temp != start);
     *ultimo = NULL;
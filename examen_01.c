@@ -1,12 +1,19 @@
 /**
  * @file examen_ejercicio_01.c
  * @brief Programa para la gestión de trenes 
+ *
+ * Los listados por distancia usan un índice secundario ordenado por distancia
+ * (indice_distancias.h) que se mantiene al registrar y al eliminar trenes.
  */
 
 // --- Librerías estándar necesarias para el programa ---
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include "arena.h"
+#include "indice_distancias.h"
+#include "monticulo_dario.h"
 
 // --- Constantes ---
 /** @brief Capacidad inicial del array de salidas del Min-Heap. */
@@ -17,6 +24,8 @@
 #define MAX_STR_LEN 50
 /** @brief Factor de crecimiento para la redimensión dinámica del Heap. */
 #define REDIMENSION_FACTOR 2
+/** @brief Trenes del primer bloque de la arena de nodos. */
+#define ARENA_TRENES_BLOQUE 256
 
 // --- Definiciones de estructuras de datos --- 
 
@@ -43,15 +52,13 @@ typedef struct salida {
     int clave_salida;        
 } Salida;
 
+MONTICULO_DEFINIR(salidas, int, Tren*, HEAP_ARIDAD, MONTICULO_SIN_POSICION)
+
 /**
- * @struct heap
- * @brief Estructura que implementa un Min-Heap (Montículo de Mínimos) dinámico.
+ * @brief Min-Heap (Montículo de Mínimos) dinámico de salidas, HEAP_ARIDAD-ario (monticulo_dario.h).
+ * `claves[i]` es la clave de la salida i y `datos[i]` su tren; -DHEAP_ARIDAD=2 da el montículo binario.
  */
-typedef struct heap {
-    Salida* elementos;       /// Array dinámico de elementos Salida (almacén del montículo).
-    int capacidad;           /// Capacidad máxima actual del array.
-    int tamano;              /// Número actual de elementos en el Heap.
-} Heap;
+typedef Monticulo_salidas Heap;
 
 // --- Prototipos de funciones ---
 // Funciones del ABB
@@ -65,13 +72,20 @@ void liberar_arbol(Tren* raiz);
 /** @brief Comprueba si el tren está pendiente de salida en el Heap. */
 int tren_en_heap(Heap* heap, const char* id_tren);
 void listar_tren_por_carga_o_distancia_minima(Tren* raiz, const char* filtro, int tipo_filtro);
+/** @brief Lista con el índice de distancias los trenes con distancia en [min, max] y los cuenta. */
+void listar_tren_por_distancia(int distancia_min, int distancia_max);
 
 // Funciones del Min-Heap
 void insertar_heap(Heap* heap, Salida nueva_salida);
 Salida extraer_min_heap(Heap* heap);
-void min_heapify(Heap* heap, int i);
 void heapsort_y_mostrar(Heap* heap);
 
+/** @brief Arena de la que salen todos los nodos Tren del árbol (arena.h). */
+Arena arena_trenes = ARENA_INICIAL(sizeof(Tren), ARENA_TRENES_BLOQUE);
+
+/** @brief Índice de los trenes del ABB por distancia; lo mantienen insertar_tren y eliminar_tren. */
+IndiceDistancias indice_distancias;
+
 /**
  * @brief Función principal que implementa el menú interactivo del sistema de gestión aeroportuaria.
  * @return 0 si la ejecución es exitosa, 1 en caso de error de asignación de memoria inicial.
@@ -80,11 +94,12 @@ int main() {
     Tren* arbol_tren = NULL;  /// Puntero a la raíz del Árbol de Vuelos.
 
     /// Inicialización del Heap dinámico.
-    Heap monticulo_salidas = {.elementos = (Salida*)malloc(sizeof(Salida) * MAX_NODOS), .capacidad = MAX_NODOS, .tamano = 0};
-    if (monticulo_salidas.elementos == NULL) {
+    Heap monticulo_salidas;
+    if (!monticulo_salidas_crear(&monticulo_salidas, MAX_NODOS)) {
         printf("Error fatal: No se pudo asignar memoria para el montículo.\n");
         return 1;
     }
+    indice_distancias_crear(&indice_distancias);
     
     int opcion;
     do {
@@ -96,7 +111,7 @@ int main() {
         printf("2. Buscar tren por ID\n");
         printf("3. Eliminar tren\n");
         printf("4. Listar todos los trenes (código: inorden)\n");
-        printf("5. Listar trenes por carga o distancia minima\n");
+        printf("5. Listar trenes por carga o distancia (mínima o rango)\n");
         printf("6. Salir\n");
         printf("Elige una opción: ");
         
@@ -117,7 +132,7 @@ int main() {
         
         switch(opcion) {
             case 1: // Registrar nuevo vuelo
-                tren = (Tren*)malloc(sizeof(Tren));
+                tren = (Tren*)arena_reservar(&arena_trenes);
                 if (tren == NULL) { printf("Error: Fallo de asignación de memoria.\n"); break; }
                 printf("Ingrese ID del tren: "); scanf("%s", tren->id_tren);
                 printf("Ingrese ciudad de origen: "); scanf("%s", tren->origen);
@@ -156,8 +171,8 @@ int main() {
                 break;
 
             case 5: // Listar por filtro
-                printf("Filtrar por:\n1. Tipo de carga\n2. Distancia mínima\nElige una opción: ");
-                int tipo_filtro;   
+                printf("Filtrar por:\n1. Tipo de carga\n2. Distancia mínima\n3. Rango de distancias\nElige una opción: ");
+                int tipo_filtro, distancia_min, distancia_max;   
                 char filtro[MAX_STR_LEN]; 
                 scanf("%d", &tipo_filtro);
                 if (tipo_filtro == 1) {
@@ -167,17 +182,23 @@ int main() {
                     listar_tren_por_carga_o_distancia_minima(arbol_tren, filtro, tipo_filtro);
                 } else if (tipo_filtro == 2) {
                     printf("Ingrese distancia mínima (km): ");
-                    scanf("%s", filtro);
+                    scanf("%d", &distancia_min);
                     printf(" --- Trenes con distancia mínima especificada ---\n");
-                    listar_tren_por_carga_o_distancia_minima(arbol_tren, filtro, tipo_filtro);
+                    listar_tren_por_distancia(distancia_min, INT_MAX);
+                } else if (tipo_filtro == 3) {
+                    printf("Ingrese distancia mínima (km): "); scanf("%d", &distancia_min);
+                    printf("Ingrese distancia máxima (km): "); scanf("%d", &distancia_max);
+                    printf(" --- Trenes con distancia entre %d y %d km ---\n", distancia_min, distancia_max);
+                    listar_tren_por_distancia(distancia_min, distancia_max);
                 } else {
                     printf("Opción inválida.\n");
-                    break;
                 }
+                break;
 
             case 6: // Salir
-                liberar_arbol(arbol_tren); 
-                free(monticulo_salidas.elementos); 
+                arena_destruir(&arena_trenes); // Todos los trenes de golpe, sin recorrer el árbol
+                monticulo_salidas_liberar(&monticulo_salidas);
+                indice_distancias_liberar(&indice_distancias);
                 printf("Saliendo del programa y liberando memoria...\n");
                 break;
 
@@ -200,6 +221,12 @@ int main() {
  */
 Tren* insertar_tren(Tren* raiz, Tren* nuevo_tren) {
     if (raiz == NULL) {
+        /// El tren solo se enlaza si también entra en el índice de distancias.
+        if (!indice_distancias_insertar(&indice_distancias, nuevo_tren->distancia, nuevo_tren)) {
+            printf("Error: Fallo de asignación de memoria para el índice de distancias.\n");
+            arena_liberar(&arena_trenes, nuevo_tren);
+            return NULL;
+        }
         return nuevo_tren;
     }
     int cmp = strcmp(nuevo_tren->destino, raiz->destino);
@@ -213,7 +240,7 @@ Tren* insertar_tren(Tren* raiz, Tren* nuevo_tren) {
     } else {
         /// Clave duplicada: no se inserta.
         printf("Error: El tren ya existe (%s). No insertado.\n", nuevo_tren->destino);
-        free(nuevo_tren); 
+        arena_liberar(&arena_trenes, nuevo_tren); 
     }
     return raiz;
 }
@@ -238,14 +265,17 @@ Tren* buscar_tren(Tren* raiz, const char* id_tren) {
 }
 
 /**
- * @brief Libera recursivamente toda la memoria asignada al ABB (Postorden).
+ * @brief Devuelve recursivamente a la arena todos los nodos de un subárbol (Postorden).
+ *
+ * Para liberar el árbol completo basta con arena_destruir(&arena_trenes).
+ *
  * @param raiz La raíz del ABB.
  */
 void liberar_arbol(Tren* raiz) {
     if (raiz == NULL) return;
     liberar_arbol(raiz->izquierdo);
     liberar_arbol(raiz->derecho);
-    free(raiz);
+    arena_liberar(&arena_trenes, raiz);
 }
 
 Tren* eliminar_tren(Tren* raiz, const char* id_tren, Heap* heap_salidas) {
@@ -265,30 +295,31 @@ Tren* eliminar_tren(Tren* raiz, const char* id_tren, Heap* heap_salidas) {
             printf("Error: No se puede eliminar el tren %s porque está pendiente de salida.\n", id_tren);
             return raiz;
         }
+        indice_distancias_quitar(&indice_distancias, raiz->distancia, raiz);
         
         // Nodo con un solo hijo o sin hijos
         if (raiz->izquierdo == NULL) {
             Tren* temp = raiz->derecho;
-            free(raiz);
+            arena_liberar(&arena_trenes, raiz);
             return temp;
         } else if (raiz->derecho == NULL) {
             Tren* temp = raiz->izquierdo;
-            free(raiz);
+            arena_liberar(&arena_trenes, raiz);
             return temp;
         }
         
-        // Nodo con dos hijos: obtener el sucesor inorder
-        Tren* temp = encontrar_min(raiz->derecho);
-        strcpy(raiz->id_tren, temp->id_tren);
-        strcpy(raiz->compania, temp->compania);
-        strcpy(raiz->origen, temp->origen);
-        strcpy(raiz->destino, temp->destino);
-        strcpy(raiz->carga_tipo, temp->carga_tipo);
-        raiz->distancia = temp->distancia;
-        raiz->fecha_operacion = temp->fecha_operacion;
-        raiz->hora_operacion = temp->hora_operacion;
-        
-        raiz->derecho = eliminar_tren(raiz->derecho, temp->id_tren, heap_salidas);
+        // Nodo con dos hijos: el sucesor inorden se desengancha y ocupa su lugar.
+        // No se copian sus datos: el índice de distancias apunta a cada tren por su dirección.
+        Tren** enlace = &raiz->derecho;
+        while ((*enlace)->izquierdo != NULL) {
+            enlace = &(*enlace)->izquierdo;
+        }
+        Tren* temp = *enlace;
+        *enlace = temp->derecho;
+        temp->izquierdo = raiz->izquierdo;
+        temp->derecho = raiz->derecho;
+        arena_liberar(&arena_trenes, raiz);
+        return temp;
     }
     return raiz;
 }
@@ -306,6 +337,15 @@ void recorrer_inorden(Tren* raiz) {
     recorrer_inorden(raiz->derecho);
 }
 
+/**
+ * @brief Recorre el ABB en orden y muestra los trenes con el tipo de carga dado.
+ *
+ * Con tipo_filtro 2 no recorre el árbol: los filtros por distancia van por listar_tren_por_distancia.
+ *
+ * @param raiz La raíz del ABB.
+ * @param filtro Tipo de carga buscado.
+ * @param tipo_filtro 1 para tipo de carga.
+ */
 void listar_tren_por_carga_o_distancia_minima(Tren* raiz, const char* filtro, int tipo_filtro) {
     if (raiz == NULL) return;
 
@@ -316,18 +356,36 @@ void listar_tren_por_carga_o_distancia_minima(Tren* raiz, const char* filtro, in
                raiz->id_tren, raiz->origen, raiz->destino, raiz->compania,
                raiz->distancia, raiz->fecha_operacion, raiz->hora_operacion,
                raiz->carga_tipo);
-    } else if (tipo_filtro == 2 && raiz->distancia >= atoi(filtro)) {
-        printf("ID: %s, Origen: %s, Destino: %s, Compañia: %s, Distancia: %d km, Fecha: %d, Hora: %d, Tipo de carga: %s\n",
-               raiz->id_tren, raiz->origen, raiz->destino, raiz->compania,
-               raiz->distancia, raiz->fecha_operacion, raiz->hora_operacion,
-               raiz->carga_tipo);
     }
 
     listar_tren_por_carga_o_distancia_minima(raiz->derecho, filtro, tipo_filtro);
 }
+
+/**
+ * @brief Muestra en orden de distancia los trenes con distancia en [@p distancia_min, @p distancia_max].
+ *
+ * El índice baja en O(log n) hasta el primer tren del rango y después avanza uno por tren
+ * listado, sin mirar los demás; el total se cuenta con los tamaños de subárbol en O(log n).
+ *
+ * @param distancia_min Distancia mínima en km (incluida).
+ * @param distancia_max Distancia máxima en km (incluida); INT_MAX para no poner tope.
+ */
+void listar_tren_por_distancia(int distancia_min, int distancia_max) {
+    RecorridoDistancias recorrido;
+    indice_distancias_recorrido_iniciar(&recorrido, &indice_distancias, distancia_min, distancia_max);
+
+    Tren* tren;
+    while ((tren = (Tren*)indice_distancias_recorrido_siguiente(&recorrido, NULL)) != NULL) {
+        printf("ID: %s, Origen: %s, Destino: %s, Compañia: %s, Distancia: %d km, Fecha: %d, Hora: %d, Tipo de carga: %s\n",
+               tren->id_tren, tren->origen, tren->destino, tren->compania,
+               tren->distancia, tren->fecha_operacion, tren->hora_operacion,
+               tren->carga_tipo);
+    }
+    printf("Total: %d trenes.\n", indice_distancias_contar(&indice_distancias, distancia_min, distancia_max));
+}
 int tren_en_heap(Heap* heap, const char* id_tren) {
     for (int i = 0; i < heap->tamano; i++) {
-        if (strcmp(heap->elementos[i].tren->id_tren, id_tren) == 0) {
+        if (strcmp(heap->datos[i]->id_tren, id_tren) == 0) {
             return 1; // Encontrado
         }
     }
@@ -352,14 +410,10 @@ Tren* encontrar_min(Tren* raiz) {
 void redimensionar_heap(Heap* heap) {
     if (heap->tamano < heap->capacidad) return;
 
-    heap->capacidad *= REDIMENSION_FACTOR;
-    Salida* nuevo_elementos = (Salida*)realloc(heap->elementos, sizeof(Salida) * heap->capacidad);
-
-    if (nuevo_elementos == NULL) {
+    if (!monticulo_salidas_reservar(heap, heap->capacidad * REDIMENSION_FACTOR)) {
         fprintf(stderr, "Error crítico: Fallo de reasignación de memoria para el Heap.\n");
         exit(1);
     }
-    heap->elementos = nuevo_elementos;
     printf("(Heap redimensionado a capacidad %d)\n", heap->capacidad);
 }
 
@@ -370,18 +424,9 @@ void redimensionar_heap(Heap* heap) {
  */
 void insertar_heap(Heap* heap, Salida nueva_salida) {
     redimensionar_heap(heap); 
-    
-    heap->tamano++;
-    int i = heap->tamano - 1;
-    heap->elementos[i] = nueva_salida;
 
     /// Operación de subir (percolate up) para restaurar la propiedad de Heap.
-    while (i != 0 && heap->elementos[(i - 1) / 2].clave_salida > heap->elementos[i].clave_salida) {
-        Salida temp = heap->elementos[i];
-        heap->elementos[i] = heap->elementos[(i - 1) / 2];
-        heap->elementos[(i - 1) / 2] = temp;
-        i = (i - 1) / 2;
-    }
+    monticulo_salidas_insertar(heap, nueva_salida.clave_salida, nueva_salida.tren);
 }
 
 /**
@@ -396,32 +441,7 @@ Salida extraer_min_heap(Heap* heap) {
         return vacia; 
     }
     
-    Salida raiz = heap->elementos[0];
-    heap->elementos[0] = heap->elementos[heap->tamano - 1];
-    heap->tamano--;
-    min_heapify(heap, 0);
+    Salida raiz;
+    raiz.tren = monticulo_salidas_extraer(heap, &raiz.clave_salida);
     return raiz;
 }
-
-/**
- * @brief Restaura la propiedad de Min-Heap a partir del índice dado (operación de 'bajar' o sift-down).
- * @param heap Puntero al Heap.
- * @param i Índice a partir del cual se debe reestructurar el montículo.
- */
-void min_heapify(Heap* heap, int i) {
-    int izq = 2 * i + 1;
-    int der = 2 * i + 2;
-    int min = i;
-
-    if (izq < heap->tamano && heap->elementos[izq].clave_salida < heap->elementos[min].clave_salida)
-        min = izq;
-    if (der < heap->tamano && heap->elementos[der].clave_salida < heap->elementos[min].clave_salida)
-        min = der;
-        
-    if (min != i) {
-        Salida temp = heap->elementos[i];
-        heap->elementos[i] = heap->elementos[min];
-        heap->elementos[min] = temp;
-        min_heapify(heap, min);
-    }
-}
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 
 /**
  * @file gestor_drones.c
@@ -8,13 +9,20 @@
  */
 
 // Constantes
-#define MAX_NODOS 100
+#define MAX_NODOS 100 // Capacidad inicial del pool de nodos del ABB
 #define MAX_ID_LEN 20
 #define MAX_STR_LEN 50
 #define MAX_CARGA_LEN 30
 #define POS_VACIA -1
+#define NODO_LIBRE -2 // Marca en 'derecho' de un hueco reciclado del pool
 #define MAX_HEAP 100 // Capacidad inicial
 
+// Prueba diferencial (opción 12)
+#define PRUEBA_OPERACIONES 2000000 // Operaciones por defecto
+#define PRUEBA_CLAVES 4096         // Drones distintos que puede generar la prueba
+#define PRUEBA_ZONAS 16            // Zonas de entrega entre las que se reparten
+#define PRUEBA_REVISION 1000       // Operaciones entre dos revisiones completas
+
 // Estructuras
 typedef struct {
     char id_dron[MAX_ID_LEN];
@@ -29,11 +37,18 @@ typedef struct {
     int derecho;
 } Dron;
 
+// Pool de nodos que crece bajo demanda. Los enlaces son índices, así que un
+// realloc no invalida ningún índice guardado fuera (p. ej. en el heap).
+// Los huecos de los drones eliminados forman una lista libre enlazada por
+// 'izquierdo' y se reutilizan antes de estrenar huecos nuevos.
 typedef struct {
-    Dron elementos[MAX_NODOS];
+    Dron* elementos;
+    int capacidad;       // Huecos reservados
     int raiz;
-    int tamano;
-    int siguiente_libre;
+    int tamano;          // Drones en el árbol
+    int siguiente_libre; // Primer hueco sin estrenar
+    int primer_libre;    // Cabeza de la lista de huecos reciclados
+    int num_libres;      // Huecos en la lista libre
 } ABB;
 
 typedef struct {
@@ -48,11 +63,17 @@ typedef struct {
 } MaxHeap;
 
 // --- Prototipos ---
-void inicializarABB(ABB* abb);
+int inicializarABB(ABB* abb);
+void liberarABB(ABB* abb);
+int reservarNodoABB(ABB* abb);
+void liberarNodoABB(ABB* abb, int indice);
+int compactarABB(ABB* abb, MaxHeap* heap);
 int compararDrones(const Dron* d1, const Dron* d2);
+int insertarNodoABB(ABB* abb, const Dron* nuevo_dron, int* indice);
 int insertarDronABB(ABB* abb, Dron nuevo_dron);
 void buscarDronesPorZona(const ABB* abb, const char* zona);
 int buscarIndiceDron(const ABB* abb, const char* zona, const char* id);
+int eliminarNodoABB(ABB* abb, const char* zona, const char* id, const MaxHeap* heap);
 int eliminarDronABB(ABB* abb, const char* zona, const char* id, MaxHeap* heap);
 void recorrerInordenABB(const ABB* abb);
 void listarDronesFiltrados(const ABB* abb, const char* filtro, int tipo_filtro);
@@ -67,6 +88,7 @@ void heapifyDown(MaxHeap* heap, int indice);
 void redimensionarHeap(MaxHeap* heap);
 
 void cargarDronesPrueba(ABB* abb);
+int pruebaDiferencialABB(long operaciones, unsigned semilla);
 void mostrarDron(const Dron* nodo);
 
 // --- Función para mostrar drones ---
@@ -99,7 +121,12 @@ int main() {
         return 1;
     }
 
-    inicializarABB(&abb);
+    if (!inicializarABB(&abb)) {
+        printf("Error fatal: No se pudo asignar memoria para el ABB.\n");
+        free(heap->elementos);
+        free(heap);
+        return 1;
+    }
 
     int opcion;
     do {
@@ -115,6 +142,8 @@ int main() {
         printf("7. Mostrar todos los drones (inorden)\n");
         printf("8. Mostrar misiones programadas (Heap)\n");
         printf("9. Cargar drones de prueba del examen\n");
+        printf("11. Compactar el ABB (eliminar huecos libres)\n");
+        printf("12. Prueba diferencial aleatoria del ABB y el heap\n");
         printf("10. Salir\n");
         printf("Elige una opción: ");
 
@@ -230,8 +259,29 @@ int main() {
                 cargarDronesPrueba(&abb);
                 break;
 
+            case 11:
+                printf("Nodos: %d drones, %d huecos libres, capacidad %d\n", abb.tamano, abb.num_libres, abb.capacidad);
+                if (compactarABB(&abb, heap)) {
+                    printf("ABB compactado: %d drones en los índices 0..%d, capacidad %d\n", abb.tamano, abb.tamano - 1, abb.capacidad);
+                } else {
+                    printf("Error: No hay memoria para compactar el ABB.\n");
+                }
+                break;
+
+            case 12: {
+                long operaciones;
+                unsigned semilla;
+                printf("Número de operaciones (0 = %d): ", PRUEBA_OPERACIONES);
+                if (scanf("%ld", &operaciones) != 1) { while(getchar() != '\n'); printf("Valor inválido.\n"); break; }
+                printf("Semilla: ");
+                if (scanf("%u", &semilla) != 1) { while(getchar() != '\n'); printf("Valor inválido.\n"); break; }
+                pruebaDiferencialABB(operaciones > 0 ? operaciones : PRUEBA_OPERACIONES, semilla);
+                break;
+            }
+
             case 10:
                 printf("Saliendo del programa...\n");
+                liberarABB(&abb);
                 if (heap->elementos) free(heap->elementos);
                 if (heap) free(heap);
                 return 0;
@@ -248,14 +298,98 @@ int main() {
 // ===============================================
 // === ABB ===
 // ===============================================
-void inicializarABB(ABB* abb) {
+int inicializarABB(ABB* abb) {
+    abb->elementos = (Dron*)malloc(sizeof(Dron) * MAX_NODOS);
+    if (!abb->elementos) return 0;
+    abb->capacidad = MAX_NODOS;
     abb->raiz = POS_VACIA;
     abb->tamano = 0;
     abb->siguiente_libre = 0;
-    for (int i = 0; i < MAX_NODOS; i++) {
-        abb->elementos[i].izquierdo = POS_VACIA;
-        abb->elementos[i].derecho = POS_VACIA;
+    abb->primer_libre = POS_VACIA;
+    abb->num_libres = 0;
+    return 1;
+}
+
+void liberarABB(ABB* abb) {
+    free(abb->elementos);
+    abb->elementos = NULL;
+    abb->capacidad = 0;
+    abb->raiz = POS_VACIA;
+    abb->tamano = abb->siguiente_libre = abb->num_libres = 0;
+    abb->primer_libre = POS_VACIA;
+}
+
+// --- Pool de nodos ---
+// Devuelve un hueco para un dron nuevo: primero uno reciclado, después uno
+// sin estrenar y, si no queda ninguno, duplica la capacidad del pool.
+int reservarNodoABB(ABB* abb) {
+    if (abb->primer_libre != POS_VACIA) {
+        int indice = abb->primer_libre;
+        abb->primer_libre = abb->elementos[indice].izquierdo;
+        abb->num_libres--;
+        return indice;
     }
+    if (abb->siguiente_libre == abb->capacidad) {
+        if (abb->capacidad > INT_MAX / 2) return POS_VACIA;
+        int nueva_capacidad = abb->capacidad * 2;
+        Dron* nuevos = (Dron*)realloc(abb->elementos, sizeof(Dron) * (size_t)nueva_capacidad);
+        if (!nuevos) return POS_VACIA;
+        abb->elementos = nuevos;
+        abb->capacidad = nueva_capacidad;
+    }
+    return abb->siguiente_libre++;
+}
+
+void liberarNodoABB(ABB* abb, int indice) {
+    abb->elementos[indice].izquierdo = abb->primer_libre;
+    abb->elementos[indice].derecho = NODO_LIBRE;
+    abb->primer_libre = indice;
+    abb->num_libres++;
+}
+
+// Mueve los drones a los índices 0..tamano-1 (conservando su orden en el pool),
+// reescribe los enlaces del árbol y los índices de las misiones del heap, y
+// devuelve al sistema la memoria sobrante. Devuelve 0 si no hay memoria para
+// la tabla de traducción (el ABB queda intacto).
+int compactarABB(ABB* abb, MaxHeap* heap) {
+    if (abb->num_libres == 0) return 1;
+
+    int* nuevo_indice = (int*)malloc(sizeof(int) * (size_t)abb->siguiente_libre);
+    if (!nuevo_indice) return 0;
+
+    int n = 0;
+    for (int i = 0; i < abb->siguiente_libre; i++) {
+        if (abb->elementos[i].derecho == NODO_LIBRE) {
+            nuevo_indice[i] = POS_VACIA;
+        } else {
+            nuevo_indice[i] = n;
+            if (n != i) abb->elementos[n] = abb->elementos[i];
+            n++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        Dron* nodo = &abb->elementos[i];
+        if (nodo->izquierdo != POS_VACIA) nodo->izquierdo = nuevo_indice[nodo->izquierdo];
+        if (nodo->derecho != POS_VACIA) nodo->derecho = nuevo_indice[nodo->derecho];
+    }
+    if (abb->raiz != POS_VACIA) abb->raiz = nuevo_indice[abb->raiz];
+    for (int i = 0; i < heap->tamano; i++)
+        heap->elementos[i].indice_dron = nuevo_indice[heap->elementos[i].indice_dron];
+    free(nuevo_indice);
+
+    abb->siguiente_libre = n;
+    abb->primer_libre = POS_VACIA;
+    abb->num_libres = 0;
+
+    int nueva_capacidad = n > MAX_NODOS ? n : MAX_NODOS;
+    if (nueva_capacidad < abb->capacidad) {
+        Dron* nuevos = (Dron*)realloc(abb->elementos, sizeof(Dron) * (size_t)nueva_capacidad);
+        if (nuevos) { // Si no se puede encoger, el pool sigue siendo válido
+            abb->elementos = nuevos;
+            abb->capacidad = nueva_capacidad;
+        }
+    }
+    return 1;
 }
 
 int compararDrones(const Dron* d1, const Dron* d2) {
@@ -264,49 +398,47 @@ int compararDrones(const Dron* d1, const Dron* d2) {
     return strcmp(d1->id_dron, d2->id_dron);
 }
 
-int insertarRecursivoABB(ABB* abb, int indice_actual, int nuevo_indice) {
-    if (indice_actual == POS_VACIA) return nuevo_indice;
-
-    int cmp = compararDrones(&abb->elementos[nuevo_indice], &abb->elementos[indice_actual]);
-    if (cmp < 0) abb->elementos[indice_actual].izquierdo = insertarRecursivoABB(abb, abb->elementos[indice_actual].izquierdo, nuevo_indice);
-    else if (cmp > 0) abb->elementos[indice_actual].derecho = insertarRecursivoABB(abb, abb->elementos[indice_actual].derecho, nuevo_indice);
-    else {
-        printf("Error: Ya existe un dron con esta zona e ID\n");
-        return indice_actual;
+// Inserta sin mensajes. Devuelve 1 si se inserta (su índice queda en *indice),
+// 0 si ya existe un dron con esa zona e ID y -1 si no hay memoria.
+int insertarNodoABB(ABB* abb, const Dron* nuevo_dron, int* indice) {
+    // Se busca primero el hueco donde colgarlo, para no reservar nodo si es un duplicado
+    int padre = POS_VACIA;
+    int cmp = 0;
+    int actual = abb->raiz;
+    while (actual != POS_VACIA) {
+        cmp = compararDrones(nuevo_dron, &abb->elementos[actual]);
+        if (cmp == 0) return 0;
+        padre = actual;
+        actual = cmp < 0 ? abb->elementos[actual].izquierdo : abb->elementos[actual].derecho;
     }
-    return indice_actual;
+
+    int nuevo_indice = reservarNodoABB(abb);
+    if (nuevo_indice == POS_VACIA) return -1;
+    abb->elementos[nuevo_indice] = *nuevo_dron;
+    abb->elementos[nuevo_indice].izquierdo = POS_VACIA;
+    abb->elementos[nuevo_indice].derecho = POS_VACIA;
+
+    if (padre == POS_VACIA) abb->raiz = nuevo_indice;
+    else if (cmp < 0) abb->elementos[padre].izquierdo = nuevo_indice;
+    else abb->elementos[padre].derecho = nuevo_indice;
+
+    abb->tamano++;
+    if (indice) *indice = nuevo_indice;
+    return 1;
 }
 
 int insertarDronABB(ABB* abb, Dron nuevo_dron) {
-    if (abb->siguiente_libre >= MAX_NODOS) {
-        printf("Error: ABB lleno\n");
+    int resultado = insertarNodoABB(abb, &nuevo_dron, NULL);
+    if (resultado == 0) {
+        printf("Error: Ya existe un dron con esta zona e ID\n");
         return 0;
     }
-    int nuevo_indice = abb->siguiente_libre;
-    abb->elementos[nuevo_indice] = nuevo_dron; 
-    
-    int raiz_retornada = insertarRecursivoABB(abb, abb->raiz, nuevo_indice);
-    
-    // Si la inserción fue exitosa (no se encontró duplicado), incrementamos contadores
-    if (raiz_retornada == nuevo_indice || (abb->raiz != POS_VACIA && raiz_retornada == abb->raiz) || (abb->raiz == POS_VACIA && raiz_retornada == nuevo_indice)) {
-        
-        // Comprobar si realmente se insertó (no fue un duplicado)
-        // La forma más simple de verificar la inserción es si la raíz anterior era nula
-        // o si el nodo se colgó correctamente en algún lado.
-        
-        // Si el índice de inserción original no se ha reusado (no es duplicado)
-        if (nuevo_indice == abb->siguiente_libre) {
-            abb->raiz = raiz_retornada;
-            abb->siguiente_libre++;
-            abb->tamano++;
-            printf("Dron registrado exitosamente\n");
-            return 1;
-        } else {
-             // Ya se ha mostrado el error en insertarRecursivoABB
-             return 0;
-        }
+    if (resultado < 0) {
+        printf("Error: No hay memoria para ampliar el ABB\n");
+        return 0;
     }
-    return 0;
+    printf("Dron registrado exitosamente\n");
+    return 1;
 }
 
 void buscarPorZonaRecursivo(const ABB* abb, int indice, const char* zona) {
@@ -350,57 +482,65 @@ int dronEnHeap(const MaxHeap* heap, int indice_dron) {
 }
 
 // --- Eliminación de drones ---
-int buscarMinimo(const ABB* abb, int indice) {
-    while (abb->elementos[indice].izquierdo != POS_VACIA)
-        indice = abb->elementos[indice].izquierdo;
-    return indice;
-}
-
-int eliminarRecursivoABB(ABB* abb, int indice_actual, const char* zona, const char* id, MaxHeap* heap, int* exito) {
-    if (indice_actual == POS_VACIA) return POS_VACIA;
-    Dron* nodo = &abb->elementos[indice_actual];
-    
-    int cmp_zona = strcmp(zona, nodo->zona_entrega);
-    int cmp_id = strcmp(id, nodo->id_dron);
-
-    if (cmp_zona < 0 || (cmp_zona == 0 && cmp_id < 0)) {
-        nodo->izquierdo = eliminarRecursivoABB(abb, nodo->izquierdo, zona, id, heap, exito);
-    } else if (cmp_zona > 0 || (cmp_zona == 0 && cmp_id > 0)) {
-        nodo->derecho = eliminarRecursivoABB(abb, nodo->derecho, zona, id, heap, exito);
-    } else { 
-        if (dronEnHeap(heap, indice_actual)) {
-            printf("Error: El dron tiene una misión programada. No se puede eliminar.\n");
-            *exito = 0;
-            return indice_actual;
+// Cada dron se queda en su índice mientras existe: el nodo eliminado se
+// desengancha y, si tiene dos hijos, su sucesor se reenlaza en su lugar en vez
+// de copiarse encima. Así los indice_dron del heap siguen apuntando a su dron.
+// Devuelve 1 si se elimina, 0 si no existe y -1 si tiene una misión programada.
+int eliminarNodoABB(ABB* abb, const char* zona, const char* id, const MaxHeap* heap) {
+    int padre = POS_VACIA;
+    int indice = abb->raiz;
+    while (indice != POS_VACIA) {
+        const Dron* nodo = &abb->elementos[indice];
+        int cmp = strcmp(zona, nodo->zona_entrega);
+        if (cmp == 0) cmp = strcmp(id, nodo->id_dron);
+        if (cmp == 0) break;
+        padre = indice;
+        indice = cmp < 0 ? nodo->izquierdo : nodo->derecho;
+    }
+    if (indice == POS_VACIA) return 0;
+    if (dronEnHeap(heap, indice)) return -1;
+
+    Dron* nodo = &abb->elementos[indice];
+    int sustituto;
+    if (nodo->izquierdo == POS_VACIA) {
+        sustituto = nodo->derecho;
+    } else if (nodo->derecho == POS_VACIA) {
+        sustituto = nodo->izquierdo;
+    } else {
+        // El sucesor (mínimo del subárbol derecho) deja su sitio a su hijo derecho
+        // y hereda los dos hijos del nodo eliminado
+        int padre_sucesor = indice;
+        sustituto = nodo->derecho;
+        while (abb->elementos[sustituto].izquierdo != POS_VACIA) {
+            padre_sucesor = sustituto;
+            sustituto = abb->elementos[sustituto].izquierdo;
         }
-        *exito = 1; 
-
-        if (nodo->izquierdo == POS_VACIA) return nodo->derecho;
-        if (nodo->derecho == POS_VACIA) return nodo->izquierdo;
+        if (padre_sucesor != indice) {
+            abb->elementos[padre_sucesor].izquierdo = abb->elementos[sustituto].derecho;
+            abb->elementos[sustituto].derecho = nodo->derecho;
+        }
+        abb->elementos[sustituto].izquierdo = nodo->izquierdo;
+    }
 
-        int min_derecha = buscarMinimo(abb, nodo->derecho);
-        
-        // Copiar el contenido del sucesor al nodo actual
-        abb->elementos[indice_actual] = abb->elementos[min_derecha]; 
-        
-        // Eliminar el sucesor del subárbol derecho
-        nodo->derecho = eliminarRecursivoABB(abb, nodo->derecho, abb->elementos[min_derecha].zona_entrega, abb->elementos[min_derecha].id_dron, heap, exito);
+    if (padre == POS_VACIA) abb->raiz = sustituto;
+    else if (abb->elementos[padre].izquierdo == indice) abb->elementos[padre].izquierdo = sustituto;
+    else abb->elementos[padre].derecho = sustituto;
 
-    }
-    return indice_actual;
+    // El hueco pasa a la lista libre para el próximo dron que se registre
+    liberarNodoABB(abb, indice);
+    abb->tamano--;
+    return 1;
 }
 
 int eliminarDronABB(ABB* abb, const char* zona, const char* id, MaxHeap* heap) {
-    int exito = 0;
-    abb->raiz = eliminarRecursivoABB(abb, abb->raiz, zona, id, heap, &exito);
-    
-    if (exito) {
-        abb->tamano--;
+    int resultado = eliminarNodoABB(abb, zona, id, heap);
+    if (resultado == 1) {
         printf("Dron eliminado correctamente\n");
         return 1;
-    } else {
-        return 0;
     }
+    if (resultado < 0) printf("Error: El dron tiene una misión programada. No se puede eliminar.\n");
+    else printf("Error: Dron no encontrado.\n");
+    return 0;
 }
 
 // --- Recorrido inorden ---
@@ -543,3 +683,213 @@ void cargarDronesPrueba(ABB* abb) {
     insertarDronABB(abb, d3);
     printf("Drones de prueba cargados correctamente con valores decimales.\n");
 }
+
+// ===============================================
+// === PRUEBA DIFERENCIAL ===
+// ===============================================
+// Compara el ABB y el heap con un modelo de referencia trivial durante miles
+// de operaciones aleatorias. El modelo guarda, por cada clave de dron, el
+// índice que recibió al insertarse (o POS_VACIA) y sus misiones pendientes, y
+// las prioridades del heap se cuentan por nivel de batería.
+//
+// Tras cada operación se contrasta su resultado con el modelo y cada
+// PRUEBA_REVISION operaciones se revisa todo: orden del inorden, que cada dron
+// siga en el índice en el que se insertó, lista libre, propiedad de heap y que
+// cada misión apunte a su dron.
+
+typedef struct {
+    ABB abb;
+    MaxHeap* heap;
+    int modelo_indice[PRUEBA_CLAVES]; // Índice de cada clave en el ABB, o POS_VACIA
+    int misiones[PRUEBA_CLAVES];      // Misiones pendientes de cada clave
+    int cuenta_prioridad[101];        // Misiones pendientes por prioridad
+    int presentes;
+    int aux[PRUEBA_CLAVES];           // Pila del inorden, recuentos y traducción al compactar
+} PruebaABB;
+
+void dronDePrueba(Dron* dron, int clave) {
+    memset(dron, 0, sizeof(Dron));
+    snprintf(dron->id_dron, MAX_ID_LEN, "D%d", clave);
+    strcpy(dron->compania, "Prueba");
+    strcpy(dron->zona_origen, "Base");
+    snprintf(dron->zona_entrega, MAX_STR_LEN, "Z%02d", clave % PRUEBA_ZONAS);
+    dron->nivel_bateria = clave % 101;
+    dron->fecha_mision = 20250101;
+    dron->hora_mision = 1200;
+    strcpy(dron->tipo_carga, "Paquete");
+}
+
+int falloPrueba(long operacion, const char* motivo) {
+    printf("FALLO en la operación %ld: %s\n", operacion, motivo);
+    return 0;
+}
+
+int revisarPrueba(PruebaABB* p, long operacion) {
+    const ABB* abb = &p->abb;
+    if (abb->tamano != p->presentes) return falloPrueba(operacion, "tamaño del ABB distinto del modelo");
+    if (abb->tamano + abb->num_libres != abb->siguiente_libre) return falloPrueba(operacion, "huecos perdidos en el pool");
+
+    // Inorden iterativo: estrictamente creciente y con tamano nodos
+    int n = 0, visitados = 0;
+    const Dron* anterior = NULL;
+    int indice = abb->raiz;
+    while (indice != POS_VACIA || n > 0) {
+        while (indice != POS_VACIA) {
+            if (n == PRUEBA_CLAVES) return falloPrueba(operacion, "ciclo en el ABB");
+            p->aux[n++] = indice;
+            indice = abb->elementos[indice].izquierdo;
+        }
+        indice = p->aux[--n];
+        const Dron* nodo = &abb->elementos[indice];
+        if (nodo->derecho == NODO_LIBRE) return falloPrueba(operacion, "hueco libre enlazado en el árbol");
+        if (anterior && compararDrones(anterior, nodo) >= 0) return falloPrueba(operacion, "inorden desordenado");
+        anterior = nodo;
+        if (++visitados > abb->tamano) return falloPrueba(operacion, "más nodos enlazados que drones");
+        indice = nodo->derecho;
+    }
+    if (visitados != abb->tamano) return falloPrueba(operacion, "drones inalcanzables desde la raíz");
+
+    // Cada dron del modelo sigue en el índice que recibió
+    Dron esperado;
+    for (int clave = 0; clave < PRUEBA_CLAVES; clave++) {
+        if (p->modelo_indice[clave] == POS_VACIA) continue;
+        dronDePrueba(&esperado, clave);
+        if (compararDrones(&esperado, &abb->elementos[p->modelo_indice[clave]]) != 0)
+            return falloPrueba(operacion, "un dron ha cambiado de índice");
+    }
+
+    int libres = 0;
+    for (int i = abb->primer_libre; i != POS_VACIA; i = abb->elementos[i].izquierdo) {
+        if (abb->elementos[i].derecho != NODO_LIBRE || ++libres > abb->num_libres)
+            return falloPrueba(operacion, "lista libre corrupta");
+    }
+    if (libres != abb->num_libres) return falloPrueba(operacion, "lista libre incompleta");
+
+    // Heap: propiedad de orden y misiones por dron iguales al modelo
+    const MaxHeap* heap = p->heap;
+    memset(p->aux, 0, sizeof(p->aux));
+    for (int i = 0; i < heap->tamano; i++) {
+        const ElementoHeap* e = &heap->elementos[i];
+        if (i > 0 && e->prioridad > heap->elementos[(i - 1) / 2].prioridad)
+            return falloPrueba(operacion, "propiedad de heap rota");
+        if (e->indice_dron < 0 || e->indice_dron >= abb->siguiente_libre || abb->elementos[e->indice_dron].derecho == NODO_LIBRE)
+            return falloPrueba(operacion, "misión que apunta a un hueco libre");
+        int clave = atoi(abb->elementos[e->indice_dron].id_dron + 1);
+        if (p->modelo_indice[clave] != e->indice_dron) return falloPrueba(operacion, "misión que apunta a otro dron");
+        p->aux[clave]++;
+    }
+    for (int clave = 0; clave < PRUEBA_CLAVES; clave++) {
+        if (p->aux[clave] != p->misiones[clave]) return falloPrueba(operacion, "misiones distintas del modelo");
+    }
+    return 1;
+}
+
+// Devuelve 1 si todas las operaciones coinciden con el modelo, 0 en el primer fallo.
+int pruebaDiferencialABB(long operaciones, unsigned semilla) {
+    PruebaABB* p = (PruebaABB*)malloc(sizeof(PruebaABB));
+    if (!p) { printf("Error: No hay memoria para la prueba.\n"); return 0; }
+    p->heap = crearMaxHeap(MAX_HEAP);
+    if (!p->heap || !inicializarABB(&p->abb)) {
+        if (p->heap) { free(p->heap->elementos); free(p->heap); }
+        free(p);
+        printf("Error: No hay memoria para la prueba.\n");
+        return 0;
+    }
+    for (int clave = 0; clave < PRUEBA_CLAVES; clave++) {
+        p->modelo_indice[clave] = POS_VACIA;
+        p->misiones[clave] = 0;
+    }
+    memset(p->cuenta_prioridad, 0, sizeof(p->cuenta_prioridad));
+    p->presentes = 0;
+    srand(semilla);
+
+    long inserciones = 0, eliminaciones = 0, bloqueadas = 0, programadas = 0, despachadas = 0, compactaciones = 0;
+    int correcto = 1;
+    Dron dron;
+    for (long op = 1; op <= operaciones && correcto; op++) {
+        int tipo = rand() % 1000;
+        int clave = rand() % PRUEBA_CLAVES;
+        dronDePrueba(&dron, clave);
+
+        if (tipo < 400) { // Insertar
+            int indice;
+            int resultado = insertarNodoABB(&p->abb, &dron, &indice);
+            if (p->modelo_indice[clave] != POS_VACIA) {
+                if (resultado != 0) correcto = falloPrueba(op, "se insertó un duplicado");
+            } else if (resultado != 1) {
+                correcto = falloPrueba(op, "no se insertó un dron nuevo");
+            } else {
+                p->modelo_indice[clave] = indice;
+                p->presentes++;
+                inserciones++;
+            }
+        } else if (tipo < 700) { // Eliminar
+            int resultado = eliminarNodoABB(&p->abb, dron.zona_entrega, dron.id_dron, p->heap);
+            int esperado = p->modelo_indice[clave] == POS_VACIA ? 0 : (p->misiones[clave] > 0 ? -1 : 1);
+            if (resultado != esperado) {
+                correcto = falloPrueba(op, "resultado de la eliminación distinto del modelo");
+            } else if (resultado == 1) {
+                p->modelo_indice[clave] = POS_VACIA;
+                p->presentes--;
+                eliminaciones++;
+            } else if (resultado < 0) {
+                bloqueadas++;
+            }
+        } else if (tipo < 850) { // Programar misión
+            int indice = buscarIndiceDron(&p->abb, dron.zona_entrega, dron.id_dron);
+            if (indice != p->modelo_indice[clave]) {
+                correcto = falloPrueba(op, "la búsqueda devuelve otro índice");
+            } else if (indice != POS_VACIA) {
+                ElementoHeap mision = { indice, p->abb.elementos[indice].nivel_bateria };
+                insertarHeap(p->heap, mision);
+                p->misiones[clave]++;
+                p->cuenta_prioridad[mision.prioridad]++;
+                programadas++;
+            }
+        } else if (tipo < 999) { // Despachar (menos cuanto más vacío está el heap, para que acumule misiones)
+            if (p->heap->tamano <= rand() % 128) continue;
+            int maxima = 100;
+            while (p->cuenta_prioridad[maxima] == 0) maxima--;
+            ElementoHeap mision = extraerMaxHeap(p->heap);
+            const Dron* destino = &p->abb.elementos[mision.indice_dron];
+            int clave_mision = atoi(destino->id_dron + 1);
+            if (mision.prioridad != maxima) {
+                correcto = falloPrueba(op, "el heap no devuelve la prioridad máxima");
+            } else if (p->modelo_indice[clave_mision] != mision.indice_dron || p->misiones[clave_mision] == 0
+                       || destino->nivel_bateria != mision.prioridad) {
+                correcto = falloPrueba(op, "la misión despachada apunta a otro dron");
+            } else {
+                p->misiones[clave_mision]--;
+                p->cuenta_prioridad[maxima]--;
+                despachadas++;
+            }
+        } else { // Compactar: el modelo traduce sus índices por su cuenta
+            for (int i = 0; i < p->abb.siguiente_libre; i++) p->aux[i] = POS_VACIA;
+            for (int c = 0; c < PRUEBA_CLAVES; c++)
+                if (p->modelo_indice[c] != POS_VACIA) p->aux[p->modelo_indice[c]] = c;
+            int anterior = p->abb.siguiente_libre;
+            if (!compactarABB(&p->abb, p->heap)) {
+                correcto = falloPrueba(op, "sin memoria para compactar");
+            } else {
+                for (int i = 0, n = 0; i < anterior; i++)
+                    if (p->aux[i] != POS_VACIA) p->modelo_indice[p->aux[i]] = n++;
+                compactaciones++;
+            }
+        }
+
+        if (correcto && op % PRUEBA_REVISION == 0) correcto = revisarPrueba(p, op);
+    }
+    if (correcto) correcto = revisarPrueba(p, operaciones);
+
+    if (correcto) {
+        printf("Prueba superada: %ld operaciones con semilla %u\n", operaciones, semilla);
+        printf("  %ld inserciones, %ld eliminaciones (%ld bloqueadas por misión), %ld misiones, %ld despachos, %ld compactaciones\n",
+               inserciones, eliminaciones, bloqueadas, programadas, despachadas, compactaciones);
+        printf("  Estado final: %d drones, %d misiones, capacidad del pool %d\n", p->abb.tamano, p->heap->tamano, p->abb.capacidad);
+    }
+    liberarABB(&p->abb);
+    free(p->heap->elementos);
+    free(p->heap);
+    free(p);
+    return correcto;
+}
@@ -1,73 +1,135 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include "arena.h"
+#include "tabla_codigos.h"
+#include "indice_distancias.h"
+#include "monticulo_dario.h"
 
 /**
  * @file gestor_trenes.c
  * @brief Sistema de gestión de trenes logísticos utilizando ABB (ordenado por destino) 
  * y Max-Heap (ordenado por distancia para priorizar operaciones).
  * 
+ * El ABB tiene un nodo por destino (no por tren): cada nodo es una cubeta con un
+ * vector contiguo de los trenes a ese destino, así que "todos los trenes a X" es una
+ * búsqueda en el árbol de destinos y un recorrido del vector, por muchos trenes que
+ * compartan destino. Cada tren sabe su cubeta y su hueco en ella, y una tabla hash
+ * (tabla_codigos.h) lleva del ID al tren: buscar y eliminar por ID cuestan O(1) esperado.
+ * 
  * Opciones implementadas:
  * - ABB: Registrar, buscar, eliminar, listar todos, filtrar por tipo de carga o distancia
  * - Max-Heap: Programar operación, consultar próxima, atender operación, 
  *   mostrar operaciones, ordenar con Heapsort
+ *
+ * Los filtros por distancia no recorren el ABB: un índice secundario ordenado por
+ * distancia (indice_distancias.h) da los trenes con distancia >= X o entre X e Y en
+ * O(log n + k) y los cuenta en O(log n). Lo mantienen insertar_tren y eliminar_tren.
+ *
+ * El Max-Heap crece sin límite (monticulo_dario.h) y cada operación sabe su posición
+ * en él; cada tren enlaza sus operaciones pendientes. Así se cancelan las operaciones
+ * de un tren, o se recolocan cuando cambia su distancia, en O(log n) cada una, y al
+ * eliminar un tren no quedan operaciones apuntando a él.
  */
 
 // Constantes
 #define MAX_CODE_LEN 50
-#define MAX_HEAP 100
+#define MAX_HEAP 100                     // Capacidad inicial del heap (crece al llenarse)
+#define ARENA_TRENES_BLOQUE 256
+#define ARENA_OPERACIONES_BLOQUE 256
+#define ARENA_DESTINOS_BLOQUE 64
+#define CUBETA_INICIAL 4                 // Trenes del primer vector de cada destino
 
-// Estructura del Tren (Nodo del ABB)
+// Estructura del Tren (elemento de la cubeta de su destino)
 typedef struct tren {
-    char id_tren[MAX_CODE_LEN];
+    char id_tren[MAX_CODE_LEN];           // Único entre todos los trenes
     char compania[MAX_CODE_LEN];
     char origen[MAX_CODE_LEN];
-    char destino[MAX_CODE_LEN];          // Clave principal del ABB
+    char destino[MAX_CODE_LEN];          // Cubeta del ABB en la que está
     int distancia;                        // Distancia en km
     int fecha_operacion;                  // AAAAMMDD
     int hora_operacion;                   // HHMM
     char tipo_carga[MAX_CODE_LEN];
-    struct tren* izquierdo;
-    struct tren* derecho;
+    struct destino* cubeta;               // Nodo del ABB de su destino
+    int pos_cubeta;                       // Hueco en el vector de la cubeta
+    struct operacion* operaciones;        // Operaciones pendientes del tren (lista doble)
 } Tren;
 
+// Estructura del Destino (Nodo del ABB): cubeta con todos los trenes a ese destino
+typedef struct destino {
+    char destino[MAX_CODE_LEN];          // Clave del ABB (un nodo por destino)
+    Tren** trenes;                        // Vector contiguo de sus trenes, sin orden
+    int num_trenes;
+    int capacidad;
+    struct destino* izquierdo;
+    struct destino* derecho;
+} Destino;
+
 // Estructura de Operación (Elemento del Max-Heap)
 typedef struct operacion {
     Tren* tren;                          // Puntero al tren
     int clave_prioridad;                 // Distancia (a mayor distancia, mayor prioridad)
+    int pos_heap;                        // Posición en el heap (-1 si ya no está)
+    struct operacion* anterior;          // Operaciones del mismo tren
+    struct operacion* siguiente;
 } Operacion;
 
-// Estructura del Max-Heap
-typedef struct heap {
-    Operacion elementos[MAX_HEAP];
-    int tamano;
-} Heap;
+// Cada vez que el montículo mueve una operación se apunta su nueva posición
+#define POSICION_OPERACION(op, i) ((op)->pos_heap = (i))
+
+MONTICULO_DEFINIR(operaciones, int, Operacion*, HEAP_ARIDAD, POSICION_OPERACION)
+
+// Estructura del Max-Heap: el montículo de monticulo_dario.h es de mínimos,
+// así que la clave de cada operación es su prioridad cambiada de signo
+typedef Monticulo_operaciones Heap;
 
 // Declaración de funciones del ABB
-Tren* insertar_tren(Tren* raiz, Tren* nuevo_tren);
-Tren* buscar_tren_por_destino(Tren* raiz, const char* destino);
-Tren* buscar_tren_por_id(Tren* raiz, const char* id_tren);
-Tren* eliminar_tren(Tren* raiz, const char* destino, const char* id_tren);
-Tren* encontrar_min(Tren* raiz);
-void recorrer_inorden(Tren* raiz);
-void filtrar_por_carga(Tren* raiz, const char* tipo_carga);
-void filtrar_por_distancia_minima(Tren* raiz, int distancia_min);
-void liberar_arbol(Tren* raiz);
+Destino* insertar_tren(Destino* raiz, Tren* nuevo_tren);
+Destino* buscar_tren_por_destino(Destino* raiz, const char* destino);
+Tren* buscar_tren_por_id(Destino* raiz, const char* id_tren);
+Destino* eliminar_tren(Destino* raiz, const char* id_tren, Heap* heap);
+Destino* buscar_destino(Destino* raiz, const char* destino);
+void recorrer_inorden(Destino* raiz);
+void filtrar_por_carga(Destino* raiz, const char* tipo_carga);
+void filtrar_por_distancia(int distancia_min, int distancia_max);
+void liberar_arbol(Destino* raiz);
 
 // Declaración de funciones del Max-Heap
-void insertar_heap(Heap* heap, Operacion nueva_op);
-void max_heapify(Heap* heap, int i);
+int insertar_heap(Heap* heap, Tren* tren);
 Operacion extraer_max_heap(Heap* heap);
 void mostrar_heap(Heap* heap);
 void heapsort_y_mostrar(Heap* heap);
+int cancelar_operaciones(Heap* heap, Tren* tren);
+int actualizar_distancia(Heap* heap, Tren* tren, int nueva_distancia);
+
+// Todos los nodos Tren salen de esta arena (arena.h)
+Arena arena_trenes = ARENA_INICIAL(sizeof(Tren), ARENA_TRENES_BLOQUE);
+
+// Los nodos Destino (cubetas del ABB) salen de esta
+Arena arena_destinos = ARENA_INICIAL(sizeof(Destino), ARENA_DESTINOS_BLOQUE);
+
+// Las operaciones programadas salen de esta otra arena
+Arena arena_operaciones = ARENA_INICIAL(sizeof(Operacion), ARENA_OPERACIONES_BLOQUE);
+
+// Índice secundario de los trenes del ABB por distancia
+IndiceDistancias indice_distancias;
+
+// Tabla hash ID -> tren (IDs de hasta TABLA_CODIGO_MAX caracteres; los más largos se buscan en las cubetas)
+TablaCodigos indice_ids;
 
 // ========================================
 // FUNCIÓN PRINCIPAL
 // ========================================
 int main() {
-    Tren* arbol_trenes = NULL;
-    Heap heap_operaciones = {.tamano = 0};
+    Destino* arbol_trenes = NULL;
+    Heap heap_operaciones;
     int opcion;
+    if (!monticulo_operaciones_crear(&heap_operaciones, MAX_HEAP) || !tabla_crear(&indice_ids, MAX_HEAP)) {
+        printf("Error de memoria.\n");
+        return 1;
+    }
+    indice_distancias_crear(&indice_distancias);
 
     do {
         printf("\n============================================\n");
@@ -78,13 +140,15 @@ int main() {
         printf("2. Buscar tren por destino\n");
         printf("3. Eliminar tren\n");
         printf("4. Listar todos los trenes (ordenados por destino)\n");
-        printf("5. Listar trenes por tipo de carga o distancia mínima\n");
+        printf("5. Listar trenes por tipo de carga o distancia (mínima o rango)\n");
         printf("\n--- Max-Heap (Planificación de Operaciones) ---\n");
         printf("6. Programar operación\n");
         printf("7. Consultar próxima operación\n");
         printf("8. Atender operación\n");
         printf("9. Mostrar todas las operaciones programadas\n");
         printf("10. Mostrar planificación ordenada del día (Heapsort)\n");
+        printf("12. Cancelar las operaciones de un tren\n");
+        printf("13. Actualizar la distancia de un tren\n");
         printf("\n11. Salir\n");
         printf("Elige una opción: ");
         
@@ -95,11 +159,11 @@ int main() {
 
         char id_tren[MAX_CODE_LEN], destino[MAX_CODE_LEN], tipo_carga[MAX_CODE_LEN];
         Tren* tren_encontrado;
-        int distancia_min, filtro_opcion;
+        int distancia_min, distancia_max, filtro_opcion;
 
         switch(opcion) {
             case 1: { // Registrar tren
-                Tren* nuevo = (Tren*)malloc(sizeof(Tren));
+                Tren* nuevo = (Tren*)arena_reservar(&arena_trenes);
                 if (!nuevo) {
                     printf("Error de memoria.\n");
                     break;
@@ -122,7 +186,7 @@ int main() {
                 printf("Tipo de carga: ");
                 scanf("%s", nuevo->tipo_carga);
                 
-                nuevo->izquierdo = nuevo->derecho = NULL;
+                nuevo->operaciones = NULL;
                 arbol_trenes = insertar_tren(arbol_trenes, nuevo);
                 break;
             }
@@ -131,19 +195,16 @@ int main() {
                 printf("Ingrese destino: ");
                 scanf("%s", destino);
                 printf("\n--- Trenes con destino a %s ---\n", destino);
-                tren_encontrado = buscar_tren_por_destino(arbol_trenes, destino);
-                if (!tren_encontrado) {
+                if (!buscar_tren_por_destino(arbol_trenes, destino)) {
                     printf("No se encontraron trenes con ese destino.\n");
                 }
                 break;
             }
 
             case 3: { // Eliminar tren
-                printf("Ingrese destino: ");
-                scanf("%s", destino);
                 printf("Ingrese ID del tren: ");
                 scanf("%s", id_tren);
-                arbol_trenes = eliminar_tren(arbol_trenes, destino, id_tren);
+                arbol_trenes = eliminar_tren(arbol_trenes, id_tren, &heap_operaciones);
                 break;
             }
 
@@ -157,6 +218,7 @@ int main() {
                 printf("Filtrar por:\n");
                 printf("1. Tipo de carga\n");
                 printf("2. Distancia mínima\n");
+                printf("3. Rango de distancias\n");
                 printf("Opción: ");
                 scanf("%d", &filtro_opcion);
                 
@@ -169,7 +231,14 @@ int main() {
                     printf("Ingrese distancia mínima (km): ");
                     scanf("%d", &distancia_min);
                     printf("\n--- Trenes con distancia >= %d km ---\n", distancia_min);
-                    filtrar_por_distancia_minima(arbol_trenes, distancia_min);
+                    filtrar_por_distancia(distancia_min, INT_MAX);
+                } else if (filtro_opcion == 3) {
+                    printf("Ingrese distancia mínima (km): ");
+                    scanf("%d", &distancia_min);
+                    printf("Ingrese distancia máxima (km): ");
+                    scanf("%d", &distancia_max);
+                    printf("\n--- Trenes con distancia entre %d y %d km ---\n", distancia_min, distancia_max);
+                    filtrar_por_distancia(distancia_min, distancia_max);
                 } else {
                     printf("Opción inválida.\n");
                 }
@@ -182,12 +251,10 @@ int main() {
                 tren_encontrado = buscar_tren_por_id(arbol_trenes, id_tren);
                 
                 if (tren_encontrado) {
-                    Operacion nueva_op;
-                    nueva_op.tren = tren_encontrado;
-                    nueva_op.clave_prioridad = tren_encontrado->distancia;
-                    insertar_heap(&heap_operaciones, nueva_op);
-                    printf("Operación programada correctamente (Prioridad: %d km).\n", 
-                           tren_encontrado->distancia);
+                    if (insertar_heap(&heap_operaciones, tren_encontrado)) {
+                        printf("Operación programada correctamente (Prioridad: %d km).\n", 
+                               tren_encontrado->distancia);
+                    }
                 } else {
                     printf("Error: Tren no encontrado.\n");
                 }
@@ -196,7 +263,7 @@ int main() {
 
             case 7: { // Consultar próxima operación
                 if (heap_operaciones.tamano > 0) {
-                    Tren* t = heap_operaciones.elementos[0].tren;
+                    Tren* t = heap_operaciones.datos[0]->tren;
                     printf("\n--- Próxima operación (mayor prioridad) ---\n");
                     printf("ID: %s | Destino: %s | Distancia: %d km | Compañía: %s\n",
                            t->id_tren, t->destino, t->distancia, t->compania);
@@ -233,8 +300,42 @@ int main() {
                 break;
             }
 
+            case 12: { // Cancelar operaciones de un tren
+                printf("Ingrese ID del tren: ");
+                scanf("%s", id_tren);
+                tren_encontrado = buscar_tren_por_id(arbol_trenes, id_tren);
+                if (tren_encontrado) {
+                    printf("Operaciones canceladas: %d\n", cancelar_operaciones(&heap_operaciones, tren_encontrado));
+                } else {
+                    printf("Error: Tren no encontrado.\n");
+                }
+                break;
+            }
+
+            case 13: { // Actualizar distancia (y prioridad de sus operaciones)
+                printf("Ingrese ID del tren: ");
+                scanf("%s", id_tren);
+                tren_encontrado = buscar_tren_por_id(arbol_trenes, id_tren);
+                if (tren_encontrado) {
+                    printf("Nueva distancia (km): ");
+                    scanf("%d", &distancia_min);
+                    if (actualizar_distancia(&heap_operaciones, tren_encontrado, distancia_min)) {
+                        printf("Distancia actualizada: %d km.\n", tren_encontrado->distancia);
+                    }
+                } else {
+                    printf("Error: Tren no encontrado.\n");
+                }
+                break;
+            }
+
             case 11: // Salir
-                liberar_arbol(arbol_trenes);
+                liberar_arbol(arbol_trenes); // Vectores de las cubetas
+                arena_destruir(&arena_destinos);
+                arena_destruir(&arena_trenes); // Todos los trenes de golpe, sin recorrer el árbol
+                tabla_liberar(&indice_ids);
+                arena_destruir(&arena_operaciones);
+                monticulo_operaciones_liberar(&heap_operaciones);
+                indice_distancias_liberar(&indice_distancias);
                 printf("Saliendo del sistema...\n");
                 break;
 
@@ -251,256 +352,320 @@ int main() {
 // IMPLEMENTACIÓN DEL ABB
 // ========================================
 
-// Insertar tren en el ABB (ordenado por destino, criterio secundario id_tren)
-Tren* insertar_tren(Tren* raiz, Tren* nuevo_tren) {
-    if (raiz == NULL) {
-        printf("Tren registrado: %s (destino: %s)\n", nuevo_tren->id_tren, nuevo_tren->destino);
-        return nuevo_tren;
+// Buscar la cubeta de un destino (iterativo)
+Destino* buscar_destino(Destino* raiz, const char* destino) {
+    while (raiz != NULL) {
+        int cmp = strcmp(destino, raiz->destino);
+        if (cmp == 0) return raiz;
+        raiz = cmp < 0 ? raiz->izquierdo : raiz->derecho;
+    }
+    return NULL;
+}
+
+// Asegurar sitio para un tren más en el vector de la cubeta (duplica al llenarse)
+static int cubeta_reservar(Destino* cubeta) {
+    if (cubeta->num_trenes < cubeta->capacidad) return 1;
+    int capacidad = cubeta->capacidad > 0 ? cubeta->capacidad * 2 : CUBETA_INICIAL;
+    Tren** trenes = (Tren**)realloc(cubeta->trenes, sizeof(Tren*) * capacidad);
+    if (!trenes) return 0;
+    cubeta->trenes = trenes;
+    cubeta->capacidad = capacidad;
+    return 1;
+}
+
+// Insertar tren: se añade al final del vector de su destino (creando la cubeta si es
+// el primero) y se da de alta en la tabla de IDs y en el índice de distancias
+Destino* insertar_tren(Destino* raiz, Tren* nuevo_tren) {
+    if (buscar_tren_por_id(raiz, nuevo_tren->id_tren)) {
+        printf("Error: Ya existe un tren con ID '%s'.\n", nuevo_tren->id_tren);
+        arena_liberar(&arena_trenes, nuevo_tren);
+        return raiz;
     }
     
-    int cmp = strcmp(nuevo_tren->destino, raiz->destino);
+    // Bajar hasta la cubeta del destino o hasta el enlace vacío donde irá la nueva
+    Destino** enlace = &raiz;
+    while (*enlace != NULL) {
+        int cmp = strcmp(nuevo_tren->destino, (*enlace)->destino);
+        if (cmp == 0) break;
+        enlace = cmp < 0 ? &(*enlace)->izquierdo : &(*enlace)->derecho;
+    }
     
-    if (cmp < 0) {
-        raiz->izquierdo = insertar_tren(raiz->izquierdo, nuevo_tren);
-    } else if (cmp > 0) {
-        raiz->derecho = insertar_tren(raiz->derecho, nuevo_tren);
-    } else {
-        // Destinos iguales: usar ID como criterio secundario
-        int cmp_id = strcmp(nuevo_tren->id_tren, raiz->id_tren);
-        if (cmp_id < 0) {
-            raiz->izquierdo = insertar_tren(raiz->izquierdo, nuevo_tren);
-        } else if (cmp_id > 0) {
-            raiz->derecho = insertar_tren(raiz->derecho, nuevo_tren);
-        } else {
-            printf("Error: Ya existe un tren con destino '%s' e ID '%s'.\n", 
-                   nuevo_tren->destino, nuevo_tren->id_tren);
-            free(nuevo_tren);
+    Destino* cubeta = *enlace;
+    if (cubeta == NULL) {
+        cubeta = (Destino*)arena_reservar(&arena_destinos);
+        if (!cubeta) {
+            printf("Error de memoria.\n");
+            arena_liberar(&arena_trenes, nuevo_tren);
+            return raiz;
         }
+        strcpy(cubeta->destino, nuevo_tren->destino);
+        cubeta->trenes = NULL;
+        cubeta->num_trenes = cubeta->capacidad = 0;
+        cubeta->izquierdo = cubeta->derecho = NULL;
     }
+    
+    // Todo lo que puede fallar va antes de enlazar nada
+    uint64_t clave;
+    int en_tabla = tabla_codigo_clave(nuevo_tren->id_tren, &clave);
+    int ok = cubeta_reservar(cubeta);
+    if (ok && en_tabla) ok = tabla_insertar(&indice_ids, clave, nuevo_tren) > 0;
+    if (ok && !indice_distancias_insertar(&indice_distancias, nuevo_tren->distancia, nuevo_tren)) {
+        if (en_tabla) tabla_eliminar(&indice_ids, clave);
+        ok = 0;
+    }
+    if (!ok) {
+        printf("Error de memoria.\n");
+        if (*enlace == NULL) { // Cubeta nueva sin enlazar
+            free(cubeta->trenes);
+            arena_liberar(&arena_destinos, cubeta);
+        }
+        arena_liberar(&arena_trenes, nuevo_tren);
+        return raiz;
+    }
+    
+    nuevo_tren->cubeta = cubeta;
+    nuevo_tren->pos_cubeta = cubeta->num_trenes;
+    cubeta->trenes[cubeta->num_trenes++] = nuevo_tren;
+    *enlace = cubeta;
+    printf("Tren registrado: %s (destino: %s)\n", nuevo_tren->id_tren, nuevo_tren->destino);
     return raiz;
 }
 
-// Buscar y mostrar todos los trenes con un destino específico
-Tren* buscar_tren_por_destino(Tren* raiz, const char* destino) {
-    if (raiz == NULL) return NULL;
-    
-    // Recorrer todo el árbol para encontrar todos los trenes con ese destino
-    Tren* encontrado = NULL;
-    
-    buscar_tren_por_destino(raiz->izquierdo, destino);
+// Buscar y mostrar todos los trenes con un destino específico: una bajada por el
+// árbol de destinos y un recorrido del vector de la cubeta. Devuelve la cubeta o NULL.
+Destino* buscar_tren_por_destino(Destino* raiz, const char* destino) {
+    Destino* cubeta = buscar_destino(raiz, destino);
+    if (cubeta == NULL) return NULL;
     
-    if (strcmp(raiz->destino, destino) == 0) {
+    for (int i = 0; i < cubeta->num_trenes; i++) {
+        Tren* t = cubeta->trenes[i];
         printf("ID: %s | Compañía: %s | Origen: %s | Distancia: %d km | Carga: %s\n",
-               raiz->id_tren, raiz->compania, raiz->origen, raiz->distancia, raiz->tipo_carga);
-        encontrado = raiz;
+               t->id_tren, t->compania, t->origen, t->distancia, t->tipo_carga);
     }
-    
-    buscar_tren_por_destino(raiz->derecho, destino);
-    
-    return encontrado;
+    return cubeta;
 }
 
-// Buscar tren por ID (recorrido completo)
-Tren* buscar_tren_por_id(Tren* raiz, const char* id_tren) {
+// Buscar un ID recorriendo las cubetas (solo para IDs que no caben en la tabla hash)
+static Tren* buscar_id_en_cubetas(Destino* raiz, const char* id_tren) {
     if (raiz == NULL) return NULL;
-    
-    if (strcmp(raiz->id_tren, id_tren) == 0) {
-        return raiz;
+    for (int i = 0; i < raiz->num_trenes; i++) {
+        if (strcmp(raiz->trenes[i]->id_tren, id_tren) == 0) return raiz->trenes[i];
     }
-    
-    Tren* izq = buscar_tren_por_id(raiz->izquierdo, id_tren);
+    Tren* izq = buscar_id_en_cubetas(raiz->izquierdo, id_tren);
     if (izq) return izq;
-    
-    return buscar_tren_por_id(raiz->derecho, id_tren);
+    return buscar_id_en_cubetas(raiz->derecho, id_tren);
 }
 
-// Encontrar el nodo mínimo (más a la izquierda)
-Tren* encontrar_min(Tren* raiz) {
-    while (raiz && raiz->izquierdo) {
-        raiz = raiz->izquierdo;
-    }
-    return raiz;
+// Buscar tren por ID: O(1) esperado en la tabla hash
+Tren* buscar_tren_por_id(Destino* raiz, const char* id_tren) {
+    uint64_t clave;
+    if (tabla_codigo_clave(id_tren, &clave)) return (Tren*)tabla_buscar(&indice_ids, clave);
+    return buscar_id_en_cubetas(raiz, id_tren);
 }
 
-// Eliminar tren del ABB
-Tren* eliminar_tren(Tren* raiz, const char* destino, const char* id_tren) {
-    if (raiz == NULL) {
-        printf("Error: Tren no encontrado.\n");
-        return NULL;
-    }
+// Quitar del ABB la cubeta de un destino (ya vacía) y liberarla. Con dos hijos, el
+// sucesor inorden se desengancha y ocupa su lugar: los trenes apuntan a su cubeta.
+static Destino* quitar_destino(Destino* raiz, const char* destino) {
+    if (raiz == NULL) return NULL;
     
     int cmp = strcmp(destino, raiz->destino);
-    
     if (cmp < 0) {
-        raiz->izquierdo = eliminar_tren(raiz->izquierdo, destino, id_tren);
-    } else if (cmp > 0) {
-        raiz->derecho = eliminar_tren(raiz->derecho, destino, id_tren);
+        raiz->izquierdo = quitar_destino(raiz->izquierdo, destino);
+        return raiz;
+    }
+    if (cmp > 0) {
+        raiz->derecho = quitar_destino(raiz->derecho, destino);
+        return raiz;
+    }
+    
+    Destino* sustituto;
+    if (raiz->izquierdo == NULL) {
+        sustituto = raiz->derecho;
+    } else if (raiz->derecho == NULL) {
+        sustituto = raiz->izquierdo;
     } else {
-        // Destino coincide, verificar ID
-        int cmp_id = strcmp(id_tren, raiz->id_tren);
-        
-        if (cmp_id < 0) {
-            raiz->izquierdo = eliminar_tren(raiz->izquierdo, destino, id_tren);
-        } else if (cmp_id > 0) {
-            raiz->derecho = eliminar_tren(raiz->derecho, destino, id_tren);
-        } else {
-            // Nodo encontrado - Casos de eliminación
-            
-            // Caso 1: Nodo hoja
-            if (raiz->izquierdo == NULL && raiz->derecho == NULL) {
-                printf("Tren eliminado: %s\n", raiz->id_tren);
-                free(raiz);
-                return NULL;
-            }
-            
-            // Caso 2: Un hijo (derecho)
-            if (raiz->izquierdo == NULL) {
-                Tren* temp = raiz->derecho;
-                printf("Tren eliminado: %s\n", raiz->id_tren);
-                free(raiz);
-                return temp;
-            }
-            
-            // Caso 2: Un hijo (izquierdo)
-            if (raiz->derecho == NULL) {
-                Tren* temp = raiz->izquierdo;
-                printf("Tren eliminado: %s\n", raiz->id_tren);
-                free(raiz);
-                return temp;
-            }
-            
-            // Caso 3: Dos hijos - Usar sucesor inorden
-            Tren* sucesor = encontrar_min(raiz->derecho);
-            
-            // Copiar datos del sucesor
-            strcpy(raiz->id_tren, sucesor->id_tren);
-            strcpy(raiz->compania, sucesor->compania);
-            strcpy(raiz->origen, sucesor->origen);
-            strcpy(raiz->destino, sucesor->destino);
-            raiz->distancia = sucesor->distancia;
-            raiz->fecha_operacion = sucesor->fecha_operacion;
-            raiz->hora_operacion = sucesor->hora_operacion;
-            strcpy(raiz->tipo_carga, sucesor->tipo_carga);
-            
-            // Eliminar el sucesor
-            raiz->derecho = eliminar_tren(raiz->derecho, sucesor->destino, sucesor->id_tren);
+        Destino** enlace = &raiz->derecho;
+        while ((*enlace)->izquierdo != NULL) {
+            enlace = &(*enlace)->izquierdo;
         }
+        sustituto = *enlace;
+        *enlace = sustituto->derecho;
+        sustituto->izquierdo = raiz->izquierdo;
+        sustituto->derecho = raiz->derecho;
     }
+    free(raiz->trenes);
+    arena_liberar(&arena_destinos, raiz);
+    return sustituto;
+}
+
+// Eliminar tren por ID (sus operaciones pendientes se cancelan antes de liberarlo).
+// El último tren de la cubeta ocupa su hueco; si la cubeta se vacía, sale del ABB.
+Destino* eliminar_tren(Destino* raiz, const char* id_tren, Heap* heap) {
+    Tren* tren = buscar_tren_por_id(raiz, id_tren);
+    if (tren == NULL) {
+        printf("Error: Tren no encontrado.\n");
+        return raiz;
+    }
+    
+    int canceladas = cancelar_operaciones(heap, tren);
+    if (canceladas > 0) printf("Operaciones canceladas: %d\n", canceladas);
+    indice_distancias_quitar(&indice_distancias, tren->distancia, tren);
+    uint64_t clave;
+    if (tabla_codigo_clave(tren->id_tren, &clave)) tabla_eliminar(&indice_ids, clave);
     
+    Destino* cubeta = tren->cubeta;
+    Tren* ultimo = cubeta->trenes[--cubeta->num_trenes];
+    cubeta->trenes[tren->pos_cubeta] = ultimo;
+    ultimo->pos_cubeta = tren->pos_cubeta;
+    if (cubeta->num_trenes == 0) raiz = quitar_destino(raiz, cubeta->destino);
+    
+    printf("Tren eliminado: %s\n", tren->id_tren);
+    arena_liberar(&arena_trenes, tren);
     return raiz;
 }
 
 // Recorrido inorden (muestra trenes ordenados por destino)
-void recorrer_inorden(Tren* raiz) {
+void recorrer_inorden(Destino* raiz) {
     if (raiz == NULL) return;
     
     recorrer_inorden(raiz->izquierdo);
-    printf("ID: %s | Destino: %s | Origen: %s | Distancia: %d km | Compañía: %s | Carga: %s\n",
-           raiz->id_tren, raiz->destino, raiz->origen, raiz->distancia, 
-           raiz->compania, raiz->tipo_carga);
+    for (int i = 0; i < raiz->num_trenes; i++) {
+        Tren* t = raiz->trenes[i];
+        printf("ID: %s | Destino: %s | Origen: %s | Distancia: %d km | Compañía: %s | Carga: %s\n",
+               t->id_tren, t->destino, t->origen, t->distancia, 
+               t->compania, t->tipo_carga);
+    }
     recorrer_inorden(raiz->derecho);
 }
 
 // Filtrar por tipo de carga
-void filtrar_por_carga(Tren* raiz, const char* tipo_carga) {
+void filtrar_por_carga(Destino* raiz, const char* tipo_carga) {
     if (raiz == NULL) return;
     
     filtrar_por_carga(raiz->izquierdo, tipo_carga);
     
-    if (strcmp(raiz->tipo_carga, tipo_carga) == 0) {
-        printf("ID: %s | Destino: %s | Distancia: %d km | Compañía: %s\n",
-               raiz->id_tren, raiz->destino, raiz->distancia, raiz->compania);
+    for (int i = 0; i < raiz->num_trenes; i++) {
+        Tren* t = raiz->trenes[i];
+        if (strcmp(t->tipo_carga, tipo_carga) == 0) {
+            printf("ID: %s | Destino: %s | Distancia: %d km | Compañía: %s\n",
+                   t->id_tren, t->destino, t->distancia, t->compania);
+        }
     }
     
     filtrar_por_carga(raiz->derecho, tipo_carga);
 }
 
-// Filtrar por distancia mínima
-void filtrar_por_distancia_minima(Tren* raiz, int distancia_min) {
-    if (raiz == NULL) return;
+// Filtrar por distancia en [distancia_min, distancia_max] con el índice secundario:
+// O(log n) hasta el primer tren del rango y uno por tren listado, en orden de distancia
+void filtrar_por_distancia(int distancia_min, int distancia_max) {
+    RecorridoDistancias recorrido;
+    indice_distancias_recorrido_iniciar(&recorrido, &indice_distancias, distancia_min, distancia_max);
     
-    filtrar_por_distancia_minima(raiz->izquierdo, distancia_min);
-    
-    if (raiz->distancia >= distancia_min) {
+    Tren* t;
+    while ((t = (Tren*)indice_distancias_recorrido_siguiente(&recorrido, NULL)) != NULL) {
         printf("ID: %s | Destino: %s | Distancia: %d km | Carga: %s\n",
-               raiz->id_tren, raiz->destino, raiz->distancia, raiz->tipo_carga);
+               t->id_tren, t->destino, t->distancia, t->tipo_carga);
     }
     
-    filtrar_por_distancia_minima(raiz->derecho, distancia_min);
+    // El recuento baja dos ramas del índice sin visitar los trenes
+    printf("Total: %d trenes.\n", indice_distancias_contar(&indice_distancias, distancia_min, distancia_max));
 }
 
-// Liberar memoria del árbol
-void liberar_arbol(Tren* raiz) {
+// Liberar los vectores de las cubetas de un subárbol y devolver sus nodos y trenes a
+// las arenas (las arenas enteras se liberan después con arena_destruir)
+void liberar_arbol(Destino* raiz) {
     if (raiz == NULL) return;
     liberar_arbol(raiz->izquierdo);
     liberar_arbol(raiz->derecho);
-    free(raiz);
+    for (int i = 0; i < raiz->num_trenes; i++) arena_liberar(&arena_trenes, raiz->trenes[i]);
+    free(raiz->trenes);
+    arena_liberar(&arena_destinos, raiz);
 }
 
 // ========================================
 // IMPLEMENTACIÓN DEL MAX-HEAP
 // ========================================
 
-// Insertar en Max-Heap y realizar heapify-up
-void insertar_heap(Heap* heap, Operacion nueva_op) {
-    if (heap->tamano >= MAX_HEAP) {
-        printf("Error: Heap lleno.\n");
-        return;
+// Programar una operación del tren: se enlaza a su lista y entra en el heap
+// (que duplica su capacidad al llenarse). Devuelve 1, o 0 si no hay memoria.
+int insertar_heap(Heap* heap, Tren* tren) {
+    Operacion* op = (Operacion*)arena_reservar(&arena_operaciones);
+    if (op == NULL) {
+        printf("Error de memoria.\n");
+        return 0;
     }
+    op->tren = tren;
+    op->clave_prioridad = tren->distancia;
     
-    // Insertar al final
-    int i = heap->tamano;
-    heap->elementos[i] = nueva_op;
-    heap->tamano++;
-    
-    // Heapify-up: subir el elemento mientras sea mayor que su padre
-    while (i > 0 && heap->elementos[(i-1)/2].clave_prioridad < heap->elementos[i].clave_prioridad) {
-        Operacion temp = heap->elementos[i];
-        heap->elementos[i] = heap->elementos[(i-1)/2];
-        heap->elementos[(i-1)/2] = temp;
-        i = (i-1)/2;
+    // Heapify-up: con la clave en negativo, la mayor distancia sube a la raíz
+    if (!monticulo_operaciones_insertar(heap, -op->clave_prioridad, op)) {
+        printf("Error de memoria.\n");
+        arena_liberar(&arena_operaciones, op);
+        return 0;
     }
+    
+    op->anterior = NULL;
+    op->siguiente = tren->operaciones;
+    if (tren->operaciones) tren->operaciones->anterior = op;
+    tren->operaciones = op;
+    return 1;
 }
 
-// Max-heapify: mantener propiedad de Max-Heap hacia abajo
-void max_heapify(Heap* heap, int i) {
-    int izq = 2*i + 1;
-    int der = 2*i + 2;
-    int mayor = i;
-    
-    if (izq < heap->tamano && 
-        heap->elementos[izq].clave_prioridad > heap->elementos[mayor].clave_prioridad) {
-        mayor = izq;
-    }
-    
-    if (der < heap->tamano && 
-        heap->elementos[der].clave_prioridad > heap->elementos[mayor].clave_prioridad) {
-        mayor = der;
-    }
-    
-    if (mayor != i) {
-        Operacion temp = heap->elementos[i];
-        heap->elementos[i] = heap->elementos[mayor];
-        heap->elementos[mayor] = temp;
-        max_heapify(heap, mayor);
-    }
+// Desenlazar una operación de la lista de su tren y devolverla a la arena
+static void liberar_operacion(Operacion* op) {
+    if (op->anterior) op->anterior->siguiente = op->siguiente;
+    else op->tren->operaciones = op->siguiente;
+    if (op->siguiente) op->siguiente->anterior = op->anterior;
+    arena_liberar(&arena_operaciones, op);
 }
 
 // Extraer máximo (raíz) del Max-Heap
 Operacion extraer_max_heap(Heap* heap) {
     if (heap->tamano <= 0) {
-        Operacion vacia = {NULL, 0};
+        Operacion vacia = {NULL, 0, -1, NULL, NULL};
         return vacia;
     }
     
-    Operacion max = heap->elementos[0];
-    heap->elementos[0] = heap->elementos[heap->tamano - 1];
-    heap->tamano--;
-    max_heapify(heap, 0);
+    Operacion* op = monticulo_operaciones_extraer(heap, NULL);
+    Operacion max = *op;
+    liberar_operacion(op);
+    max.anterior = max.siguiente = NULL;
     
     return max;
 }
 
+// Cancelar todas las operaciones pendientes de un tren: cada una se quita de su
+// posición del heap en O(log n). Devuelve cuántas se han cancelado.
+int cancelar_operaciones(Heap* heap, Tren* tren) {
+    int canceladas = 0;
+    while (tren->operaciones) {
+        Operacion* op = tren->operaciones;
+        monticulo_operaciones_quitar(heap, op->pos_heap);
+        liberar_operacion(op);
+        canceladas++;
+    }
+    return canceladas;
+}
+
+// Cambiar la distancia de un tren: se recoloca en el índice de distancias y cada
+// una de sus operaciones sube o baja en el heap con su nueva prioridad (O(log n)).
+// Devuelve 1, o 0 si no hay memoria para el índice (el tren no cambia).
+int actualizar_distancia(Heap* heap, Tren* tren, int nueva_distancia) {
+    indice_distancias_quitar(&indice_distancias, tren->distancia, tren);
+    if (!indice_distancias_insertar(&indice_distancias, nueva_distancia, tren)) {
+        printf("Error de memoria en el índice de distancias.\n");
+        indice_distancias_insertar(&indice_distancias, tren->distancia, tren); // Reutiliza el nodo liberado
+        return 0;
+    }
+    tren->distancia = nueva_distancia;
+    
+    for (Operacion* op = tren->operaciones; op != NULL; op = op->siguiente) {
+        op->clave_prioridad = nueva_distancia;
+        monticulo_operaciones_cambiar_clave(heap, op->pos_heap, -nueva_distancia);
+    }
+    return 1;
+}
+
 // Mostrar heap como array
 void mostrar_heap(Heap* heap) {
     if (heap->tamano == 0) {
@@ -509,32 +674,34 @@ void mostrar_heap(Heap* heap) {
     }
     
     for (int i = 0; i < heap->tamano; i++) {
-        Tren* t = heap->elementos[i].tren;
+        Tren* t = heap->datos[i]->tren;
         printf("[%d] ID: %s | Destino: %s | Prioridad: %d km\n",
-               i, t->id_tren, t->destino, heap->elementos[i].clave_prioridad);
+               i, t->id_tren, t->destino, heap->datos[i]->clave_prioridad);
     }
 }
 
-// Heapsort: ordenar y mostrar sin modificar el heap original
+// Heapsort: mostrar en orden descendente sin modificar el heap original.
+// No se copia el heap (las posiciones guardadas en las operaciones se estropearían):
+// un recorrido perezoso del montículo va sacando las posiciones en orden de clave.
 void heapsort_y_mostrar(Heap* heap) {
     if (heap->tamano == 0) {
         printf("No hay operaciones para ordenar.\n");
         return;
     }
     
-    // Crear copia del heap
-    Heap copia;
-    copia.tamano = heap->tamano;
-    for (int i = 0; i < heap->tamano; i++) {
-        copia.elementos[i] = heap->elementos[i];
+    RecorridoMonticulo_operaciones recorrido;
+    if (!monticulo_operaciones_recorrido_iniciar(&recorrido, heap)) {
+        printf("Error de memoria.\n");
+        return;
     }
     
-    // Extraer elementos ordenadamente (orden descendente)
-    int tam_original = copia.tamano;
-    for (int i = 0; i < tam_original; i++) {
-        Operacion op = extraer_max_heap(&copia);
-        Tren* t = op.tren;
+    int i = 0, p;
+    while ((p = monticulo_operaciones_recorrido_siguiente(&recorrido)) >= 0) {
+        Tren* t = heap->datos[p]->tren;
         printf("%d. ID: %s | Destino: %s | Distancia: %d km | Compañía: %s\n",
-               i+1, t->id_tren, t->destino, t->distancia, t->compania);
+               ++i, t->id_tren, t->destino, t->distancia, t->compania);
     }
-}      
+    if (p == -2) printf("Error de memoria.\n");
+    
+    monticulo_operaciones_recorrido_liberar(&recorrido);
+}
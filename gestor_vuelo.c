@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h> // Necesario para la generación aleatoria
+#include "monticulo_dario.h"
 
 /**
  * @file aeropuerto_manager.c
@@ -48,16 +49,13 @@ typedef struct salida {
     int clave_salida;        /**< Clave de prioridad para el Heap (AAAAMMDDHHMM). */
 } Salida;
 
+MONTICULO_DEFINIR(salidas, int, Vuelo*, HEAP_ARIDAD, MONTICULO_SIN_POSICION)
+
 /**
- * @struct heap
- * @brief Estructura que implementa un Min-Heap (Montículo de Mínimos) dinámico.
- * Almacena las salidas ordenadas por la clave_salida.
+ * @brief Min-Heap (Montículo de Mínimos) dinámico de salidas, HEAP_ARIDAD-ario (monticulo_dario.h).
+ * `claves[i]` es la clave de la salida i y `datos[i]` su vuelo; -DHEAP_ARIDAD=2 da el montículo binario.
  */
-typedef struct heap {
-    Salida* elementos;       /**< Array de elementos Salida. */
-    int capacidad;           /**< Capacidad máxima actual del array. */
-    int tamano;              /**< Número actual de elementos en el Heap. */
-} Heap;
+typedef Monticulo_salidas Heap;
 
 // Declaración de funciones
 // ABB
@@ -131,13 +129,6 @@ void insertar_heap(Heap* heap, Salida nueva_salida);
  */
 Salida extraer_min_heap(Heap* heap);
 
-/**
- * @brief Restaura la propiedad de Min-Heap a partir del índice dado (operación de 'bajar').
- * @param heap Puntero al Heap.
- * @param i Índice a partir del cual se debe reestructurar el montículo.
- */
-void min_heapify(Heap* heap, int i);
-
 /**
  * @brief Muestra la planificación completa de salidas utilizando el algoritmo Heapsort.
  * La función opera sobre una copia del Heap para no alterar el orden de prioridades original.
@@ -194,8 +185,8 @@ int main() {
     srand((unsigned)time(NULL)); 
 
     // Inicialización más robusta del Heap (con gestión de errores)
-    Heap monticulo_salidas = {.elementos = (Salida*)malloc(sizeof(Salida) * MAX_NODOS), .capacidad = MAX_NODOS, .tamano = 0};
-    if (monticulo_salidas.elementos == NULL) {
+    Heap monticulo_salidas;
+    if (!monticulo_salidas_crear(&monticulo_salidas, MAX_NODOS)) {
         printf("Error fatal: No se pudo asignar memoria para el montículo.\n");
         return 1;
     }
@@ -304,8 +295,8 @@ int main() {
 
             case 7:
                 if (monticulo_salidas.tamano > 0) {
-                    Salida salida = monticulo_salidas.elementos[0];
-                    printf("Próxima salida: %s (%s a %s), Fecha: %d, Hora: %d\n", salida.vuelo->codigo_vuelo, salida.vuelo->aerolinea, salida.vuelo->destino, salida.vuelo->fecha_salida, salida.vuelo->hora_salida);
+                    Vuelo* proximo = monticulo_salidas.datos[0];
+                    printf("Próxima salida: %s (%s a %s), Fecha: %d, Hora: %d\n", proximo->codigo_vuelo, proximo->aerolinea, proximo->destino, proximo->fecha_salida, proximo->hora_salida);
                 } else {
                     printf("No hay salidas programadas.\n");
                 }
@@ -323,7 +314,7 @@ int main() {
             case 9:
                 printf("--- Salidas actuales en el Montículo (Orden no garantizado, solo estructura) ---\n");
                 for (int i = 0; i < monticulo_salidas.tamano; i++) {
-                    printf("[%d] %s (Clave: %d), Destino: %s, Aerolínea: %s\n", i, monticulo_salidas.elementos[i].vuelo->codigo_vuelo, monticulo_salidas.elementos[i].clave_salida, monticulo_salidas.elementos[i].vuelo->destino, monticulo_salidas.elementos[i].vuelo->aerolinea);
+                    printf("[%d] %s (Clave: %d), Destino: %s, Aerolínea: %s\n", i, monticulo_salidas.datos[i]->codigo_vuelo, monticulo_salidas.claves[i], monticulo_salidas.datos[i]->destino, monticulo_salidas.datos[i]->aerolinea);
                 }
                 break;
 
@@ -343,7 +334,7 @@ int main() {
 
             case 11:
                 liberar_arbol(arbol_vuelos); // Liberar ABB
-                free(monticulo_salidas.elementos); // Liberar Heap
+                monticulo_salidas_liberar(&monticulo_salidas);
                 printf("Saliendo del programa y liberando memoria...\n");
                 break;
 
@@ -387,7 +378,7 @@ Vuelo* buscar_vuelo(Vuelo* raiz, const char* codigo_vuelo) {
 
 int vuelo_en_heap(Heap* heap, const char* codigo_vuelo) {
     for (int i = 0; i < heap->tamano; i++) {
-        if (strcmp(heap->elementos[i].vuelo->codigo_vuelo, codigo_vuelo) == 0) {
+        if (strcmp(heap->datos[i]->codigo_vuelo, codigo_vuelo) == 0) {
             return 1;
         }
     }
@@ -496,31 +487,18 @@ void listar_vuelos_por_destino_o_aerolinea(Vuelo* raiz, const char* filtro, int
 void redimensionar_heap(Heap* heap) {
     if (heap->tamano < heap->capacidad) return;
 
-    heap->capacidad *= REDIMENSION_FACTOR;
-    Salida* nuevo_elementos = (Salida*)realloc(heap->elementos, sizeof(Salida) * heap->capacidad);
-
-    if (nuevo_elementos == NULL) {
+    if (!monticulo_salidas_reservar(heap, heap->capacidad * REDIMENSION_FACTOR)) {
         printf("Error crítico: Fallo de reasignación de memoria para el Heap.\n");
         exit(1);
     }
-    heap->elementos = nuevo_elementos;
     printf("(Heap redimensionado a capacidad %d)\n", heap->capacidad);
 }
 
 void insertar_heap(Heap* heap, Salida nueva_salida) {
     redimensionar_heap(heap); // Verificar y redimensionar antes de insertar
     
-    heap->tamano++;
-    int i = heap->tamano - 1;
-    heap->elementos[i] = nueva_salida;
-
     // Operación de subir (percolate up) para mantener la propiedad de Min-Heap
-    while (i != 0 && heap->elementos[(i - 1) / 2].clave_salida > heap->elementos[i].clave_salida) {
-        Salida temp = heap->elementos[i];
-        heap->elementos[i] = heap->elementos[(i - 1) / 2];
-        heap->elementos[(i - 1) / 2] = temp;
-        i = (i - 1) / 2;
-    }
+    monticulo_salidas_insertar(heap, nueva_salida.clave_salida, nueva_salida.vuelo);
 }
 
 Salida extraer_min_heap(Heap* heap) {
@@ -531,55 +509,31 @@ Salida extraer_min_heap(Heap* heap) {
         return vacia; 
     }
     
-    Salida raiz = heap->elementos[0];
-    heap->elementos[0] = heap->elementos[heap->tamano - 1];
-    heap->tamano--;
-    min_heapify(heap, 0);
+    Salida raiz;
+    raiz.vuelo = monticulo_salidas_extraer(heap, &raiz.clave_salida);
     return raiz;
 }
 
-void min_heapify(Heap* heap, int i) {
-    int izq = 2 * i + 1;
-    int der = 2 * i + 2;
-    int min = i;
-
-    if (izq < heap->tamano && heap->elementos[izq].clave_salida < heap->elementos[min].clave_salida)
-        min = izq;
-    if (der < heap->tamano && heap->elementos[der].clave_salida < heap->elementos[min].clave_salida)
-        min = der;
-        
-    if (min != i) {
-        Salida temp = heap->elementos[i];
-        heap->elementos[i] = heap->elementos[min];
-        heap->elementos[min] = temp;
-        min_heapify(heap, min);
-    }
-}
-
 void heapsort_y_mostrar(Heap* heap) {
-    if (heap->tamano == 0) {
+    if (heap->tamano <= 0) {
         printf("El montículo de salidas está vacío.\n");
         return;
     }
     
     int original_tamano = heap->tamano;
     
-    // 1. Crear una copia profunda de los elementos
-    Salida* elementos_copia = (Salida*)malloc(sizeof(Salida) * original_tamano);
-    if (elementos_copia == NULL) {
+    // 1. Crear una copia profunda de los elementos en un Heap temporal
+    Heap heap_temp;
+    if (!monticulo_salidas_crear(&heap_temp, original_tamano)) {
         printf("Error: Fallo de asignación de memoria para el Heapsort.\n");
+        monticulo_salidas_liberar(&heap_temp);
         return;
     }
-    memcpy(elementos_copia, heap->elementos, sizeof(Salida) * original_tamano);
-
-    // 2. Crear una estructura Heap temporal que apunte a la copia
-    Heap heap_temp = {
-        .elementos = elementos_copia,
-        .capacidad = original_tamano,
-        .tamano = original_tamano
-    };
+    memcpy(heap_temp.claves, heap->claves, sizeof(int) * original_tamano);
+    memcpy(heap_temp.datos, heap->datos, sizeof(Vuelo*) * original_tamano);
+    heap_temp.tamano = original_tamano;
     
-    // 3. Ordenar (Extraer el mínimo repetidamente)
+    // 2. Ordenar (Extraer el mínimo repetidamente)
     for (int i = 0; i < original_tamano; i++) {
         Salida salida = extraer_min_heap(&heap_temp);
         printf("Salida: %s, Destino: %s, Fecha: %d, Hora: %d\n",
@@ -587,8 +541,8 @@ void heapsort_y_mostrar(Heap* heap) {
                 salida.vuelo->fecha_salida, salida.vuelo->hora_salida);
     }
 
-    // 4. Liberar la memoria de la copia
-    free(elementos_copia);
+    // 3. Liberar la memoria de la copia
+    monticulo_salidas_liberar(&heap_temp);
 }
 
 
@@ -1,12 +1,42 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
 #include <time.h> // Necesario para la generación aleatoria
+#include <limits.h>
+#include "tabla_codigos.h"
+#include "arena.h"
+#include "monticulo_dario.h"
+#include "rueda_tiempo.h"
+#include "indice_atributos.h"
+#include "almacen_vuelos.h"
 
 /**
  * @file aeropuerto_manager.c
  * @brief Implementación de un sistema de gestión aeroportuaria utilizando un Árbol Binario de Búsqueda (ABB) 
  * para vuelos (acceso por código) y un Min-Heap (montículo de mínimos) para la planificación de salidas por prioridad.
+ *
+ * Por defecto el árbol de vuelos es un AVL (ABB equilibrado por alturas) con inserción, búsqueda y
+ * eliminación iterativas, de modo que cargar códigos ya ordenados no lo degenera en una lista.
+ * Con el argumento `--abb` se usa el ABB original sin equilibrar.
+ *
+ * Las búsquedas por código exacto van a una tabla hash (tabla_codigos.h) con el código empaquetado
+ * en un entero, que se mantiene sincronizada con el árbol; el árbol queda para los recorridos en orden.
+ *
+ * El montículo de salidas es d-ario (monticulo_dario.h), con las claves en un vector propio;
+ * el número de hijos por nodo se elige al compilar con -DHEAP_ARIDAD=2, 4 (por defecto) u 8.
+ * Con el argumento `--rueda` las salidas se planifican en su lugar con una rueda de tiempo
+ * jerárquica (rueda_tiempo.h: cubetas de minuto, hora y día) con inserción y despegue en O(1)
+ * amortizado; el resto del programa usa las mismas funciones del Heap sin saber cuál está activo.
+ *
+ * Los filtros por destino, aerolínea y origen usan índices secundarios (indice_atributos.h): cada
+ * valor tiene un identificador entero y una lista con sus vuelos. Un filtro cuesta lo que mide
+ * su lista, la Y de dos lo que mide la más corta de las dos y la O la suma de ambas, en lugar de
+ * recorrer todo el árbol comparando cadenas.
+ *
+ * Para tablas de toda la flota hay además un almacén columnar (almacen_vuelos.h): código
+ * empaquetado, ciudades y aerolínea en un byte cada una y la salida en un entero, 19 bytes por
+ * vuelo frente a los más de 200 de un nodo Vuelo. El menú compara ambos formatos (opción 21).
  */
 
 // Constantes
@@ -16,8 +46,44 @@
 #define MAX_CODE_LEN 10
 /** @brief Longitud máxima para cadenas de texto (origen, destino, aerolínea). */
 #define MAX_STR_LEN 50
+/** @brief Vuelos del primer bloque de la arena de nodos. */
+#define ARENA_VUELOS_BLOQUE 256
 /** @brief Factor de crecimiento para la redimensión dinámica del Heap. */
 #define REDIMENSION_FACTOR 2
+/** @brief Altura máxima de un AVL (1.44·log2(n) < 64 para cualquier n representable). */
+#define AVL_ALTURA_MAX 64
+/** @brief Modo de árbol: ABB sin equilibrar (versión original). */
+#define MODO_ABB 0
+/** @brief Modo de árbol: AVL iterativo. */
+#define MODO_AVL 1
+/** @brief Nodos máximos del ABB en el benchmark con códigos ordenados (coste cuadrático). */
+#define BENCH_LIMITE_ABB_ORDENADO 20000
+/** @brief Mayor número de salidas del benchmark de montículos (10K, 1M y 10M). */
+#define BENCH_HEAP_MAX 10000000
+/** @brief Planificador de salidas: Min-Heap d-ario (por defecto). */
+#define PLAN_MONTICULO 0
+/** @brief Planificador de salidas: rueda de tiempo jerárquica (`--rueda`). */
+#define PLAN_RUEDA 1
+/** @brief Mayor número de salidas del día simulado en el benchmark de planificadores (10K, 100K y 1M). */
+#define BENCH_DIA_MAX 1000000
+/** @brief Día simulado en el benchmark de planificadores (AAAAMMDD, mes de 31 días). */
+#define BENCH_DIA_FECHA 20251201
+/** @brief Mayor número de vuelos del benchmark del almacén columnar (10K, 100K y 1M). */
+#define BENCH_ALMACEN_MAX 1000000
+/** @brief Atributo indexado: ciudad de destino. */
+#define ATRIBUTO_DESTINO 0
+/** @brief Atributo indexado: aerolínea. */
+#define ATRIBUTO_AEROLINEA 1
+/** @brief Atributo indexado: ciudad de origen. */
+#define ATRIBUTO_ORIGEN 2
+/** @brief Número de atributos con índice secundario. */
+#define NUM_ATRIBUTOS 3
+/** @brief Filtro de un solo atributo. */
+#define FILTRO_UNICO 0
+/** @brief Filtro de dos atributos que deben cumplirse los dos (Y). */
+#define FILTRO_Y 1
+/** @brief Filtro de dos atributos del que basta con que se cumpla uno (O). */
+#define FILTRO_O 2
 
 // Definición de estructuras (ABB & Heap Original)
 // ----------------------------------------------
@@ -35,6 +101,11 @@ typedef struct vuelo {
     int hora_salida;                 /// Hora programada de salida (HHMM).
     struct vuelo* izquierdo;         /// Puntero al subárbol izquierdo (menor clave).
     struct vuelo* derecho;           /// Puntero al subárbol derecho (mayor clave).
+    int altura;                      /// Altura del subárbol (solo en modo AVL; hoja = 1).
+    int pos_heap;                    /// Posición de su salida en el Heap (-1 si no está programado).
+    NodoRueda* nodo_rueda;           /// Nodo de su salida en la rueda de tiempo (NULL si no está programado).
+    int id_atributo[NUM_ATRIBUTOS];  /// Identificador de su destino, aerolínea y origen en los índices.
+    int pos_atributo[NUM_ATRIBUTOS]; /// Posición en la lista de ocurrencias de cada uno de esos valores.
 } Vuelo;
 
 /**
@@ -43,19 +114,24 @@ typedef struct vuelo {
  */
 typedef struct salida {
     Vuelo* vuelo;            /// Puntero al nodo Vuelo asociado.
-    /** @brief Clave de prioridad para el Heap, generada como AAAAMMDDHHMM. */
-    int clave_salida;        
+    /** @brief Clave de prioridad para el Heap, generada como AAAAMMDDHHMM (no cabe en un int). */
+    long long clave_salida;  
 } Salida;
 
+/** @brief Guarda en el vuelo la posición de su salida cada vez que el montículo la mueve. */
+#define POSICION_SALIDA(vuelo, i) ((vuelo)->pos_heap = (i))
+
+MONTICULO_DEFINIR(salidas, long long, Vuelo*, HEAP_ARIDAD, POSICION_SALIDA)
+
 /**
- * @struct heap
- * @brief Estructura que implementa un Min-Heap (Montículo de Mínimos) dinámico.
+ * @brief Min-Heap (Montículo de Mínimos) dinámico de salidas, HEAP_ARIDAD-ario.
+ *
+ * `claves[i]` es la clave AAAAMMDDHHMM de la salida i y `datos[i]` su vuelo. Cada vuelo guarda en
+ * `pos_heap` la posición de su salida, y todas las operaciones que mueven elementos la mantienen
+ * al día. Así se sabe en O(1) si un vuelo está programado y se puede reprogramar o cancelar
+ * cualquier salida en O(log n). Un vuelo tiene como mucho una salida.
  */
-typedef struct heap {
-    Salida* elementos;       /// Array dinámico de elementos Salida (almacén del montículo).
-    int capacidad;           /// Capacidad máxima actual del array.
-    int tamano;              /// Número actual de elementos en el Heap.
-} Heap;
+typedef Monticulo_salidas Heap;
 
 // Declaración de funciones (ABB & Heap Original)
 // ----------------------------------------------
@@ -68,22 +144,83 @@ Vuelo* eliminar_vuelo(Vuelo* raiz, const char* codigo_vuelo, Heap* heap_salidas)
 Vuelo* encontrar_min(Vuelo* raiz);
 void recorrer_inorden(Vuelo* raiz);
 void liberar_arbol(Vuelo* raiz);
-/** @brief Comprueba si el vuelo está pendiente de despegue en el Heap. */
-int vuelo_en_heap(Heap* heap, const char* codigo_vuelo);
-void listar_vuelos_por_destino_o_aerolinea(Vuelo* raiz, const char* filtro, int tipo_filtro);
+/** @brief Comprueba en O(1) si el vuelo está pendiente de despegue en el Heap. */
+int vuelo_en_heap(const Vuelo* vuelo);
+/** @brief Lista en orden de código los vuelos que cumplen uno o dos filtros de atributo, con los índices. */
+void listar_vuelos_filtrados(int atributo_a, const char* valor_a, int operacion, int atributo_b, const char* valor_b);
+
+// Funciones del AVL (modo equilibrado)
+Vuelo* insertar_vuelo_avl(Vuelo* raiz, Vuelo* nuevo_vuelo);
+/** @brief Elimina un vuelo reenlazando el sucesor (los punteros del Heap siguen siendo válidos). */
+Vuelo* eliminar_vuelo_avl(Vuelo* raiz, const char* codigo_vuelo, Heap* heap_salidas);
+Vuelo* avl_equilibrar(Vuelo* nodo);
+int altura_arbol(Vuelo* raiz);
+/** @brief Inserta con el árbol del modo activo (ABB o AVL). */
+Vuelo* arbol_insertar(Vuelo* raiz, Vuelo* nuevo_vuelo);
+/** @brief Elimina con el árbol del modo activo (ABB o AVL). */
+Vuelo* arbol_eliminar(Vuelo* raiz, const char* codigo_vuelo, Heap* heap_salidas);
+/** @brief Busca un vuelo por código en la tabla hash (el árbol solo si el código no cabe en la clave). */
+Vuelo* localizar_vuelo(Vuelo* raiz, const char* codigo_vuelo);
+/** @brief Carga masiva: ordena un vector de vuelos y enlaza un árbol perfectamente equilibrado en O(n). */
+Vuelo* construir_arbol_vuelos(Vuelo* vuelos, int n, int* insertados);
+/** @brief Da de alta un vuelo en los índices de atributos (1 si lo consigue, 0 si falla la memoria). */
+int indexar_vuelo(Vuelo* vuelo);
+/** @brief Da de baja un vuelo de los índices de atributos. */
+void desindexar_vuelo(Vuelo* vuelo);
 
 // Funciones del Min-Heap
 void insertar_heap(Heap* heap, Salida nueva_salida);
 Salida extraer_min_heap(Heap* heap);
-void min_heapify(Heap* heap, int i);
 void heapsort_y_mostrar(Heap* heap);
+/** @brief Muestra las @p k próximas salidas en orden sin copiar ni modificar el Heap. */
+void mostrar_proximas_salidas(Heap* heap, int k);
+/** @brief Muestra las salidas en orden por páginas de @p k, pidiendo confirmación entre páginas. */
+void paginar_salidas(Heap* heap, int k);
+/** @brief Adelanta la salida de un vuelo programado (la clave solo puede disminuir). */
+int disminuir_clave_heap(Heap* heap, Vuelo* vuelo, long long nueva_clave);
+/** @brief Cambia la fecha y hora de salida de un vuelo programado, en cualquier sentido. */
+int reprogramar_salida(Heap* heap, Vuelo* vuelo, long long nueva_clave);
+/** @brief Quita del Heap la salida de un vuelo, esté donde esté. */
+int cancelar_salida(Heap* heap, Vuelo* vuelo);
+/** @brief Añade un lote de salidas y reconstruye el Heap de abajo arriba en O(n) (Floyd). */
+void insertar_heap_lote(Heap* heap, const Salida* salidas, int m);
+/** @brief Número de salidas programadas en el planificador activo. */
+int salidas_pendientes(const Heap* heap);
+/** @brief Vuelo de la próxima salida sin quitarla (NULL si no hay ninguna). */
+Vuelo* proxima_salida(Heap* heap);
+/** @brief Muestra el contenido de la rueda de tiempo, cubeta a cubeta. */
+void mostrar_rueda(const RuedaTiempo* rueda);
 
 // Funciones Auxiliares
 void redimensionar_heap(Heap* heap);
+int crear_indices_vuelos(void);
+void liberar_indices_vuelos(void);
 void generar_vuelos_automaticos(Vuelo** arbol, Heap* monticulo, int num_vuelos);
 char* generar_codigo_aleatorio(char* buffer);
 int generar_fecha_aleatoria();
 int generar_hora_aleatoria();
+void benchmark_arboles(int n);
+void benchmark_monticulos(void);
+void benchmark_planificadores(void);
+void benchmark_almacen(void);
+
+/** @brief Árbol usado por el menú: MODO_AVL (por defecto) o MODO_ABB (`--abb`). */
+int modo_arbol = MODO_AVL;
+
+/** @brief Planificador de salidas: PLAN_MONTICULO (por defecto) o PLAN_RUEDA (`--rueda`). */
+int planificador = PLAN_MONTICULO;
+
+/** @brief Rueda de tiempo de las salidas; solo se usa con PLAN_RUEDA. */
+RuedaTiempo rueda_salidas;
+
+/** @brief Índice hash de los vuelos del árbol por código; lo mantienen arbol_insertar y arbol_eliminar. */
+TablaCodigos indice_codigos;
+
+/** @brief Índices secundarios por destino, aerolínea y origen; los mantienen arbol_insertar y arbol_eliminar. */
+IndiceAtributo indices_vuelos[NUM_ATRIBUTOS];
+
+/** @brief Arena de la que salen todos los nodos Vuelo del árbol (arena.h). */
+Arena arena_vuelos = ARENA_INICIAL(sizeof(Vuelo), ARENA_VUELOS_BLOQUE);
 
 
 // ===============================================
@@ -92,15 +229,24 @@ int generar_hora_aleatoria();
 
 /**
  * @brief Función principal que implementa el menú interactivo del sistema de gestión aeroportuaria.
+ * @param argc Número de argumentos.
+ * @param argv Argumentos: `--abb` usa el ABB sin equilibrar en lugar del AVL y `--rueda`
+ *             planifica las salidas con la rueda de tiempo en lugar del Heap.
  * @return 0 si la ejecución es exitosa, 1 en caso de error de asignación de memoria inicial.
  */
-int main() {
+int main(int argc, char* argv[]) {
     Vuelo* arbol_vuelos = NULL;  /// Puntero a la raíz del Árbol de Vuelos.
     srand((unsigned)time(NULL)); /// Inicialización del generador de números aleatorios.
 
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--abb") == 0) modo_arbol = MODO_ABB;
+        if (strcmp(argv[i], "--rueda") == 0) planificador = PLAN_RUEDA;
+    }
+
     /// Inicialización del Heap dinámico.
-    Heap monticulo_salidas = {.elementos = (Salida*)malloc(sizeof(Salida) * MAX_NODOS), .capacidad = MAX_NODOS, .tamano = 0};
-    if (monticulo_salidas.elementos == NULL) {
+    Heap monticulo_salidas;
+    if (!monticulo_salidas_crear(&monticulo_salidas, MAX_NODOS) || !tabla_crear(&indice_codigos, MAX_NODOS) ||
+        !rueda_crear(&rueda_salidas) || !crear_indices_vuelos()) {
         printf("Error fatal: No se pudo asignar memoria para el montículo.\n");
         return 1;
     }
@@ -109,13 +255,14 @@ int main() {
     do {
         // --- Menú de opciones ---
         printf("\n============================================\n");
-        printf(" Sistema de Gestión Aeroportuaria (ABB & Heap)\n");
+        printf(" Sistema de Gestión Aeroportuaria (%s & %s)\n", modo_arbol == MODO_AVL ? "AVL" : "ABB",
+               planificador == PLAN_RUEDA ? "Rueda" : "Heap");
         printf("============================================\n");
         printf("1. Registrar nuevo vuelo\n");
         printf("2. Buscar vuelo por código\n");
         printf("3. Eliminar vuelo\n");
         printf("4. Listar todos los vuelos (código: inorden)\n");
-        printf("5. Listar vuelos por destino o aerolínea\n");
+        printf("5. Listar vuelos por destino, aerolínea u origen (o combinando dos filtros)\n");
         printf("6. Programar salida de un vuelo\n");
         printf("7. Consultar próxima salida\n");
         printf("8. Despegar vuelo (atender próxima salida)\n");
@@ -124,6 +271,14 @@ int main() {
         printf("--- Opciones Automáticas ---\n");
         printf("12. Generar Vuelos y Salidas Automáticas\n"); 
         printf("13. [TEÓRICO] Probar Árbol Binario Vectorial (Ver código en comentarios)\n"); 
+        printf("14. Benchmark ABB vs AVL vs tabla hash (códigos ordenados y aleatorios)\n"); 
+        printf("15. Reprogramar salida de un vuelo (retraso o adelanto)\n"); 
+        printf("16. Cancelar salida programada\n"); 
+        printf("17. Benchmark Heap binario vs 4-ario vs 8-ario (10K, 1M y 10M salidas)\n"); 
+        printf("18. Mostrar las próximas K salidas\n"); 
+        printf("19. Mostrar la planificación por páginas de K salidas\n"); 
+        printf("20. Benchmark Heap vs rueda de tiempo (un día de salidas)\n"); 
+        printf("21. Benchmark nodos Vuelo vs almacén columnar (memoria y filtros)\n"); 
         printf("11. Salir\n");
         printf("Elige una opción: ");
         
@@ -137,6 +292,7 @@ int main() {
         char codigo_vuelo[MAX_CODE_LEN];
         char destino[MAX_STR_LEN];
         char aerolinea[MAX_STR_LEN];
+        char origen[MAX_STR_LEN];
         int fecha_salida, hora_salida;
         Vuelo* vuelo;
         Salida nueva_salida;
@@ -144,7 +300,7 @@ int main() {
         
         switch(opcion) {
             case 1: // Registrar nuevo vuelo
-                vuelo = (Vuelo*)malloc(sizeof(Vuelo));
+                vuelo = (Vuelo*)arena_reservar(&arena_vuelos);
                 if (vuelo == NULL) { printf("Error: Fallo de asignación de memoria.\n"); break; }
                 printf("Ingrese código de vuelo: "); scanf("%s", vuelo->codigo_vuelo);
                 printf("Ingrese ciudad de origen: "); scanf("%s", vuelo->origen);
@@ -153,12 +309,14 @@ int main() {
                 printf("Ingrese fecha de salida (AAAAMMDD): "); scanf("%d", &vuelo->fecha_salida);
                 printf("Ingrese hora de salida (HHMM): "); scanf("%d", &vuelo->hora_salida);
                 vuelo->izquierdo = vuelo->derecho = NULL; 
-                arbol_vuelos = insertar_vuelo(arbol_vuelos, vuelo);
+                vuelo->pos_heap = -1; 
+                vuelo->nodo_rueda = NULL;
+                arbol_vuelos = arbol_insertar(arbol_vuelos, vuelo);
                 break;
 
             case 2: // Buscar vuelo
                 printf("Ingrese código de vuelo: "); scanf("%s", codigo_vuelo);
-                vuelo = buscar_vuelo(arbol_vuelos, codigo_vuelo);
+                vuelo = localizar_vuelo(arbol_vuelos, codigo_vuelo);
                 if (vuelo) {
                     printf("Vuelo encontrado: %s, Origen: %s, Destino: %s, Aerolínea: %s, Fecha: %d, Hora: %d\n", vuelo->codigo_vuelo, vuelo->origen, vuelo->destino, vuelo->aerolinea, vuelo->fecha_salida, vuelo->hora_salida);
                 } else {
@@ -168,7 +326,7 @@ int main() {
 
             case 3: // Eliminar vuelo
                 printf("Ingrese código de vuelo a eliminar: "); scanf("%s", codigo_vuelo);
-                arbol_vuelos = eliminar_vuelo(arbol_vuelos, codigo_vuelo, &monticulo_salidas);
+                arbol_vuelos = arbol_eliminar(arbol_vuelos, codigo_vuelo, &monticulo_salidas);
                 break;
 
             case 4: // Listar Inorden
@@ -177,18 +335,34 @@ int main() {
                 break;
 
             case 5: // Listar por filtro
-                printf("¿Desea buscar por destino (1) o aerolínea (2)? ");
+                printf("¿Desea buscar por destino (1), aerolínea (2), origen (3) o combinar dos filtros (4)? ");
                 int tipo_filtro;
                 if (scanf("%d", &tipo_filtro) != 1) { printf("Entrada inválida.\n"); break; }
                 
                 if (tipo_filtro == 1) {
                     printf("Ingrese destino: "); scanf("%s", destino);
                     printf("--- Vuelos a %s ---\n", destino);
-                    listar_vuelos_por_destino_o_aerolinea(arbol_vuelos, destino, 1);
+                    listar_vuelos_filtrados(ATRIBUTO_DESTINO, destino, FILTRO_UNICO, 0, NULL);
                 } else if (tipo_filtro == 2) {
                     printf("Ingrese aerolínea: "); scanf("%s", aerolinea);
                     printf("--- Vuelos de %s ---\n", aerolinea);
-                    listar_vuelos_por_destino_o_aerolinea(arbol_vuelos, aerolinea, 2);
+                    listar_vuelos_filtrados(ATRIBUTO_AEROLINEA, aerolinea, FILTRO_UNICO, 0, NULL);
+                } else if (tipo_filtro == 3) {
+                    printf("Ingrese origen: "); scanf("%s", origen);
+                    printf("--- Vuelos desde %s ---\n", origen);
+                    listar_vuelos_filtrados(ATRIBUTO_ORIGEN, origen, FILTRO_UNICO, 0, NULL);
+                } else if (tipo_filtro == 4) {
+                    int atributo_a, atributo_b, operacion;
+                    printf("Primer filtro: destino (1), aerolínea (2) u origen (3): ");
+                    if (scanf("%d", &atributo_a) != 1 || atributo_a < 1 || atributo_a > NUM_ATRIBUTOS) { printf("Opción inválida.\n"); break; }
+                    printf("Valor: "); scanf("%s", destino);
+                    printf("¿Deben cumplirse los dos (1: Y) o basta con uno (2: O)? ");
+                    if (scanf("%d", &operacion) != 1 || (operacion != FILTRO_Y && operacion != FILTRO_O)) { printf("Opción inválida.\n"); break; }
+                    printf("Segundo filtro: destino (1), aerolínea (2) u origen (3): ");
+                    if (scanf("%d", &atributo_b) != 1 || atributo_b < 1 || atributo_b > NUM_ATRIBUTOS) { printf("Opción inválida.\n"); break; }
+                    printf("Valor: "); scanf("%s", aerolinea);
+                    printf("--- Vuelos con %s %s %s ---\n", destino, operacion == FILTRO_Y ? "Y" : "O", aerolinea);
+                    listar_vuelos_filtrados(atributo_a - 1, destino, operacion, atributo_b - 1, aerolinea);
                 } else {
                     printf("Opción inválida.\n");
                 }
@@ -196,12 +370,20 @@ int main() {
 
             case 6: // Programar salida (Insertar en Heap)
                 printf("Ingrese código de vuelo a programar: "); scanf("%s", codigo_vuelo);
-                vuelo = buscar_vuelo(arbol_vuelos, codigo_vuelo);
+                vuelo = localizar_vuelo(arbol_vuelos, codigo_vuelo);
                 if (vuelo) {
                     printf("Ingrese fecha de salida (AAAAMMDD): "); scanf("%d", &fecha_salida);
                     printf("Ingrese hora de salida (HHMM): "); scanf("%d", &hora_salida);
+                    if (vuelo_en_heap(vuelo)) {
+                        /// Un vuelo solo tiene una salida: se reprograma la existente.
+                        reprogramar_salida(&monticulo_salidas, vuelo, fecha_salida * 10000LL + hora_salida);
+                        printf("El vuelo ya estaba programado: salida reprogramada.\n");
+                        break;
+                    }
                     nueva_salida.vuelo = vuelo;
-                    nueva_salida.clave_salida = fecha_salida * 10000 + hora_salida; // Clave única de prioridad
+                    nueva_salida.clave_salida = fecha_salida * 10000LL + hora_salida; // Clave única de prioridad
+                    vuelo->fecha_salida = fecha_salida;
+                    vuelo->hora_salida = hora_salida;
                     insertar_heap(&monticulo_salidas, nueva_salida);
                     printf("Salida programada correctamente.\n");
                 } else {
@@ -209,17 +391,18 @@ int main() {
                 }
                 break;
 
-            case 7: // Consultar próxima salida (Raíz del Heap)
-                if (monticulo_salidas.tamano > 0) {
-                    Salida salida = monticulo_salidas.elementos[0];
-                    printf("Próxima salida: %s (%s a %s), Fecha: %d, Hora: %d\n", salida.vuelo->codigo_vuelo, salida.vuelo->aerolinea, salida.vuelo->destino, salida.vuelo->fecha_salida, salida.vuelo->hora_salida);
+            case 7: { // Consultar próxima salida (Raíz del Heap)
+                Vuelo* proximo = proxima_salida(&monticulo_salidas);
+                if (proximo != NULL) {
+                    printf("Próxima salida: %s (%s a %s), Fecha: %d, Hora: %d\n", proximo->codigo_vuelo, proximo->aerolinea, proximo->destino, proximo->fecha_salida, proximo->hora_salida);
                 } else {
                     printf("No hay salidas programadas.\n");
                 }
                 break;
+            }
 
             case 8: { // Despegar vuelo (Extraer mínimo del Heap)
-                if (monticulo_salidas.tamano > 0) {
+                if (salidas_pendientes(&monticulo_salidas) > 0) {
                     Salida salida = extraer_min_heap(&monticulo_salidas);
                     printf("✅ Vuelo despegando: %s, %s, Destino: %s, Hora: %d\n", salida.vuelo->codigo_vuelo, salida.vuelo->aerolinea, salida.vuelo->destino, salida.vuelo->hora_salida);
                 } else {
@@ -229,9 +412,14 @@ int main() {
             }
 
             case 9: // Mostrar estructura del Heap
+                if (planificador == PLAN_RUEDA) {
+                    printf("--- Salidas actuales en la rueda de tiempo ---\n");
+                    mostrar_rueda(&rueda_salidas);
+                    break;
+                }
                 printf("--- Salidas actuales en el Montículo ---\n");
                 for (int i = 0; i < monticulo_salidas.tamano; i++) {
-                    printf("[%d] %s (Clave: %d), Destino: %s, Aerolínea: %s\n", i, monticulo_salidas.elementos[i].vuelo->codigo_vuelo, monticulo_salidas.elementos[i].clave_salida, monticulo_salidas.elementos[i].vuelo->destino, monticulo_salidas.elementos[i].vuelo->aerolinea);
+                    printf("[%d] %s (Clave: %lld), Destino: %s, Aerolínea: %s\n", i, monticulo_salidas.datos[i]->codigo_vuelo, monticulo_salidas.claves[i], monticulo_salidas.datos[i]->destino, monticulo_salidas.datos[i]->aerolinea);
                 }
                 break;
 
@@ -254,9 +442,71 @@ int main() {
                 printf("La implementación completa (estructuras y funciones) se encuentra al final de este archivo en un bloque comentado.\n");
                 break;
             }
+            case 14: { // Benchmark de profundidad ABB vs AVL
+                int n_bench;
+                printf("¿Cuántos códigos desea insertar (p. ej. 1000000)? ");
+                if (scanf("%d", &n_bench) != 1 || n_bench <= 0) {
+                    printf("Número inválido.\n");
+                    break;
+                }
+                benchmark_arboles(n_bench);
+                break;
+            }
+            case 15: // Reprogramar salida (actualización de clave con el handle pos_heap)
+                printf("Ingrese código de vuelo a reprogramar: "); scanf("%s", codigo_vuelo);
+                vuelo = localizar_vuelo(arbol_vuelos, codigo_vuelo);
+                if (vuelo == NULL || !vuelo_en_heap(vuelo)) {
+                    printf("Error: El vuelo no existe o no tiene salida programada.\n");
+                    break;
+                }
+                printf("Nueva fecha de salida (AAAAMMDD): "); scanf("%d", &fecha_salida);
+                printf("Nueva hora de salida (HHMM): "); scanf("%d", &hora_salida);
+                reprogramar_salida(&monticulo_salidas, vuelo, fecha_salida * 10000LL + hora_salida);
+                if (planificador == PLAN_RUEDA) printf("Salida de %s reprogramada.\n", vuelo->codigo_vuelo);
+                else printf("Salida de %s reprogramada (posición en el montículo: %d).\n", vuelo->codigo_vuelo, vuelo->pos_heap);
+                break;
+
+            case 16: // Cancelar una salida cualquiera
+                printf("Ingrese código de vuelo a cancelar: "); scanf("%s", codigo_vuelo);
+                vuelo = localizar_vuelo(arbol_vuelos, codigo_vuelo);
+                if (vuelo != NULL && cancelar_salida(&monticulo_salidas, vuelo)) {
+                    printf("Salida de %s cancelada.\n", vuelo->codigo_vuelo);
+                } else {
+                    printf("Error: El vuelo no existe o no tiene salida programada.\n");
+                }
+                break;
+
+            case 17: // Benchmark del montículo binario original frente a los d-arios
+                benchmark_monticulos();
+                break;
+
+            case 18: // Próximas K salidas (recorrido perezoso del Heap)
+            case 19: { // Planificación paginada con el mismo recorrido
+                int k;
+                printf("¿Cuántas salidas %s? ", opcion == 18 ? "desea ver" : "por página");
+                if (scanf("%d", &k) != 1 || k <= 0) {
+                    printf("Número inválido.\n");
+                    break;
+                }
+                if (opcion == 18) mostrar_proximas_salidas(&monticulo_salidas, k);
+                else paginar_salidas(&monticulo_salidas, k);
+                break;
+            }
+
+            case 20: // Benchmark del Heap frente a la rueda de tiempo
+                benchmark_planificadores();
+                break;
+
+            case 21: // Benchmark del almacén columnar frente a los nodos Vuelo
+                benchmark_almacen();
+                break;
+
             case 11: // Salir
-                liberar_arbol(arbol_vuelos); 
-                free(monticulo_salidas.elementos); 
+                arena_destruir(&arena_vuelos); // Todos los vuelos de golpe, sin recorrer el árbol
+                tabla_liberar(&indice_codigos);
+                monticulo_salidas_liberar(&monticulo_salidas);
+                rueda_liberar(&rueda_salidas);
+                liberar_indices_vuelos();
                 printf("Saliendo del programa y liberando memoria...\n");
                 break;
 
@@ -294,42 +544,36 @@ Vuelo* insertar_vuelo(Vuelo* raiz, Vuelo* nuevo_vuelo) {
     } else {
         /// Clave duplicada: no se inserta.
         printf("Error: El código de vuelo ya existe (%s). No insertado.\n", nuevo_vuelo->codigo_vuelo);
-        free(nuevo_vuelo); 
+        arena_liberar(&arena_vuelos, nuevo_vuelo); 
     }
     return raiz;
 }
 
 /**
- * @brief Busca un vuelo en el ABB por su código de forma eficiente.
- * @param raiz La raíz del ABB.
+ * @brief Busca un vuelo en el árbol (ABB o AVL) por su código, de forma iterativa.
+ * @param raiz La raíz del árbol.
  * @param codigo_vuelo El código del vuelo a buscar.
  * @return Puntero al nodo Vuelo si se encuentra, NULL en caso contrario.
  */
 Vuelo* buscar_vuelo(Vuelo* raiz, const char* codigo_vuelo) {
-    if (raiz == NULL) return NULL;
-    int cmp = strcmp(codigo_vuelo, raiz->codigo_vuelo);
-    
-    if (cmp == 0) return raiz; // Encontrado
-    
-    if (cmp < 0) {
-        return buscar_vuelo(raiz->izquierdo, codigo_vuelo); // Buscar a la izquierda
+    while (raiz != NULL) {
+        int cmp = strcmp(codigo_vuelo, raiz->codigo_vuelo);
+        if (cmp == 0) return raiz; // Encontrado
+        raiz = cmp < 0 ? raiz->izquierdo : raiz->derecho;
     }
-    return buscar_vuelo(raiz->derecho, codigo_vuelo); // Buscar a la derecha
+    return NULL;
 }
 
 /**
  * @brief Verifica si un vuelo específico está actualmente programado en el Heap.
- * @param heap Puntero al Heap de salidas.
- * @param codigo_vuelo El código del vuelo a verificar.
+ *
+ * Basta con mirar su posición en el montículo (o su nodo en la rueda): no se recorre el Heap.
+ *
+ * @param vuelo El vuelo a verificar.
  * @return 1 si el vuelo está en el Heap, 0 en caso contrario.
  */
-int vuelo_en_heap(Heap* heap, const char* codigo_vuelo) {
-    for (int i = 0; i < heap->tamano; i++) {
-        if (strcmp(heap->elementos[i].vuelo->codigo_vuelo, codigo_vuelo) == 0) {
-            return 1;
-        }
-    }
-    return 0;
+int vuelo_en_heap(const Vuelo* vuelo) {
+    return vuelo->pos_heap >= 0 || vuelo->nodo_rueda != NULL;
 }
 
 /**
@@ -344,12 +588,6 @@ Vuelo* eliminar_vuelo(Vuelo* raiz, const char* codigo_vuelo, Heap* heap_salidas)
         printf("Error: Vuelo %s no encontrado.\n", codigo_vuelo);
         return NULL;
     }
-    
-    // VALIDACIÓN CRÍTICA
-    if (vuelo_en_heap(heap_salidas, codigo_vuelo)) {
-        printf("Error: El vuelo %s no se puede eliminar porque está programado en una salida.\n", codigo_vuelo);
-        return raiz;
-    }
 
     int cmp = strcmp(codigo_vuelo, raiz->codigo_vuelo);
 
@@ -358,35 +596,42 @@ Vuelo* eliminar_vuelo(Vuelo* raiz, const char* codigo_vuelo, Heap* heap_salidas)
     } else if (cmp > 0) {
         raiz->derecho = eliminar_vuelo(raiz->derecho, codigo_vuelo, heap_salidas);
     } else {
+        // VALIDACIÓN CRÍTICA
+        if (vuelo_en_heap(raiz)) {
+            printf("Error: El vuelo %s no se puede eliminar porque está programado en una salida.\n", codigo_vuelo);
+            return raiz;
+        }
+
         // Nodo encontrado (Lógica de eliminación de 0, 1 o 2 hijos)
         Vuelo* temp;
         
         // Caso 1: Cero o un hijo
         if (raiz->izquierdo == NULL) {
             temp = raiz->derecho;
-            free(raiz);
+            arena_liberar(&arena_vuelos, raiz);
             printf("Vuelo %s eliminado.\n", codigo_vuelo);
             return temp;
         } else if (raiz->derecho == NULL) {
             temp = raiz->izquierdo;
-            free(raiz);
+            arena_liberar(&arena_vuelos, raiz);
             printf("Vuelo %s eliminado.\n", codigo_vuelo);
             return temp;
         }
 
-        // Caso 2: Dos hijos (Usa el sucesor inorden)
-        temp = encontrar_min(raiz->derecho);
-        
-        // Copiar TODOS los datos del sucesor
-        strcpy(raiz->codigo_vuelo, temp->codigo_vuelo);
-        strcpy(raiz->origen, temp->origen);
-        strcpy(raiz->destino, temp->destino);
-        strcpy(raiz->aerolinea, temp->aerolinea);
-        raiz->fecha_salida = temp->fecha_salida;
-        raiz->hora_salida = temp->hora_salida;
-
-        // Eliminar el sucesor
-        raiz->derecho = eliminar_vuelo(raiz->derecho, temp->codigo_vuelo, heap_salidas); 
+        // Caso 2: Dos hijos. El sucesor inorden se desengancha y ocupa el lugar del nodo.
+        // No se copian sus datos: el Heap guarda punteros a los vuelos y el sucesor
+        // puede estar programado.
+        Vuelo** enlace = &raiz->derecho;
+        while ((*enlace)->izquierdo != NULL) {
+            enlace = &(*enlace)->izquierdo;
+        }
+        temp = *enlace;
+        *enlace = temp->derecho;
+        temp->izquierdo = raiz->izquierdo;
+        temp->derecho = raiz->derecho;
+        arena_liberar(&arena_vuelos, raiz);
+        printf("Vuelo %s eliminado.\n", codigo_vuelo);
+        return temp;
     }
 
     return raiz;
@@ -417,41 +662,450 @@ void recorrer_inorden(Vuelo* raiz) {
 }
 
 /**
- * @brief Libera recursivamente toda la memoria asignada al ABB (Postorden).
+ * @brief Devuelve recursivamente a la arena todos los nodos de un subárbol (Postorden).
+ *
+ * Para liberar el árbol completo basta con arena_destruir(&arena_vuelos).
+ *
  * @param raiz La raíz del ABB.
  */
 void liberar_arbol(Vuelo* raiz) {
     if (raiz == NULL) return;
     liberar_arbol(raiz->izquierdo);
     liberar_arbol(raiz->derecho);
-    free(raiz);
+    arena_liberar(&arena_vuelos, raiz);
+}
+
+/** @brief Compara dos punteros a vuelo por código (para qsort). */
+static int comparar_punteros_vuelo(const void* a, const void* b) {
+    return strcmp((*(Vuelo* const*)a)->codigo_vuelo, (*(Vuelo* const*)b)->codigo_vuelo);
 }
 
 /**
- * @brief Muestra los vuelos que coinciden con el filtro dado (destino o aerolínea).
- * @param raiz La raíz del ABB.
- * @param filtro El destino o aerolínea a buscar.
- * @param tipo_filtro 1 para destino, 2 para aerolínea.
+ * @brief Muestra en orden de código los vuelos que cumplen uno o dos filtros de atributo.
+ *
+ * Los vuelos candidatos salen de las listas de ocurrencias de los índices, sin recorrer el árbol:
+ * - FILTRO_UNICO: la lista del valor A.
+ * - FILTRO_Y: se recorre la más corta de las dos listas y se comprueba el otro identificador.
+ * - FILTRO_O: la lista de A y los vuelos de la de B que no tienen el valor A (sin repetidos).
+ * El coste es el de las listas recorridas más ordenar el resultado: con FILTRO_Y crece con la
+ * lista más corta y no con los vuelos que cumplen los dos filtros, que pueden ser muchos menos.
+ * Un valor que ningún vuelo ha tenido no está en el diccionario y da un resultado vacío sin más.
+ *
+ * @param atributo_a Atributo del primer filtro (ATRIBUTO_DESTINO, ATRIBUTO_AEROLINEA o ATRIBUTO_ORIGEN).
+ * @param valor_a Valor buscado en el primer filtro.
+ * @param operacion FILTRO_UNICO, FILTRO_Y o FILTRO_O.
+ * @param atributo_b Atributo del segundo filtro (se ignora con FILTRO_UNICO).
+ * @param valor_b Valor buscado en el segundo filtro (se ignora con FILTRO_UNICO).
  */
-void listar_vuelos_por_destino_o_aerolinea(Vuelo* raiz, const char* filtro, int tipo_filtro) {
-    if (raiz == NULL) return;
+void listar_vuelos_filtrados(int atributo_a, const char* valor_a, int operacion, int atributo_b, const char* valor_b) {
+    static const ListaAtributo vacia = {NULL, 0, 0};
+    int id_a = indice_atributo_id(&indices_vuelos[atributo_a], valor_a);
+    const ListaAtributo* lista_a = indice_atributo_lista(&indices_vuelos[atributo_a], id_a);
+    if (lista_a == NULL) lista_a = &vacia;
+
+    int id_b = -1;
+    const ListaAtributo* lista_b = &vacia;
+    if (operacion != FILTRO_UNICO) {
+        id_b = indice_atributo_id(&indices_vuelos[atributo_b], valor_b);
+        lista_b = indice_atributo_lista(&indices_vuelos[atributo_b], id_b);
+        if (lista_b == NULL) lista_b = &vacia;
+    }
 
-    listar_vuelos_por_destino_o_aerolinea(raiz->izquierdo, filtro, tipo_filtro);
+    int maximo = operacion == FILTRO_O ? lista_a->tamano + lista_b->tamano : lista_a->tamano;
+    Vuelo** resultado = (Vuelo**)malloc(sizeof(Vuelo*) * (maximo > 0 ? maximo : 1));
+    if (resultado == NULL) {
+        printf("Error: Fallo de asignación de memoria para el filtro.\n");
+        return;
+    }
 
-    bool coincide = false;
-    if (tipo_filtro == 1 && strcmp(raiz->destino, filtro) == 0) {
-        coincide = true;
-    } else if (tipo_filtro == 2 && strcmp(raiz->aerolinea, filtro) == 0) {
-        coincide = true;
+    int n = 0;
+    if (operacion == FILTRO_UNICO) {
+        for (int i = 0; i < lista_a->tamano; i++) resultado[n++] = (Vuelo*)lista_a->elementos[i];
+    } else if (operacion == FILTRO_Y) {
+        /// Se recorre la lista más corta y se mira el identificador del otro atributo en cada vuelo.
+        const ListaAtributo* corta = lista_a;
+        int atributo_otro = atributo_b, id_otro = id_b;
+        if (lista_b->tamano < lista_a->tamano) {
+            corta = lista_b;
+            atributo_otro = atributo_a;
+            id_otro = id_a;
+        }
+        for (int i = 0; i < corta->tamano; i++) {
+            Vuelo* v = (Vuelo*)corta->elementos[i];
+            if (v->id_atributo[atributo_otro] == id_otro) resultado[n++] = v;
+        }
+    } else {
+        for (int i = 0; i < lista_a->tamano; i++) resultado[n++] = (Vuelo*)lista_a->elementos[i];
+        /// Los de B que también cumplen A ya están en el resultado.
+        for (int i = 0; i < lista_b->tamano; i++) {
+            Vuelo* v = (Vuelo*)lista_b->elementos[i];
+            if (v->id_atributo[atributo_a] != id_a) resultado[n++] = v;
+        }
     }
 
-    if (coincide) {
+    /// Las listas no guardan orden: se ordena solo el resultado para listar como el recorrido inorden.
+    qsort(resultado, (size_t)n, sizeof(Vuelo*), comparar_punteros_vuelo);
+    for (int i = 0; i < n; i++) {
+        Vuelo* v = resultado[i];
         printf("Vuelo: %s, Origen: %s, Destino: %s, Aerolínea: %s, Fecha: %d, Hora: %d\n",
-                raiz->codigo_vuelo, raiz->origen, raiz->destino, raiz->aerolinea,
-                raiz->fecha_salida, raiz->hora_salida);
+                v->codigo_vuelo, v->origen, v->destino, v->aerolinea,
+                v->fecha_salida, v->hora_salida);
+    }
+    printf("(%d vuelos)\n", n);
+    free(resultado);
+}
+
+// ===============================================
+// === IMPLEMENTACIÓN DEL ÁRBOL AVL (MODO EQUILIBRADO) ===
+// ===============================================
+
+/** @brief Altura de un subárbol AVL (0 si está vacío). */
+static int avl_altura(Vuelo* nodo) {
+    return nodo ? nodo->altura : 0;
+}
+
+/** @brief Recalcula la altura de un nodo a partir de la de sus hijos. */
+static void avl_actualizar(Vuelo* nodo) {
+    int hi = avl_altura(nodo->izquierdo), hd = avl_altura(nodo->derecho);
+    nodo->altura = 1 + (hi > hd ? hi : hd);
+}
+
+/** @brief Rotación simple a la derecha; devuelve la nueva raíz del subárbol. */
+static Vuelo* avl_rotar_derecha(Vuelo* nodo) {
+    Vuelo* hijo = nodo->izquierdo;
+    nodo->izquierdo = hijo->derecho;
+    hijo->derecho = nodo;
+    avl_actualizar(nodo);
+    avl_actualizar(hijo);
+    return hijo;
+}
+
+/** @brief Rotación simple a la izquierda; devuelve la nueva raíz del subárbol. */
+static Vuelo* avl_rotar_izquierda(Vuelo* nodo) {
+    Vuelo* hijo = nodo->derecho;
+    nodo->derecho = hijo->izquierdo;
+    hijo->izquierdo = nodo;
+    avl_actualizar(nodo);
+    avl_actualizar(hijo);
+    return hijo;
+}
+
+/**
+ * @brief Actualiza la altura de un nodo y aplica la rotación simple o doble que necesite.
+ * @param nodo Raíz de un subárbol cuyos hijos ya son AVL.
+ * @return La nueva raíz del subárbol equilibrado.
+ */
+Vuelo* avl_equilibrar(Vuelo* nodo) {
+    avl_actualizar(nodo);
+    int balance = avl_altura(nodo->izquierdo) - avl_altura(nodo->derecho);
+
+    if (balance > 1) {
+        if (avl_altura(nodo->izquierdo->izquierdo) < avl_altura(nodo->izquierdo->derecho))
+            nodo->izquierdo = avl_rotar_izquierda(nodo->izquierdo); // Caso izquierda-derecha
+        return avl_rotar_derecha(nodo);
+    }
+    if (balance < -1) {
+        if (avl_altura(nodo->derecho->derecho) < avl_altura(nodo->derecho->izquierdo))
+            nodo->derecho = avl_rotar_derecha(nodo->derecho); // Caso derecha-izquierda
+        return avl_rotar_izquierda(nodo);
     }
+    return nodo;
+}
+
+/**
+ * @brief Inserta un vuelo en el AVL sin recursión.
+ *
+ * Se baja guardando en una pila los enlaces recorridos y después se sube
+ * reequilibrando hasta el primer nodo cuya altura no cambia.
+ *
+ * @param raiz La raíz del AVL.
+ * @param nuevo_vuelo El nodo Vuelo a insertar (se libera si el código ya existe).
+ * @return La nueva raíz del AVL.
+ */
+Vuelo* insertar_vuelo_avl(Vuelo* raiz, Vuelo* nuevo_vuelo) {
+    Vuelo** camino[AVL_ALTURA_MAX];
+    int n = 0;
+    Vuelo** enlace = &raiz;
+
+    while (*enlace != NULL) {
+        int cmp = strcmp(nuevo_vuelo->codigo_vuelo, (*enlace)->codigo_vuelo);
+        if (cmp == 0) {
+            printf("Error: El código de vuelo ya existe (%s). No insertado.\n", nuevo_vuelo->codigo_vuelo);
+            arena_liberar(&arena_vuelos, nuevo_vuelo);
+            return raiz;
+        }
+        camino[n++] = enlace;
+        enlace = cmp < 0 ? &(*enlace)->izquierdo : &(*enlace)->derecho;
+    }
+
+    nuevo_vuelo->izquierdo = nuevo_vuelo->derecho = NULL;
+    nuevo_vuelo->altura = 1;
+    *enlace = nuevo_vuelo;
 
-    listar_vuelos_por_destino_o_aerolinea(raiz->derecho, filtro, tipo_filtro);
+    /// Tras una inserción basta con una rotación: se para cuando la altura no cambia.
+    while (n > 0) {
+        Vuelo** e = camino[--n];
+        int altura_previa = (*e)->altura;
+        *e = avl_equilibrar(*e);
+        if ((*e)->altura == altura_previa) break;
+    }
+    return raiz;
+}
+
+/**
+ * @brief Elimina un vuelo del AVL sin recursión.
+ *
+ * Con dos hijos, el sucesor inorden se desengancha y ocupa el lugar del nodo
+ * eliminado (se reenlaza, no se copian los datos), así que ningún otro vuelo
+ * cambia de dirección y las salidas del Heap siguen apuntando a su vuelo.
+ *
+ * @param raiz La raíz del AVL.
+ * @param codigo_vuelo El código del vuelo a eliminar.
+ * @param heap_salidas Puntero al Heap para la validación.
+ * @return La nueva raíz del AVL.
+ */
+Vuelo* eliminar_vuelo_avl(Vuelo* raiz, const char* codigo_vuelo, Heap* heap_salidas) {
+    (void)heap_salidas; // La validación usa la posición guardada en el propio vuelo
+
+    Vuelo** camino[AVL_ALTURA_MAX];
+    int n = 0;
+    Vuelo** enlace = &raiz;
+    int cmp;
+
+    while (*enlace != NULL && (cmp = strcmp(codigo_vuelo, (*enlace)->codigo_vuelo)) != 0) {
+        camino[n++] = enlace;
+        enlace = cmp < 0 ? &(*enlace)->izquierdo : &(*enlace)->derecho;
+    }
+    if (*enlace == NULL) {
+        printf("Error: Vuelo %s no encontrado.\n", codigo_vuelo);
+        return raiz;
+    }
+
+    Vuelo* borrar = *enlace;
+    if (vuelo_en_heap(borrar)) {
+        printf("Error: El vuelo %s no se puede eliminar porque está programado en una salida.\n", codigo_vuelo);
+        return raiz;
+    }
+    if (borrar->izquierdo == NULL || borrar->derecho == NULL) {
+        // Cero o un hijo: el hijo sube
+        *enlace = borrar->izquierdo ? borrar->izquierdo : borrar->derecho;
+    } else {
+        // Dos hijos: el sucesor (mínimo del subárbol derecho) ocupa su lugar
+        int pos = n;
+        camino[n++] = enlace;
+        Vuelo** e = &borrar->derecho;
+        while ((*e)->izquierdo != NULL) {
+            camino[n++] = e;
+            e = &(*e)->izquierdo;
+        }
+        Vuelo* sucesor = *e;
+        *e = sucesor->derecho;
+        sucesor->izquierdo = borrar->izquierdo;
+        sucesor->derecho = borrar->derecho;
+        *enlace = sucesor;
+        // El enlace guardado dentro del nodo eliminado pasa a ser el del sucesor
+        if (n > pos + 1) camino[pos + 1] = &sucesor->derecho;
+    }
+
+    printf("Vuelo %s eliminado.\n", codigo_vuelo);
+    arena_liberar(&arena_vuelos, borrar);
+
+    /// Tras una eliminación puede hacer falta rotar en todos los niveles.
+    while (n > 0) {
+        Vuelo** e = camino[--n];
+        *e = avl_equilibrar(*e);
+    }
+    return raiz;
+}
+
+/**
+ * @brief Calcula la altura (profundidad máxima) de un árbol, sea ABB o AVL.
+ * @param raiz La raíz del árbol.
+ * @return Número de niveles (0 si está vacío).
+ */
+int altura_arbol(Vuelo* raiz) {
+    if (raiz == NULL) return 0;
+    int hi = altura_arbol(raiz->izquierdo), hd = altura_arbol(raiz->derecho);
+    return 1 + (hi > hd ? hi : hd);
+}
+
+/** @brief Cadena de un atributo indexado de un vuelo. */
+static const char* atributo_vuelo(const Vuelo* vuelo, int atributo) {
+    if (atributo == ATRIBUTO_DESTINO) return vuelo->destino;
+    if (atributo == ATRIBUTO_AEROLINEA) return vuelo->aerolinea;
+    return vuelo->origen;
+}
+
+/**
+ * @brief Da de alta un vuelo en el índice de cada atributo.
+ *
+ * Codifica su destino, aerolínea y origen (registrando los valores nuevos en el diccionario)
+ * y lo añade a la lista de ocurrencias de cada uno, guardando identificador y posición en el vuelo.
+ *
+ * @param vuelo Vuelo ya rellenado.
+ * @return 1 si se indexa, 0 si falla la memoria (el vuelo no queda en ningún índice).
+ */
+int indexar_vuelo(Vuelo* vuelo) {
+    for (int a = 0; a < NUM_ATRIBUTOS; a++) {
+        int id = indice_atributo_codificar(&indices_vuelos[a], atributo_vuelo(vuelo, a));
+        int pos = id < 0 ? -1 : indice_atributo_agregar(&indices_vuelos[a], id, vuelo);
+        if (pos < 0) {
+            while (--a >= 0) {
+                /// Se deshacen los atributos ya indexados: el vuelo era el último de cada lista.
+                indice_atributo_quitar(&indices_vuelos[a], vuelo->id_atributo[a], vuelo->pos_atributo[a]);
+            }
+            return 0;
+        }
+        vuelo->id_atributo[a] = id;
+        vuelo->pos_atributo[a] = pos;
+    }
+    return 1;
+}
+
+/**
+ * @brief Quita un vuelo de la lista de ocurrencias de cada atributo en O(1).
+ *
+ * El último vuelo de cada lista ocupa su hueco y se le actualiza la posición.
+ *
+ * @param vuelo Vuelo indexado con indexar_vuelo.
+ */
+void desindexar_vuelo(Vuelo* vuelo) {
+    for (int a = 0; a < NUM_ATRIBUTOS; a++) {
+        Vuelo* movido = (Vuelo*)indice_atributo_quitar(&indices_vuelos[a], vuelo->id_atributo[a], vuelo->pos_atributo[a]);
+        if (movido != NULL) movido->pos_atributo[a] = vuelo->pos_atributo[a];
+    }
+}
+
+/**
+ * @brief Inserta un vuelo con el árbol seleccionado en `modo_arbol`, en el índice hash y en los
+ *        índices de atributos.
+ *
+ * Los códigos repetidos se detectan en la tabla (o en el árbol, si el código no cabe en la
+ * clave) antes de tocar los índices, así que la inserción en el árbol ya no puede fallar.
+ *
+ * @param raiz La raíz del árbol.
+ * @param nuevo_vuelo El nodo Vuelo a insertar.
+ * @return La nueva raíz del árbol.
+ */
+Vuelo* arbol_insertar(Vuelo* raiz, Vuelo* nuevo_vuelo) {
+    uint64_t clave;
+    if (tabla_codigo_clave(nuevo_vuelo->codigo_vuelo, &clave)) {
+        int r = tabla_insertar(&indice_codigos, clave, nuevo_vuelo);
+        if (r <= 0) {
+            if (r == 0) printf("Error: El código de vuelo ya existe (%s). No insertado.\n", nuevo_vuelo->codigo_vuelo);
+            else printf("Error: Fallo de asignación de memoria para el índice de códigos.\n");
+            arena_liberar(&arena_vuelos, nuevo_vuelo);
+            return raiz;
+        }
+    } else if (buscar_vuelo(raiz, nuevo_vuelo->codigo_vuelo) != NULL) {
+        printf("Error: El código de vuelo ya existe (%s). No insertado.\n", nuevo_vuelo->codigo_vuelo);
+        arena_liberar(&arena_vuelos, nuevo_vuelo);
+        return raiz;
+    }
+    if (!indexar_vuelo(nuevo_vuelo)) {
+        printf("Error: Fallo de asignación de memoria para los índices de atributos.\n");
+        if (tabla_codigo_clave(nuevo_vuelo->codigo_vuelo, &clave)) tabla_eliminar(&indice_codigos, clave);
+        arena_liberar(&arena_vuelos, nuevo_vuelo);
+        return raiz;
+    }
+    if (modo_arbol == MODO_AVL) return insertar_vuelo_avl(raiz, nuevo_vuelo);
+    return insertar_vuelo(raiz, nuevo_vuelo);
+}
+
+/**
+ * @brief Elimina un vuelo con el árbol seleccionado en `modo_arbol`, del índice hash y de los
+ *        índices de atributos.
+ * @param raiz La raíz del árbol.
+ * @param codigo_vuelo El código del vuelo a eliminar.
+ * @param heap_salidas Puntero al Heap para la validación.
+ * @return La nueva raíz del árbol.
+ */
+Vuelo* arbol_eliminar(Vuelo* raiz, const char* codigo_vuelo, Heap* heap_salidas) {
+    uint64_t clave;
+    Vuelo* vuelo = localizar_vuelo(raiz, codigo_vuelo);
+    /// Solo se quita de los índices si el árbol lo va a eliminar (no programado).
+    if (vuelo != NULL && !vuelo_en_heap(vuelo)) {
+        if (tabla_codigo_clave(codigo_vuelo, &clave)) tabla_eliminar(&indice_codigos, clave);
+        desindexar_vuelo(vuelo);
+    }
+    if (modo_arbol == MODO_AVL) return eliminar_vuelo_avl(raiz, codigo_vuelo, heap_salidas);
+    return eliminar_vuelo(raiz, codigo_vuelo, heap_salidas);
+}
+
+/**
+ * @brief Busca un vuelo por su código exacto.
+ *
+ * Los códigos que caben en la clave de 64 bits se resuelven en la tabla hash con
+ * una comparación de enteros; los más largos, que la tabla no guarda, en el árbol.
+ *
+ * @param raiz La raíz del árbol.
+ * @param codigo_vuelo El código del vuelo a buscar.
+ * @return Puntero al nodo Vuelo si se encuentra, NULL en caso contrario.
+ */
+Vuelo* localizar_vuelo(Vuelo* raiz, const char* codigo_vuelo) {
+    uint64_t clave;
+    if (tabla_codigo_clave(codigo_vuelo, &clave)) return (Vuelo*)tabla_buscar(&indice_codigos, clave);
+    return buscar_vuelo(raiz, codigo_vuelo);
+}
+
+/** @brief Compara dos vuelos por código (para qsort). */
+static int comparar_vuelos_codigo(const void* a, const void* b) {
+    return strcmp(((const Vuelo*)a)->codigo_vuelo, ((const Vuelo*)b)->codigo_vuelo);
+}
+
+/**
+ * @brief Enlaza los vuelos ordenados de [ini, fin) como un árbol perfectamente equilibrado.
+ *
+ * La raíz es el elemento central y cada mitad forma su subárbol; cada nodo se visita una
+ * vez y la altura queda calculada, así que el resultado también es un AVL válido.
+ */
+static Vuelo* enlazar_equilibrado(Vuelo* v, int ini, int fin) {
+    if (ini >= fin) return NULL;
+    int medio = ini + (fin - ini) / 2;
+    Vuelo* raiz = &v[medio];
+    raiz->izquierdo = enlazar_equilibrado(v, ini, medio);
+    raiz->derecho = enlazar_equilibrado(v, medio + 1, fin);
+    avl_actualizar(raiz);
+    return raiz;
+}
+
+/**
+ * @brief Construye el árbol de vuelos de una vez a partir de un vector (carga masiva del día).
+ *
+ * Ordena el vector por código, descarta los códigos repetidos (se queda con el primero y mueve
+ * los únicos al principio), los da de alta en el índice hash y en los de atributos y enlaza un árbol perfectamente
+ * equilibrado en O(n). Los nodos son los del propio vector, que puede venir de una sola
+ * reserva (arena_reservar_bloque).
+ *
+ * @param vuelos Vector de vuelos sin enlazar y sin programar (pos_heap = -1).
+ * @param n Número de vuelos.
+ * @param insertados Número de vuelos únicos, que quedan en vuelos[0..insertados).
+ * @return La raíz del nuevo árbol.
+ */
+Vuelo* construir_arbol_vuelos(Vuelo* vuelos, int n, int* insertados) {
+    qsort(vuelos, (size_t)n, sizeof(Vuelo), comparar_vuelos_codigo);
+
+    int unicos = 0;
+    for (int i = 0; i < n; i++) {
+        if (unicos > 0 && strcmp(vuelos[i].codigo_vuelo, vuelos[unicos - 1].codigo_vuelo) == 0) continue;
+        if (i != unicos) vuelos[unicos] = vuelos[i];
+
+        uint64_t clave;
+        if (tabla_codigo_clave(vuelos[unicos].codigo_vuelo, &clave) &&
+            tabla_insertar(&indice_codigos, clave, &vuelos[unicos]) < 0) {
+            printf("Error: Fallo de asignación de memoria para el índice de códigos.\n");
+            continue; // Sin índice no se enlaza: su hueco se trata como un repetido
+        }
+        if (!indexar_vuelo(&vuelos[unicos])) {
+            printf("Error: Fallo de asignación de memoria para los índices de atributos.\n");
+            if (tabla_codigo_clave(vuelos[unicos].codigo_vuelo, &clave)) tabla_eliminar(&indice_codigos, clave);
+            continue;
+        }
+        unicos++;
+    }
+
+    *insertados = unicos;
+    return enlazar_equilibrado(vuelos, 0, unicos);
 }
 
 // ===============================================
@@ -465,36 +1119,35 @@ void listar_vuelos_por_destino_o_aerolinea(Vuelo* raiz, const char* filtro, int
 void redimensionar_heap(Heap* heap) {
     if (heap->tamano < heap->capacidad) return;
 
-    heap->capacidad *= REDIMENSION_FACTOR;
-    Salida* nuevo_elementos = (Salida*)realloc(heap->elementos, sizeof(Salida) * heap->capacidad);
-
-    if (nuevo_elementos == NULL) {
+    if (!monticulo_salidas_reservar(heap, heap->capacidad * REDIMENSION_FACTOR)) {
         fprintf(stderr, "Error crítico: Fallo de reasignación de memoria para el Heap.\n");
         exit(1);
     }
-    heap->elementos = nuevo_elementos;
     printf("(Heap redimensionado a capacidad %d)\n", heap->capacidad);
 }
 
 /**
  * @brief Inserta una nueva salida en el Min-Heap, manteniendo la propiedad de montículo.
+ *
+ * Con PLAN_RUEDA la salida se cuelga de su cubeta en la rueda de tiempo en O(1).
+ *
  * @param heap Puntero al Heap.
  * @param nueva_salida La estructura Salida a insertar.
  */
 void insertar_heap(Heap* heap, Salida nueva_salida) {
-    redimensionar_heap(heap); 
-    
-    heap->tamano++;
-    int i = heap->tamano - 1;
-    heap->elementos[i] = nueva_salida;
+    if (planificador == PLAN_RUEDA) {
+        nueva_salida.vuelo->nodo_rueda = rueda_insertar(&rueda_salidas, nueva_salida.clave_salida, nueva_salida.vuelo);
+        if (nueva_salida.vuelo->nodo_rueda == NULL) {
+            fprintf(stderr, "Error crítico: Fallo de asignación de memoria para la rueda de tiempo.\n");
+            exit(1);
+        }
+        return;
+    }
+
+    redimensionar_heap(heap);
 
     /// Operación de subir (percolate up) para restaurar la propiedad de Heap.
-    while (i != 0 && heap->elementos[(i - 1) / 2].clave_salida > heap->elementos[i].clave_salida) {
-        Salida temp = heap->elementos[i];
-        heap->elementos[i] = heap->elementos[(i - 1) / 2];
-        heap->elementos[(i - 1) / 2] = temp;
-        i = (i - 1) / 2;
-    }
+    monticulo_salidas_insertar(heap, nueva_salida.clave_salida, nueva_salida.vuelo);
 }
 
 /**
@@ -503,76 +1156,346 @@ void insertar_heap(Heap* heap, Salida nueva_salida) {
  * @return La estructura Salida extraída.
  */
 Salida extraer_min_heap(Heap* heap) {
-    if (heap->tamano <= 0) {
+    if (salidas_pendientes(heap) <= 0) {
         fprintf(stderr, "Error: Intento de extraer de un montículo vacío.\n");
         Salida vacia = {NULL, 0};
-        return vacia; 
+        return vacia;
     }
-    
-    Salida raiz = heap->elementos[0];
-    heap->elementos[0] = heap->elementos[heap->tamano - 1];
-    heap->tamano--;
-    min_heapify(heap, 0);
+
+    Salida raiz;
+    if (planificador == PLAN_RUEDA) {
+        raiz.vuelo = (Vuelo*)rueda_extraer(&rueda_salidas, &raiz.clave_salida);
+        if (raiz.vuelo == NULL) {
+            fprintf(stderr, "Error crítico: Fallo de asignación de memoria para la rueda de tiempo.\n");
+            exit(1);
+        }
+        raiz.vuelo->nodo_rueda = NULL;
+        return raiz;
+    }
+    raiz.vuelo = monticulo_salidas_extraer(heap, &raiz.clave_salida);
     return raiz;
 }
 
 /**
- * @brief Restaura la propiedad de Min-Heap a partir del índice dado (operación de 'bajar' o sift-down).
+ * @brief Adelanta la salida de un vuelo programado (operación decrease-key).
  * @param heap Puntero al Heap.
- * @param i Índice a partir del cual se debe reestructurar el montículo.
+ * @param vuelo Vuelo cuya salida se adelanta.
+ * @param nueva_clave Nueva clave AAAAMMDDHHMM, menor o igual que la actual.
+ * @return 1 si se actualiza, 0 si el vuelo no está programado o la clave no disminuye.
  */
-void min_heapify(Heap* heap, int i) {
-    int izq = 2 * i + 1;
-    int der = 2 * i + 2;
-    int min = i;
+int disminuir_clave_heap(Heap* heap, Vuelo* vuelo, long long nueva_clave) {
+    if (planificador == PLAN_RUEDA) {
+        if (vuelo->nodo_rueda == NULL || nueva_clave > vuelo->nodo_rueda->clave) return 0;
+        return reprogramar_salida(heap, vuelo, nueva_clave);
+    }
 
-    if (izq < heap->tamano && heap->elementos[izq].clave_salida < heap->elementos[min].clave_salida)
-        min = izq;
-    if (der < heap->tamano && heap->elementos[der].clave_salida < heap->elementos[min].clave_salida)
-        min = der;
-        
-    if (min != i) {
-        Salida temp = heap->elementos[i];
-        heap->elementos[i] = heap->elementos[min];
-        heap->elementos[min] = temp;
-        min_heapify(heap, min);
+    int i = vuelo->pos_heap;
+    if (i < 0 || nueva_clave > heap->claves[i]) return 0;
+
+    vuelo->fecha_salida = (int)(nueva_clave / 10000);
+    vuelo->hora_salida = (int)(nueva_clave % 10000);
+    monticulo_salidas_cambiar_clave(heap, i, nueva_clave);
+    return 1;
+}
+
+/**
+ * @brief Cambia la salida de un vuelo programado a una nueva fecha y hora (retraso o adelanto).
+ * @param heap Puntero al Heap.
+ * @param vuelo Vuelo cuya salida se reprograma.
+ * @param nueva_clave Nueva clave AAAAMMDDHHMM.
+ * @return 1 si se actualiza, 0 si el vuelo no está programado.
+ */
+int reprogramar_salida(Heap* heap, Vuelo* vuelo, long long nueva_clave) {
+    if (planificador == PLAN_RUEDA) {
+        if (vuelo->nodo_rueda == NULL) return 0;
+
+        /// En la rueda la salida no sube ni baja: se descuelga y se cuelga en su nueva cubeta.
+        rueda_quitar(&rueda_salidas, vuelo->nodo_rueda);
+        vuelo->nodo_rueda = NULL;
+        vuelo->fecha_salida = (int)(nueva_clave / 10000);
+        vuelo->hora_salida = (int)(nueva_clave % 10000);
+        Salida salida = {vuelo, nueva_clave};
+        insertar_heap(heap, salida);
+        return 1;
+    }
+
+    int i = vuelo->pos_heap;
+    if (i < 0) return 0;
+
+    /// Adelanto: la salida sube; retraso: baja en el montículo.
+    vuelo->fecha_salida = (int)(nueva_clave / 10000);
+    vuelo->hora_salida = (int)(nueva_clave % 10000);
+    monticulo_salidas_cambiar_clave(heap, i, nueva_clave);
+    return 1;
+}
+
+/**
+ * @brief Quita del Heap la salida de un vuelo, esté en la posición que esté.
+ *
+ * La última salida ocupa su hueco y se sube o se baja según su clave.
+ *
+ * @param heap Puntero al Heap.
+ * @param vuelo Vuelo cuya salida se cancela.
+ * @return 1 si se cancela, 0 si el vuelo no estaba programado.
+ */
+int cancelar_salida(Heap* heap, Vuelo* vuelo) {
+    if (planificador == PLAN_RUEDA) {
+        if (vuelo->nodo_rueda == NULL) return 0;
+        rueda_quitar(&rueda_salidas, vuelo->nodo_rueda);
+        vuelo->nodo_rueda = NULL;
+        return 1;
+    }
+
+    int i = vuelo->pos_heap;
+    if (i < 0) return 0;
+
+    monticulo_salidas_quitar(heap, i);
+    return 1;
+}
+
+/**
+ * @brief Añade @p m salidas al Heap de una vez.
+ *
+ * Las salidas se copian al final del array y el montículo se reconstruye de abajo arriba
+ * (algoritmo de Floyd): se hunde cada nodo interno desde el último hasta la raíz, lo que
+ * cuesta O(n) en total frente a las m subidas de O(log n) de insertar_heap.
+ *
+ * Con PLAN_RUEDA no hay nada que reconstruir: cada salida va a su cubeta en O(1).
+ *
+ * @param heap Puntero al Heap.
+ * @param salidas Salidas a añadir (sus vuelos no deben estar programados).
+ * @param m Número de salidas.
+ */
+void insertar_heap_lote(Heap* heap, const Salida* salidas, int m) {
+    if (m <= 0) return;
+
+    if (planificador == PLAN_RUEDA) {
+        for (int i = 0; i < m; i++) insertar_heap(heap, salidas[i]);
+        return;
+    }
+
+    if (heap->tamano + m > heap->capacidad) {
+        int capacidad = heap->capacidad * REDIMENSION_FACTOR;
+        if (capacidad < heap->tamano + m) capacidad = heap->tamano + m;
+        if (!monticulo_salidas_reservar(heap, capacidad)) {
+            fprintf(stderr, "Error crítico: Fallo de reasignación de memoria para el Heap.\n");
+            exit(1);
+        }
+        printf("(Heap redimensionado a capacidad %d)\n", heap->capacidad);
+    }
+
+    for (int i = 0; i < m; i++) {
+        heap->claves[heap->tamano + i] = salidas[i].clave_salida;
+        heap->datos[heap->tamano + i] = salidas[i].vuelo;
+    }
+    heap->tamano += m;
+
+    monticulo_salidas_construir(heap);
+}
+
+/**
+ * @brief Número de salidas programadas en el planificador activo.
+ * @param heap Puntero al Heap (no se usa con PLAN_RUEDA).
+ */
+int salidas_pendientes(const Heap* heap) {
+    return planificador == PLAN_RUEDA ? rueda_salidas.tamano : heap->tamano;
+}
+
+/**
+ * @brief Vuelo de la próxima salida, sin quitarla.
+ *
+ * En la rueda la consulta puede avanzar el cursor hasta la primera cubeta ocupada.
+ *
+ * @param heap Puntero al Heap.
+ * @return El vuelo, o NULL si no hay salidas programadas.
+ */
+Vuelo* proxima_salida(Heap* heap) {
+    if (planificador == PLAN_RUEDA) {
+        NodoRueda* nodo = rueda_minimo(&rueda_salidas);
+        return nodo != NULL ? (Vuelo*)nodo->dato : NULL;
+    }
+    return heap->tamano > 0 ? heap->datos[0] : NULL;
+}
+
+/**
+ * @brief Muestra una salida de la rueda de tiempo con el sitio que ocupa.
+ * @param sitio Nivel de la rueda (minuto, hora, día) o montículo (atrasada, lejana).
+ * @param indice Cubeta del nivel o posición en el montículo.
+ * @param nodo Nodo de la salida.
+ */
+static void mostrar_nodo_rueda(const char* sitio, int indice, const NodoRueda* nodo) {
+    const Vuelo* vuelo = (const Vuelo*)nodo->dato;
+    printf("[%s %d] %s (Clave: %lld), Destino: %s, Aerolínea: %s\n", sitio, indice,
+           vuelo->codigo_vuelo, nodo->clave, vuelo->destino, vuelo->aerolinea);
+}
+
+/**
+ * @brief Muestra las salidas de un nivel de la rueda, cubeta a cubeta.
+ * @param sitio Nombre del nivel.
+ * @param cubetas Cubetas del nivel.
+ * @param n Número de cubetas.
+ */
+static void mostrar_nivel_rueda(const char* sitio, const CubetaRueda* cubetas, int n) {
+    for (int b = 0; b < n; b++) {
+        for (int i = 0; i < cubetas[b].tamano; i++) mostrar_nodo_rueda(sitio, b, cubetas[b].nodos[i]);
+    }
+}
+
+/**
+ * @brief Muestra las salidas de la rueda de tiempo cubeta a cubeta, como la opción 9 muestra el Heap.
+ * @param rueda Rueda de tiempo.
+ */
+void mostrar_rueda(const RuedaTiempo* rueda) {
+    for (int i = 0; i < rueda->atrasados.tamano; i++) mostrar_nodo_rueda("atrasada", i, rueda->atrasados.datos[i]);
+    mostrar_nivel_rueda("minuto", rueda->minutos, RUEDA_MINUTOS);
+    mostrar_nivel_rueda("hora", rueda->horas, RUEDA_HORAS);
+    mostrar_nivel_rueda("día", rueda->dias, RUEDA_DIAS);
+    for (int i = 0; i < rueda->lejanos.tamano; i++) mostrar_nodo_rueda("lejana", i, rueda->lejanos.datos[i]);
+}
+
+/**
+ * @brief Recorrido en orden de las salidas del planificador activo.
+ */
+typedef struct {
+    RecorridoMonticulo_salidas monticulo;  /// Recorrido del Heap (PLAN_MONTICULO).
+    RecorridoRueda rueda;                  /// Recorrido de la rueda (PLAN_RUEDA).
+} RecorridoSalidas;
+
+/**
+ * @brief Empieza un recorrido en orden del planificador activo.
+ * @return 1 si se inicia, 0 si no hay memoria.
+ */
+static int recorrido_salidas_iniciar(RecorridoSalidas* recorrido, const Heap* heap) {
+    if (planificador == PLAN_RUEDA) return rueda_recorrido_iniciar(&recorrido->rueda, &rueda_salidas);
+    return monticulo_salidas_recorrido_iniciar(&recorrido->monticulo, heap);
+}
+
+/**
+ * @brief Siguiente salida del recorrido.
+ * @param recorrido Recorrido ya iniciado.
+ * @param vuelo Recibe el vuelo de la salida.
+ * @return 1 si hay salida, 0 si se ha terminado, -1 si no hay memoria.
+ */
+static int recorrido_salidas_siguiente(RecorridoSalidas* recorrido, Vuelo** vuelo) {
+    if (planificador == PLAN_RUEDA) {
+        NodoRueda* nodo;
+        int r = rueda_recorrido_siguiente(&recorrido->rueda, &nodo);
+        if (r == 1) *vuelo = (Vuelo*)nodo->dato;
+        return r;
+    }
+
+    int p = monticulo_salidas_recorrido_siguiente(&recorrido->monticulo);
+    if (p == -2) return -1;
+    if (p < 0) return 0;
+    *vuelo = recorrido->monticulo.m->datos[p];
+    return 1;
+}
+
+/** @brief Libera la memoria del recorrido. */
+static void recorrido_salidas_liberar(RecorridoSalidas* recorrido) {
+    if (planificador == PLAN_RUEDA) rueda_recorrido_liberar(&recorrido->rueda);
+    else monticulo_salidas_recorrido_liberar(&recorrido->monticulo);
+}
+
+/**
+ * @brief Muestra una salida de la planificación.
+ * @param vuelo Vuelo de la salida.
+ */
+static void mostrar_salida(const Vuelo* vuelo) {
+    printf("Salida: %s, Destino: %s, Fecha: %d, Hora: %d\n",
+            vuelo->codigo_vuelo, vuelo->destino, vuelo->fecha_salida, vuelo->hora_salida);
+}
+
+/**
+ * @brief Muestra hasta @p k salidas más de un recorrido en orden del Heap.
+ * @param recorrido Recorrido ya iniciado.
+ * @param k Número máximo de salidas a mostrar.
+ * @return Salidas mostradas, o -1 si falta memoria para el recorrido.
+ */
+static int mostrar_siguientes(RecorridoSalidas* recorrido, int k) {
+    int mostradas = 0;
+    while (mostradas < k) {
+        Vuelo* vuelo;
+        int r = recorrido_salidas_siguiente(recorrido, &vuelo);
+        if (r < 0) {
+            printf("Error: Fallo de asignación de memoria para el recorrido del montículo.\n");
+            return -1;
+        }
+        if (r == 0) break;
+        mostrar_salida(vuelo);
+        mostradas++;
     }
+    return mostradas;
 }
 
 /**
- * @brief Muestra la planificación completa de salidas utilizando el algoritmo Heapsort.
- * Opera sobre una copia del Heap para no alterar el orden original.
+ * @brief Muestra la planificación completa de salidas en orden de hora.
+ *
+ * Ya no hace un Heapsort sobre una copia del Heap: recorre el montículo en orden con la
+ * frontera de monticulo_dario.h, sin copiarlo ni moverlo (las posiciones de los vuelos no cambian).
+ *
  * @param heap Puntero al Heap de salidas.
  */
 void heapsort_y_mostrar(Heap* heap) {
-    if (heap->tamano == 0) {
+    if (salidas_pendientes(heap) == 0) {
         printf("El montículo de salidas está vacío.\n");
         return;
     }
-    
-    int original_tamano = heap->tamano;
-    
-    Salida* elementos_copia = (Salida*)malloc(sizeof(Salida) * original_tamano);
-    if (elementos_copia == NULL) {
-        printf("Error: Fallo de asignación de memoria para el Heapsort.\n");
+    mostrar_proximas_salidas(heap, salidas_pendientes(heap));
+}
+
+/**
+ * @brief Muestra las @p k próximas salidas en orden, en O(k log k).
+ *
+ * Solo se visitan las posiciones del montículo que pueden ser las siguientes: la raíz y
+ * los hijos de las que ya se han mostrado. Con PLAN_RUEDA se recorren las cubetas en orden
+ * y solo se ordenan las de hora y día a las que se llega.
+ *
+ * @param heap Puntero al Heap de salidas.
+ * @param k Número de salidas a mostrar.
+ */
+void mostrar_proximas_salidas(Heap* heap, int k) {
+    RecorridoSalidas recorrido;
+    if (!recorrido_salidas_iniciar(&recorrido, heap)) {
+        printf("Error: Fallo de asignación de memoria para el recorrido del montículo.\n");
         return;
     }
-    memcpy(elementos_copia, heap->elementos, sizeof(Salida) * original_tamano);
+    if (mostrar_siguientes(&recorrido, k) == 0) printf("No hay salidas programadas.\n");
+    recorrido_salidas_liberar(&recorrido);
+}
 
-    Heap heap_temp = {
-        .elementos = elementos_copia,
-        .capacidad = original_tamano,
-        .tamano = original_tamano
-    };
-    
-    for (int i = 0; i < original_tamano; i++) {
-        Salida salida = extraer_min_heap(&heap_temp);
-        printf("Salida: %s, Destino: %s, Fecha: %d, Hora: %d\n",
-                salida.vuelo->codigo_vuelo, salida.vuelo->destino,
-                salida.vuelo->fecha_salida, salida.vuelo->hora_salida);
+/**
+ * @brief Muestra la planificación por páginas de @p k salidas.
+ *
+ * El cursor es el propio recorrido: cada página continúa donde acabó la anterior, sin
+ * volver a empezar desde la primera salida.
+ *
+ * @param heap Puntero al Heap de salidas.
+ * @param k Salidas por página.
+ */
+void paginar_salidas(Heap* heap, int k) {
+    RecorridoSalidas recorrido;
+    if (!recorrido_salidas_iniciar(&recorrido, heap)) {
+        printf("Error: Fallo de asignación de memoria para el recorrido del montículo.\n");
+        return;
     }
 
-    free(elementos_copia);
+    int total = 0;
+    for (int pagina = 1; ; pagina++) {
+        printf("--- Página %d ---\n", pagina);
+        int mostradas = mostrar_siguientes(&recorrido, k);
+        if (mostradas <= 0) {
+            if (mostradas == 0) printf("No hay más salidas programadas.\n");
+            break;
+        }
+        total += mostradas;
+        if (total == salidas_pendientes(heap)) break;
+
+        char respuesta;
+        printf("¿Siguiente página? (s/n): ");
+        if (scanf(" %c", &respuesta) != 1 || (respuesta != 's' && respuesta != 'S')) break;
+    }
+    recorrido_salidas_liberar(&recorrido);
 }
 
 
@@ -621,59 +1544,615 @@ const char* DESTINOS[] = {"Madrid", "Barcelona", "Paris", "Londres", "Roma", "Nu
 const int NUM_AERO = sizeof(AEROLINEAS) / sizeof(AEROLINEAS[0]);
 const int NUM_DEST = sizeof(DESTINOS) / sizeof(DESTINOS[0]);
 
+/**
+ * @brief Crea los índices de atributos con el vocabulario conocido: las ciudades de DESTINOS
+ *        para origen y destino y AEROLINEAS para la aerolínea.
+ * @return 1 si se crean, 0 si falla la memoria.
+ */
+int crear_indices_vuelos(void) {
+    if (!indice_atributo_crear(&indices_vuelos[ATRIBUTO_DESTINO], DESTINOS, NUM_DEST)) return 0;
+    if (!indice_atributo_crear(&indices_vuelos[ATRIBUTO_AEROLINEA], AEROLINEAS, NUM_AERO) ||
+        !indice_atributo_crear(&indices_vuelos[ATRIBUTO_ORIGEN], DESTINOS, NUM_DEST)) {
+        liberar_indices_vuelos();
+        return 0;
+    }
+    return 1;
+}
+
+/** @brief Libera los índices de atributos (no los vuelos). */
+void liberar_indices_vuelos(void) {
+    for (int a = 0; a < NUM_ATRIBUTOS; a++) indice_atributo_liberar(&indices_vuelos[a]);
+}
+
+/**
+ * @brief Rellena un vuelo con ruta, aerolínea y salida aleatorias (el código ya debe estar puesto).
+ * @param vuelo El vuelo a rellenar; queda sin enlazar y sin programar.
+ */
+static void rellenar_vuelo_aleatorio(Vuelo* vuelo) {
+    strcpy(vuelo->origen, DESTINOS[rand() % NUM_DEST]);
+    
+    do {
+        strcpy(vuelo->destino, DESTINOS[rand() % NUM_DEST]);
+    } while (strcmp(vuelo->origen, vuelo->destino) == 0);
+
+    strcpy(vuelo->aerolinea, AEROLINEAS[rand() % NUM_AERO]);
+    
+    vuelo->fecha_salida = generar_fecha_aleatoria();
+    vuelo->hora_salida = generar_hora_aleatoria();
+    vuelo->izquierdo = vuelo->derecho = NULL;
+    vuelo->altura = 1;
+    vuelo->pos_heap = -1;
+    vuelo->nodo_rueda = NULL;
+}
+
+/**
+ * @brief Salida de un vuelo con la fecha y hora guardadas en él.
+ */
+static Salida salida_de_vuelo(Vuelo* vuelo) {
+    Salida salida;
+    salida.vuelo = vuelo;
+    salida.clave_salida = vuelo->fecha_salida * 10000LL + vuelo->hora_salida;
+    return salida;
+}
+
 /**
  * @brief Genera e inserta automáticamente N vuelos con datos aleatorios en el ABB y programa sus salidas en el Heap.
+ *
+ * Si el árbol está vacío (carga inicial) los vuelos se crean en un solo bloque de la arena y el
+ * árbol se construye de una vez con construir_arbol_vuelos; los códigos repetidos del bloque se
+ * reponen después con inserciones normales. Las salidas entran al Heap todas juntas con
+ * insertar_heap_lote.
+ *
  * @param arbol Puntero al puntero de la raíz del ABB.
  * @param monticulo Puntero al Heap de salidas.
  * @param num_vuelos Número de vuelos a generar.
  */
 void generar_vuelos_automaticos(Vuelo** arbol, Heap* monticulo, int num_vuelos) {
     printf("Iniciando generación de %d vuelos automáticos...\n", num_vuelos);
+    if (num_vuelos <= 0) return;
+
+    Salida* salidas = (Salida*)malloc(sizeof(Salida) * num_vuelos);
+    if (salidas == NULL) {
+        printf("Error: Fallo de asignación de memoria durante la generación automática.\n");
+        return;
+    }
     
     int vuelos_insertados = 0;
     int intentos = 0;
+
+    /// Carga masiva: una reserva, una ordenación y un árbol perfectamente equilibrado.
+    Vuelo* bloque = *arbol == NULL ? (Vuelo*)arena_reservar_bloque(&arena_vuelos, num_vuelos) : NULL;
+    if (bloque != NULL) {
+        for (int i = 0; i < num_vuelos; i++) {
+            generar_codigo_aleatorio(bloque[i].codigo_vuelo);
+            rellenar_vuelo_aleatorio(&bloque[i]);
+        }
+        intentos = num_vuelos;
+
+        *arbol = construir_arbol_vuelos(bloque, num_vuelos, &vuelos_insertados);
+        for (int i = vuelos_insertados; i < num_vuelos; i++) {
+            arena_liberar(&arena_vuelos, &bloque[i]); // Huecos de los códigos repetidos
+        }
+        for (int i = 0; i < vuelos_insertados; i++) {
+            salidas[i] = salida_de_vuelo(&bloque[i]);
+        }
+    }
     
     while (vuelos_insertados < num_vuelos && intentos < num_vuelos * 5) {
-        Vuelo* vuelo = (Vuelo*)malloc(sizeof(Vuelo));
+        char codigo[MAX_CODE_LEN];
+        generar_codigo_aleatorio(codigo);
+        intentos++;
+
+        /// Código repetido: se descarta antes de reservar memoria.
+        if (localizar_vuelo(*arbol, codigo) != NULL) continue;
+
+        Vuelo* vuelo = (Vuelo*)arena_reservar(&arena_vuelos);
         if (vuelo == NULL) { 
             printf("Error: Fallo de asignación de memoria durante la generación automática.\n");
             break;
         }
 
-        generar_codigo_aleatorio(vuelo->codigo_vuelo);
-        strcpy(vuelo->origen, DESTINOS[rand() % NUM_DEST]);
-        
-        do {
-            strcpy(vuelo->destino, DESTINOS[rand() % NUM_DEST]);
-        } while (strcmp(vuelo->origen, vuelo->destino) == 0);
+        strcpy(vuelo->codigo_vuelo, codigo);
+        rellenar_vuelo_aleatorio(vuelo);
 
-        strcpy(vuelo->aerolinea, AEROLINEAS[rand() % NUM_AERO]);
-        
-        vuelo->fecha_salida = 0; 
-        vuelo->hora_salida = 0;
-        vuelo->izquierdo = vuelo->derecho = NULL;
+        *arbol = arbol_insertar(*arbol, vuelo);
+        if (localizar_vuelo(*arbol, codigo) != vuelo) continue; // No insertado (sin memoria para el índice)
 
-        Vuelo* arbol_previo = *arbol;
-        *arbol = insertar_vuelo(*arbol, vuelo);
-        
-        if (*arbol != arbol_previo || buscar_vuelo(*arbol, vuelo->codigo_vuelo) == vuelo) {
-            
-            Salida nueva_salida;
-            nueva_salida.vuelo = vuelo;
-            nueva_salida.clave_salida = generar_fecha_aleatoria() * 10000 + generar_hora_aleatoria();
-            
-            vuelo->fecha_salida = nueva_salida.clave_salida / 10000;
-            vuelo->hora_salida = nueva_salida.clave_salida % 10000;
-            
-            insertar_heap(monticulo, nueva_salida);
-            vuelos_insertados++;
-        }
-        intentos++;
+        salidas[vuelos_insertados++] = salida_de_vuelo(vuelo);
     }
 
+    /// Todas las salidas de una vez: O(n) en lugar de n inserciones de O(log n).
+    insertar_heap_lote(monticulo, salidas, vuelos_insertados);
+    free(salidas);
+
     printf("Se generaron y programaron %d vuelos exitosamente.\n", vuelos_insertados);
 }
 
+/**
+ * @brief Escribe el código de vuelo número @p i de una secuencia creciente (AA000000, AA000001, ...).
+ * @param buffer Buffer de al menos MAX_CODE_LEN caracteres.
+ * @param i Posición del código en la secuencia.
+ */
+static void codigo_benchmark(char* buffer, int i) {
+    int grupo = i / 1000000;
+    snprintf(buffer, MAX_CODE_LEN, "%c%c%06d", 'A' + grupo / 26 % 26, 'A' + grupo % 26, i % 1000000);
+}
+
+/**
+ * @brief Inserta y busca @p n códigos en un árbol y muestra su altura y los tiempos.
+ * @param nodos Vector con los vuelos a insertar (ya con su código).
+ * @param n Número de vuelos.
+ * @param modo MODO_ABB o MODO_AVL.
+ * @param orden Texto del orden de inserción para la tabla.
+ */
+static void benchmark_un_arbol(Vuelo* nodos, int n, int modo, const char* orden) {
+    Vuelo* raiz = NULL;
+
+    /// Se insertan directamente en el árbol: estos nodos no pasan al índice del menú.
+    clock_t t0 = clock();
+    for (int i = 0; i < n; i++) {
+        nodos[i].izquierdo = nodos[i].derecho = NULL;
+        raiz = modo == MODO_AVL ? insertar_vuelo_avl(raiz, &nodos[i]) : insertar_vuelo(raiz, &nodos[i]);
+    }
+    double t_insercion = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    int encontrados = 0;
+    for (int i = 0; i < n; i++) {
+        encontrados += buscar_vuelo(raiz, nodos[i].codigo_vuelo) != NULL;
+    }
+    double t_busqueda = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    printf("%-10s | %-4s | %9d | %8d | %12.3f | %12.3f\n", orden, modo == MODO_AVL ? "AVL" : "ABB",
+           encontrados, altura_arbol(raiz), t_insercion, t_busqueda);
+    // Los nodos son del vector: no se liberan uno a uno
+}
+
+/**
+ * @brief Inserta y busca @p n códigos en una tabla hash propia y muestra los tiempos.
+ * @param nodos Vector con los vuelos (ya con su código).
+ * @param n Número de vuelos.
+ * @param orden Texto del orden de inserción para la tabla.
+ */
+static void benchmark_tabla_hash(Vuelo* nodos, int n, const char* orden) {
+    TablaCodigos tabla;
+    if (!tabla_crear(&tabla, MAX_NODOS)) {
+        printf("Error: Fallo de asignación de memoria para el benchmark.\n");
+        return;
+    }
+
+    clock_t t0 = clock();
+    for (int i = 0; i < n; i++) {
+        uint64_t clave;
+        if (tabla_codigo_clave(nodos[i].codigo_vuelo, &clave)) tabla_insertar(&tabla, clave, &nodos[i]);
+    }
+    double t_insercion = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    int encontrados = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t clave;
+        encontrados += tabla_codigo_clave(nodos[i].codigo_vuelo, &clave) && tabla_buscar(&tabla, clave) != NULL;
+    }
+    double t_busqueda = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    printf("%-10s | %-4s | %9d | %8s | %12.3f | %12.3f\n", orden, "Hash", encontrados, "-", t_insercion, t_busqueda);
+    tabla_liberar(&tabla);
+}
+
+/**
+ * @brief Compara la altura y el tiempo del ABB y del AVL al insertar @p n códigos
+ *        ordenados y en orden aleatorio, junto a los tiempos de la tabla hash.
+ *
+ * Con códigos ordenados el ABB degenera en una lista y cada inserción cuesta O(n),
+ * así que en ese caso se limita a BENCH_LIMITE_ABB_ORDENADO nodos.
+ *
+ * @param n Número de códigos.
+ */
+void benchmark_arboles(int n) {
+    Vuelo* nodos = (Vuelo*)calloc((size_t)n, sizeof(Vuelo));
+    if (nodos == NULL) {
+        printf("Error: Fallo de asignación de memoria para el benchmark.\n");
+        return;
+    }
+
+    printf("%-10s | %-4s | %9s | %8s | %12s | %12s\n", "Orden", "Árbol", "Nodos", "Altura", "Inserción(s)", "Búsqueda(s)");
+    printf("------------------------------------------------------------------------\n");
+
+    // 1. Códigos en orden creciente
+    for (int i = 0; i < n; i++) codigo_benchmark(nodos[i].codigo_vuelo, i);
+    benchmark_un_arbol(nodos, n, MODO_AVL, "ordenado");
+    benchmark_un_arbol(nodos, n < BENCH_LIMITE_ABB_ORDENADO ? n : BENCH_LIMITE_ABB_ORDENADO, MODO_ABB, "ordenado");
+    benchmark_tabla_hash(nodos, n, "ordenado");
+
+    // 2. Los mismos códigos barajados (Fisher-Yates)
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)(((long long)rand() * ((long long)RAND_MAX + 1) + rand()) % (i + 1));
+        char tmp[MAX_CODE_LEN];
+        strcpy(tmp, nodos[i].codigo_vuelo);
+        strcpy(nodos[i].codigo_vuelo, nodos[j].codigo_vuelo);
+        strcpy(nodos[j].codigo_vuelo, tmp);
+    }
+    benchmark_un_arbol(nodos, n, MODO_AVL, "aleatorio");
+    benchmark_un_arbol(nodos, n, MODO_ABB, "aleatorio");
+    benchmark_tabla_hash(nodos, n, "aleatorio");
+
+    if (n > BENCH_LIMITE_ABB_ORDENADO)
+        printf("(ABB con códigos ordenados limitado a %d nodos: altura = nodos, coste cuadrático)\n", BENCH_LIMITE_ABB_ORDENADO);
+    free(nodos);
+}
+
+/// Montículos del benchmark: sin vuelos detrás, así que no guardan posiciones.
+MONTICULO_DEFINIR(bench2, long long, Vuelo*, 2, MONTICULO_SIN_POSICION)
+MONTICULO_DEFINIR(bench4, long long, Vuelo*, 4, MONTICULO_SIN_POSICION)
+MONTICULO_DEFINIR(bench8, long long, Vuelo*, 8, MONTICULO_SIN_POSICION)
+
+/**
+ * @brief Baja recursiva del montículo binario original (vector de Salida), como referencia.
+ * @param v Vector de salidas.
+ * @param n Número de salidas.
+ * @param i Índice a bajar.
+ */
+static void bench_binario_heapify(Salida* v, int n, int i) {
+    int izq = 2 * i + 1;
+    int der = 2 * i + 2;
+    int min = i;
+
+    if (izq < n && v[izq].clave_salida < v[min].clave_salida) min = izq;
+    if (der < n && v[der].clave_salida < v[min].clave_salida) min = der;
+
+    if (min != i) {
+        Salida temp = v[i];
+        v[i] = v[min];
+        v[min] = temp;
+        bench_binario_heapify(v, n, min);
+    }
+}
+
+/**
+ * @brief Inserta y extrae @p n claves con el montículo binario original y muestra los tiempos.
+ * @param claves Claves de salida a programar, en el orden de llegada.
+ * @param n Número de claves.
+ */
+static void benchmark_binario_original(const long long* claves, int n) {
+    Salida* v = (Salida*)malloc(sizeof(Salida) * (size_t)n);
+    if (v == NULL) {
+        printf("Error: Fallo de asignación de memoria para el benchmark.\n");
+        return;
+    }
+
+    clock_t t0 = clock();
+    for (int i = 0; i < n; i++) {
+        int j = i;
+        v[j].vuelo = NULL;
+        v[j].clave_salida = claves[i];
+        while (j != 0 && v[(j - 1) / 2].clave_salida > v[j].clave_salida) {
+            Salida temp = v[j];
+            v[j] = v[(j - 1) / 2];
+            v[(j - 1) / 2] = temp;
+            j = (j - 1) / 2;
+        }
+    }
+    double t_insercion = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    int desordenadas = 0;
+    long long anterior = 0;
+    for (int tam = n; tam > 0; tam--) {
+        long long clave = v[0].clave_salida;
+        desordenadas += clave < anterior;
+        anterior = clave;
+        v[0] = v[tam - 1];
+        bench_binario_heapify(v, tam - 1, 0);
+    }
+    double t_extraccion = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    printf("%9d | %-18s | %12.3f | %13.3f | %s\n", n, "binario (original)", t_insercion, t_extraccion,
+           desordenadas == 0 ? "ok" : "ERROR");
+    free(v);
+}
+
+/**
+ * @brief Genera `benchmark_monticulo_S`: la misma carga que benchmark_binario_original
+ *        sobre un Monticulo_S de monticulo_dario.h.
+ */
+#define BENCH_MONTICULO_DEFINIR(S)                                                          \
+static void benchmark_monticulo_##S(const long long* claves, int n, const char* nombre) {  \
+    Monticulo_##S m;                                                                        \
+    if (!monticulo_##S##_crear(&m, n)) {                                                    \
+        printf("Error: Fallo de asignación de memoria para el benchmark.\n");              \
+        monticulo_##S##_liberar(&m);                                                        \
+        return;                                                                             \
+    }                                                                                       \
+                                                                                            \
+    clock_t t0 = clock();                                                                   \
+    for (int i = 0; i < n; i++) monticulo_##S##_insertar(&m, claves[i], NULL);              \
+    double t_insercion = (double)(clock() - t0) / CLOCKS_PER_SEC;                           \
+                                                                                            \
+    t0 = clock();                                                                           \
+    int desordenadas = 0;                                                                   \
+    long long anterior = 0, clave;                                                          \
+    while (m.tamano > 0) {                                                                  \
+        monticulo_##S##_extraer(&m, &clave);                                                \
+        desordenadas += clave < anterior;                                                   \
+        anterior = clave;                                                                   \
+    }                                                                                       \
+    double t_extraccion = (double)(clock() - t0) / CLOCKS_PER_SEC;                          \
+                                                                                            \
+    printf("%9d | %-18s | %12.3f | %13.3f | %s\n", n, nombre, t_insercion, t_extraccion,   \
+           desordenadas == 0 ? "ok" : "ERROR");                                             \
+    monticulo_##S##_liberar(&m);                                                            \
+}
+
+BENCH_MONTICULO_DEFINIR(bench2)
+BENCH_MONTICULO_DEFINIR(bench4)
+BENCH_MONTICULO_DEFINIR(bench8)
+
+/**
+ * @brief Compara el montículo binario original (vector de Salida, bajada recursiva) con los
+ *        montículos de monticulo_dario.h de 2, 4 y 8 hijos, con 10K, 1M y 10M salidas.
+ *
+ * Cada montículo programa las mismas claves AAAAMMDDHHMM aleatorias y luego las despacha
+ * todas; la última columna comprueba que salen en orden.
+ */
+void benchmark_monticulos(void) {
+    long long* claves = (long long*)malloc(sizeof(long long) * BENCH_HEAP_MAX);
+    if (claves == NULL) {
+        printf("Error: Fallo de asignación de memoria para el benchmark.\n");
+        return;
+    }
+    for (int i = 0; i < BENCH_HEAP_MAX; i++) {
+        claves[i] = generar_fecha_aleatoria() * 10000LL + generar_hora_aleatoria();
+    }
+
+    printf("%9s | %-18s | %12s | %13s | %s\n", "Salidas", "Montículo", "Inserción(s)", "Extracción(s)", "Orden");
+    printf("----------------------------------------------------------------------\n");
+    const int tamanos[] = {10000, 1000000, BENCH_HEAP_MAX};
+    for (int t = 0; t < 3; t++) {
+        int n = tamanos[t];
+        benchmark_binario_original(claves, n);
+        benchmark_monticulo_bench2(claves, n, "2-ario (claves)");
+        benchmark_monticulo_bench4(claves, n, "4-ario (claves)");
+        benchmark_monticulo_bench8(claves, n, "8-ario (claves)");
+    }
+    free(claves);
+}
+
+/**
+ * @brief Salida del día simulado: cuándo se programa y cuándo despega.
+ */
+typedef struct {
+    int minuto_programacion;  /// Minuto del día simulado en que se programa (0-1439).
+    long long clave_salida;   /// Clave AAAAMMDDHHMM de la salida.
+} EventoDia;
+
+/** @brief Clave AAAAMMDDHHMM del minuto @p minuto del día @p dia (0 = BENCH_DIA_FECHA). */
+static long long clave_dia_benchmark(int dia, int minuto) {
+    return (BENCH_DIA_FECHA + dia) * 10000LL + (minuto / 60) * 100 + minuto % 60;
+}
+
+/**
+ * @brief Reproduce el día con el Heap o con la rueda y muestra el tiempo.
+ *
+ * Cada minuto se programan las salidas de ese minuto y despegan todas las que ya han llegado
+ * a su hora; al cerrar el día despegan las que quedan (las de días siguientes). Los dos
+ * planificadores trabajan como en el menú: el Heap mantiene `pos_heap` de cada vuelo y la
+ * rueda deja en `nodo_rueda` el nodo de su salida.
+ *
+ * @param eventos Salidas ordenadas por minuto de programación.
+ * @param inicio Las salidas del minuto t son eventos[inicio[t]] .. eventos[inicio[t + 1] - 1]
+ *               (el minuto 1440 es el cierre del día y no programa ninguna).
+ * @param vuelos Un vuelo por salida, sin programar.
+ * @param n Número de salidas.
+ * @param rueda 1 para la rueda de tiempo, 0 para el Heap.
+ * @return Resumen del orden de despegue (igual en los dos planificadores si coinciden).
+ */
+static unsigned long long benchmark_replay_dia(const EventoDia* eventos, const int* inicio, Vuelo* vuelos,
+                                               int n, int rueda) {
+    Heap m;
+    RuedaTiempo r;
+    if (!(rueda ? rueda_crear(&r) : monticulo_salidas_crear(&m, MAX_NODOS))) {
+        printf("Error: Fallo de asignación de memoria para el benchmark.\n");
+        if (rueda) rueda_liberar(&r);
+        else monticulo_salidas_liberar(&m);
+        return 0;
+    }
+
+    unsigned long long huella = 0;
+    int pendientes_max = 0, sin_memoria = 0;
+    long long clave;
+    clock_t t0 = clock();
+    for (int t = 0; t <= 1440; t++) {
+        for (int i = inicio[t]; i < inicio[t + 1]; i++) {
+            if (rueda) {
+                vuelos[i].nodo_rueda = rueda_insertar(&r, eventos[i].clave_salida, &vuelos[i]);
+                sin_memoria |= vuelos[i].nodo_rueda == NULL;
+            } else if (m.tamano == m.capacidad && !monticulo_salidas_reservar(&m, m.capacidad * REDIMENSION_FACTOR)) {
+                sin_memoria = 1;
+            } else {
+                monticulo_salidas_insertar(&m, eventos[i].clave_salida, &vuelos[i]);
+            }
+        }
+        int pendientes = rueda ? r.tamano : m.tamano;
+        if (pendientes > pendientes_max) pendientes_max = pendientes;
+
+        /// Despegan las salidas hasta este minuto (al cerrar el día, todas).
+        long long limite = t < 1440 ? clave_dia_benchmark(0, t) : LLONG_MAX;
+        for (;;) {
+            if (rueda) {
+                NodoRueda* nodo = t < 1440 ? rueda_vencida(&r, limite) : rueda_minimo(&r);
+                if (nodo == NULL) break;
+                Vuelo* vuelo = (Vuelo*)nodo->dato;
+                clave = nodo->clave;
+                rueda_quitar(&r, nodo);
+                vuelo->nodo_rueda = NULL;
+            } else {
+                if (m.tamano == 0 || m.claves[0] > limite) break;
+                monticulo_salidas_extraer(&m, &clave);
+            }
+            huella = huella * 1000003ULL + (unsigned long long)clave;
+        }
+    }
+    double t_total = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    printf("%9d | %-16s | %9.3f | %15d%s\n", n, rueda ? "rueda de tiempo" : "Heap d-ario", t_total,
+           pendientes_max, sin_memoria ? " | SIN MEMORIA" : "");
+    if (rueda) rueda_liberar(&r);
+    else monticulo_salidas_liberar(&m);
+    return huella;
+}
+
+/**
+ * @brief Reproduce un día de salidas (10K, 100K y 1M) con el Heap d-ario y con la rueda de tiempo.
+ *
+ * Las salidas del día se reparten uniformemente entre las 00:00 y las 23:59 y casi todas se
+ * programan entre 0 y 6 horas antes; un 5% se programa para uno de los 30 días siguientes y un
+ * 1% se registra tarde, hasta media hora después de su hora (la rueda las guarda aparte).
+ * Los dos planificadores reciben las mismas operaciones y deben despachar las salidas en el
+ * mismo orden.
+ */
+void benchmark_planificadores(void) {
+    EventoDia* generados = (EventoDia*)malloc(sizeof(EventoDia) * BENCH_DIA_MAX);
+    EventoDia* eventos = (EventoDia*)malloc(sizeof(EventoDia) * BENCH_DIA_MAX);
+    Vuelo* vuelos = (Vuelo*)calloc(BENCH_DIA_MAX, sizeof(Vuelo));
+    if (generados == NULL || eventos == NULL || vuelos == NULL) {
+        printf("Error: Fallo de asignación de memoria para el benchmark.\n");
+        free(generados);
+        free(eventos);
+        free(vuelos);
+        return;
+    }
+
+    printf("%9s | %-16s | %9s | %15s\n", "Salidas", "Planificador", "Tiempo(s)", "Máx. pendientes");
+    printf("-------------------------------------------------------------\n");
+    const int tamanos[] = {10000, 100000, BENCH_DIA_MAX};
+    for (int t = 0; t < 3; t++) {
+        int n = tamanos[t];
+        int inicio[1442] = {0};
+        for (int i = 0; i < n; i++) {
+            int minuto = rand() % 1440;
+            int tipo = rand() % 100;
+            EventoDia* e = &generados[i];
+            if (tipo < 1) { // Registrada tarde
+                e->minuto_programacion = minuto + 1 + rand() % 30;
+                if (e->minuto_programacion > 1439) e->minuto_programacion = 1439;
+                e->clave_salida = clave_dia_benchmark(0, minuto);
+            } else if (tipo < 6) { // Con días de antelación
+                e->minuto_programacion = rand() % 1440;
+                e->clave_salida = clave_dia_benchmark(1 + rand() % 30, minuto);
+            } else { // Hasta 6 horas antes
+                int antelacion = rand() % 361;
+                e->minuto_programacion = minuto > antelacion ? minuto - antelacion : 0;
+                e->clave_salida = clave_dia_benchmark(0, minuto);
+            }
+            inicio[e->minuto_programacion + 1]++;
+        }
+
+        /// Ordenación por cuentas según el minuto de programación.
+        for (int m = 0; m < 1440; m++) inicio[m + 1] += inicio[m];
+        inicio[1441] = n;
+        int siguiente[1440];
+        memcpy(siguiente, inicio, sizeof(siguiente));
+        for (int i = 0; i < n; i++) eventos[siguiente[generados[i].minuto_programacion]++] = generados[i];
+
+        unsigned long long huella_heap = benchmark_replay_dia(eventos, inicio, vuelos, n, 0);
+        unsigned long long huella_rueda = benchmark_replay_dia(eventos, inicio, vuelos, n, 1);
+        printf("%9s   Orden de despegue: %s\n", "", huella_heap == huella_rueda ? "igual" : "DISTINTO");
+    }
+    free(generados);
+    free(eventos);
+    free(vuelos);
+}
+
+
+/**
+ * @brief Compara memoria y tiempo de recorrido de un vector de nodos Vuelo y del almacén columnar
+ *        con 10K, 100K y 1M vuelos.
+ *
+ * Se mide el filtro destino Y aerolínea para todas las combinaciones de DESTINOS y AEROLINEAS
+ * (con strcmp en los nodos, con identificadores de un byte en las columnas) y la búsqueda de
+ * la salida más temprana. Los dos formatos deben dar los mismos resultados.
+ */
+void benchmark_almacen(void) {
+    Vuelo* vuelos = (Vuelo*)calloc(BENCH_ALMACEN_MAX, sizeof(Vuelo));
+    int* posiciones = (int*)malloc(sizeof(int) * BENCH_ALMACEN_MAX);
+    if (vuelos == NULL || posiciones == NULL) {
+        printf("Error: Fallo de asignación de memoria para el benchmark.\n");
+        free(vuelos);
+        free(posiciones);
+        return;
+    }
+
+    printf("%9s | %-9s | %11s | %11s | %13s | %17s\n", "Vuelos", "Formato", "Bytes/vuelo", "Memoria(MB)",
+           "Filtros Y(s)", "Primera salida(s)");
+    printf("-------------------------------------------------------------------------------------\n");
+    const int tamanos[] = {10000, 100000, BENCH_ALMACEN_MAX};
+    for (int t = 0; t < 3; t++) {
+        int n = tamanos[t];
+        AlmacenVuelos almacen;
+        if (!almacen_crear(&almacen, n)) {
+            printf("Error: Fallo de asignación de memoria para el benchmark.\n");
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            codigo_benchmark(vuelos[i].codigo_vuelo, i);
+            rellenar_vuelo_aleatorio(&vuelos[i]);
+            almacen_agregar(&almacen, vuelos[i].codigo_vuelo, vuelos[i].origen, vuelos[i].destino,
+                            vuelos[i].aerolinea, salida_de_vuelo(&vuelos[i]).clave_salida);
+        }
+
+        // 1. Nodos Vuelo: dos strcmp por vuelo y filtro
+        long long total_nodos = 0;
+        clock_t t0 = clock();
+        for (int d = 0; d < NUM_DEST; d++) {
+            for (int l = 0; l < NUM_AERO; l++) {
+                int m = 0;
+                for (int i = 0; i < n; i++) {
+                    if (strcmp(vuelos[i].destino, DESTINOS[d]) == 0 && strcmp(vuelos[i].aerolinea, AEROLINEAS[l]) == 0)
+                        posiciones[m++] = i;
+                }
+                total_nodos += m;
+            }
+        }
+        double t_filtro_nodos = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+        t0 = clock();
+        long long primera_nodos = LLONG_MAX;
+        for (int i = 0; i < n; i++) {
+            long long clave = vuelos[i].fecha_salida * 10000LL + vuelos[i].hora_salida;
+            if (clave < primera_nodos) primera_nodos = clave;
+        }
+        double t_primera_nodos = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+        // 2. Almacén columnar: dos bytes por vuelo y filtro
+        long long total_columnas = 0;
+        t0 = clock();
+        for (int d = 0; d < NUM_DEST; d++) {
+            for (int l = 0; l < NUM_AERO; l++) {
+                int id_destino = diccionario_columna_id(&almacen.ciudades, DESTINOS[d]);
+                int id_aerolinea = diccionario_columna_id(&almacen.companias, AEROLINEAS[l]);
+                if (id_destino < 0 || id_aerolinea < 0) continue; // Ningún vuelo con ese valor
+                total_columnas += almacen_filtrar(&almacen, id_destino, id_aerolinea, posiciones);
+            }
+        }
+        double t_filtro_columnas = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+        t0 = clock();
+        long long primera_columnas = almacen.salidas[almacen_primera_salida(&almacen)];
+        double t_primera_columnas = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+        printf("%9d | %-9s | %11zu | %11.1f | %13.3f | %17.4f\n", n, "Nodos", sizeof(Vuelo),
+               (double)n * sizeof(Vuelo) / 1e6, t_filtro_nodos, t_primera_nodos);
+        printf("%9d | %-9s | %11zu | %11.1f | %13.3f | %17.4f\n", n, "Columnas", ALMACEN_BYTES_POR_VUELO,
+               (double)n * ALMACEN_BYTES_POR_VUELO / 1e6, t_filtro_columnas, t_primera_columnas);
+        printf("%9s   Resultados: %s\n", "",
+               total_nodos == total_columnas && primera_nodos == primera_columnas ? "iguales" : "DISTINTOS");
+        almacen_liberar(&almacen);
+    }
+    free(vuelos);
+    free(posiciones);
+}
+
 
 // IMPLEMENTACIÓN FALTANTE: Árbol Binario con Representación Vectorial
 // -------------------------------------------------------------------------------------------------------------------------------------
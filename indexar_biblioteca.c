@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "libros_io.h"
+#include "indice_titulos.h"
+#include "indice_prestado.h"
+
+/**
+ * @file indexar_biblioteca.c
+ * @brief Construye los índices del archivo binario de libros.
+ *
+ * Lee todos los registros de `libros_biblioteca.bin` y genera un árbol B+
+ * en disco que asocia cada título con la posición de su registro (ver
+ * `indice_titulos.h`). `buscar_titulo_lineal` lo usa para localizar un
+ * título leyendo una página por nivel en lugar de recorrer todo el archivo.
+ *
+ * También genera los mapas de bits del estado de préstamo
+ * (`libros_biblioteca_prestado.idx`, ver `indice_prestado.h`), con los que
+ * `listar_prestado` cuenta y lista sin recorrer todos los registros.
+ *
+ * Uso:
+ *     indexar_biblioteca [ARCHIVO_DATOS [INDICE_TITULOS [INDICE_PRESTADO]]]
+ *
+ * @return 0 si el índice se genera correctamente, 1 en caso de error.
+ */
+int main(int argc, char *argv[]) {
+    const char *datos = argc > 1 ? argv[1] : NOMBRE_ARCHIVO;
+    const char *indice = argc > 2 ? argv[2] : NOMBRE_INDICE_TITULOS;
+    const char *indice_prestado = argc > 3 ? argv[3] : NOMBRE_INDICE_PRESTADO;
+
+    long n = indice_titulos_construir(datos, indice);
+    if (n < 0) {
+        fprintf(stderr, "No se pudo generar el índice '%s'.\n", indice);
+        return 1;
+    }
+
+    // Mostrar un resumen de la estructura generada
+    IndiceTitulos ind;
+    if (!indice_titulos_abrir(&ind, indice)) {
+        fprintf(stderr, "El índice '%s' generado no es válido.\n", indice);
+        return 1;
+    }
+    printf("OK: indexados %ld títulos de '%s' en '%s'\n", n, datos, indice);
+    printf("Altura: %u | Páginas: %u de %d bytes | Entradas por página: %d\n",
+           ind.cab.altura, ind.cab.num_paginas, TAM_PAGINA_INDICE, ENTRADAS_POR_PAGINA);
+    indice_titulos_cerrar(&ind);
+
+    // Mapas de bits del estado de préstamo
+    if (indice_prestado_construir(datos, indice_prestado) < 0) {
+        fprintf(stderr, "No se pudo generar el índice '%s'.\n", indice_prestado);
+        return 1;
+    }
+    IndicePrestado prest;
+    if (!indice_prestado_abrir(&prest, indice_prestado)) {
+        fprintf(stderr, "El índice '%s' generado no es válido.\n", indice_prestado);
+        return 1;
+    }
+    printf("OK: mapas de préstamo en '%s' (Si: %ld libros en %lu palabras | No: %ld libros en %lu palabras)\n",
+           indice_prestado, mapa_bits_contar(&prest.si), (unsigned long)prest.si.num,
+           mapa_bits_contar(&prest.no), (unsigned long)prest.no.num);
+    indice_prestado_liberar(&prest);
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+#ifndef INDICE_ATRIBUTOS_H
+#define INDICE_ATRIBUTOS_H
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file indice_atributos.h
+ * @brief Índice secundario codificado por diccionario para atributos con pocos valores distintos.
+ *
+ * Cada valor distinto del atributo (una ciudad, una aerolínea) recibe un identificador
+ * entero pequeño la primera vez que aparece; el diccionario es un vector de cadenas y
+ * el identificador, su posición. Por cada identificador se guarda la lista de elementos
+ * que tienen ese valor (lista de ocurrencias), así que los elementos con un valor dado
+ * se obtienen en tiempo proporcional a cuántos son, sin recorrer los demás.
+ *
+ * Para combinar dos valores con Y se recorre la lista más corta y se comprueba el otro
+ * valor en cada elemento: el coste es el tamaño de esa lista, aunque el resultado sea
+ * mucho menor (o esté vacío). Con O se recorren las dos listas.
+ *
+ * Las listas no están ordenadas: un elemento se quita en O(1) llevando el último a su
+ * hueco. El llamador guarda en cada elemento su identificador y su posición en la lista
+ * (igual que `pos_heap` en el montículo) y la actualiza en el elemento que se mueve.
+ *
+ * Los elementos son punteros opacos que el índice no libera.
+ */
+
+/** @brief Capacidad inicial del diccionario y de cada lista de ocurrencias. */
+#define INDICE_ATRIBUTO_INICIAL 8
+
+/**
+ * @struct ListaAtributo
+ * @brief Elementos que comparten un valor del atributo (vector dinámico).
+ */
+typedef struct {
+    void **elementos; /**< Elementos, sin orden. */
+    int tamano;       /**< Elementos almacenados. */
+    int capacidad;    /**< Huecos reservados. */
+} ListaAtributo;
+
+/**
+ * @struct IndiceAtributo
+ * @brief Diccionario de valores y una lista de ocurrencias por valor.
+ */
+typedef struct {
+    char **valores;        /**< valores[id]: cadena del valor con ese identificador. */
+    ListaAtributo *listas; /**< listas[id]: elementos con ese valor. */
+    int num_valores;       /**< Valores distintos registrados. */
+    int capacidad;         /**< Huecos reservados en el diccionario. */
+} IndiceAtributo;
+
+/**
+ * @brief Libera el diccionario y las listas (no los elementos).
+ * @param ind Índice a liberar; queda vacío.
+ */
+static inline void indice_atributo_liberar(IndiceAtributo *ind) {
+    for (int i = 0; i < ind->num_valores; i++) {
+        free(ind->valores[i]);
+        free(ind->listas[i].elementos);
+    }
+    free(ind->valores);
+    free(ind->listas);
+    ind->valores = NULL;
+    ind->listas = NULL;
+    ind->num_valores = ind->capacidad = 0;
+}
+
+/**
+ * @brief Identificador de un valor ya registrado.
+ *
+ * El vocabulario es pequeño, así que basta con recorrer el diccionario.
+ *
+ * @param ind Índice.
+ * @param valor Cadena del valor.
+ * @return Su identificador, o -1 si ningún elemento lo ha tenido nunca.
+ */
+static inline int indice_atributo_id(const IndiceAtributo *ind, const char *valor) {
+    for (int i = 0; i < ind->num_valores; i++) {
+        if (strcmp(ind->valores[i], valor) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Identificador de un valor, registrándolo en el diccionario si es nuevo.
+ * @param ind Índice.
+ * @param valor Cadena del valor.
+ * @return Su identificador, o -1 si no hay memoria para registrarlo.
+ */
+static inline int indice_atributo_codificar(IndiceAtributo *ind, const char *valor) {
+    int id = indice_atributo_id(ind, valor);
+    if (id >= 0) return id;
+
+    if (ind->num_valores == ind->capacidad) {
+        int capacidad = ind->capacidad > 0 ? ind->capacidad * 2 : INDICE_ATRIBUTO_INICIAL;
+        char **valores = (char **)realloc(ind->valores, sizeof(char *) * capacidad);
+        if (valores == NULL) return -1;
+        ind->valores = valores;
+        ListaAtributo *listas = (ListaAtributo *)realloc(ind->listas, sizeof(ListaAtributo) * capacidad);
+        if (listas == NULL) return -1;
+        ind->listas = listas;
+        ind->capacidad = capacidad;
+    }
+
+    size_t len = strlen(valor) + 1;
+    char *copia = (char *)malloc(len);
+    if (copia == NULL) return -1;
+    memcpy(copia, valor, len);
+
+    id = ind->num_valores++;
+    ind->valores[id] = copia;
+    ind->listas[id].elementos = NULL;
+    ind->listas[id].tamano = ind->listas[id].capacidad = 0;
+    return id;
+}
+
+/**
+ * @brief Crea un índice con un vocabulario inicial.
+ *
+ * Los valores reciben los identificadores 0..n-1 en el orden dado; los que no estén
+ * se registran después según aparezcan.
+ *
+ * @param ind Índice a inicializar.
+ * @param valores Vocabulario conocido de antemano (puede ser NULL si @p n es 0).
+ * @param n Número de valores.
+ * @return 1 si se crea, 0 si falla la memoria (el índice queda vacío).
+ */
+static inline int indice_atributo_crear(IndiceAtributo *ind, const char *const *valores, int n) {
+    ind->valores = NULL;
+    ind->listas = NULL;
+    ind->num_valores = ind->capacidad = 0;
+    for (int i = 0; i < n; i++) {
+        if (indice_atributo_codificar(ind, valores[i]) < 0) {
+            indice_atributo_liberar(ind);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Lista de ocurrencias de un identificador.
+ * @return La lista, o NULL si @p id no es un identificador válido (p. ej. -1).
+ */
+static inline const ListaAtributo *indice_atributo_lista(const IndiceAtributo *ind, int id) {
+    if (id < 0 || id >= ind->num_valores) return NULL;
+    return &ind->listas[id];
+}
+
+/**
+ * @brief Añade un elemento a la lista de un identificador.
+ * @param ind Índice.
+ * @param id Identificador (de indice_atributo_codificar).
+ * @param elemento Elemento a añadir.
+ * @return Posición del elemento en la lista, o -1 si no hay memoria.
+ */
+static inline int indice_atributo_agregar(IndiceAtributo *ind, int id, void *elemento) {
+    ListaAtributo *l = &ind->listas[id];
+    if (l->tamano == l->capacidad) {
+        int capacidad = l->capacidad > 0 ? l->capacidad * 2 : INDICE_ATRIBUTO_INICIAL;
+        void **elementos = (void **)realloc(l->elementos, sizeof(void *) * capacidad);
+        if (elementos == NULL) return -1;
+        l->elementos = elementos;
+        l->capacidad = capacidad;
+    }
+    l->elementos[l->tamano] = elemento;
+    return l->tamano++;
+}
+
+/**
+ * @brief Quita el elemento de la posición @p pos de la lista de un identificador.
+ *
+ * El último elemento de la lista pasa a ocupar su hueco.
+ *
+ * @param ind Índice.
+ * @param id Identificador.
+ * @param pos Posición del elemento en la lista.
+ * @return El elemento que ahora está en @p pos (el llamador debe actualizar su posición),
+ *         o NULL si el quitado era el último.
+ */
+static inline void *indice_atributo_quitar(IndiceAtributo *ind, int id, int pos) {
+    ListaAtributo *l = &ind->listas[id];
+    l->tamano--;
+    if (pos == l->tamano) return NULL;
+    l->elementos[pos] = l->elementos[l->tamano];
+    return l->elementos[pos];
+}
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef INDICE_DISTANCIAS_H
+#define INDICE_DISTANCIAS_H
+
+#include <stdint.h>
+#include "arena.h"
+
+/**
+ * @file indice_distancias.h
+ * @brief Índice secundario por distancia: AVL de estadísticos de orden con clave compuesta.
+ *
+ * La clave de cada nodo es el par (distancia, elemento): la distancia ordena y la
+ * dirección del elemento desempata, así que varios trenes con la misma distancia
+ * conviven en el árbol y cada uno se puede quitar sin ambigüedad.
+ *
+ * Cada nodo guarda, además de su altura, el número de nodos de su subárbol. Con eso
+ * se cuenta cuántos elementos tienen distancia menor que un valor bajando una sola
+ * rama (O(log n)), y un rango [mínimo, máximo] se cuenta con dos bajadas. Los elementos
+ * de un rango se recorren en orden de distancia en O(log n + k) con RecorridoDistancias.
+ *
+ * Los nodos salen de una arena propia (arena.h). Los elementos son punteros opacos que
+ * el índice no libera; deben conservar su dirección mientras estén en el índice.
+ */
+
+/** @brief Nodos del primer bloque de la arena del índice. */
+#define INDICE_DISTANCIAS_BLOQUE 256
+
+/** @brief Altura máxima de un AVL (1.44·log2(n) < 64 para cualquier n representable). */
+#define INDICE_DISTANCIAS_ALTURA_MAX 64
+
+/**
+ * @struct NodoDistancia
+ * @brief Nodo del AVL: clave compuesta, enlaces, altura y tamaño del subárbol.
+ */
+typedef struct NodoDistancia {
+    int distancia;
+    void *elemento;
+    struct NodoDistancia *izquierdo;
+    struct NodoDistancia *derecho;
+    int altura;  /**< Altura del subárbol (hoja = 1). */
+    int tamano;  /**< Nodos del subárbol, incluido este. */
+} NodoDistancia;
+
+/**
+ * @struct IndiceDistancias
+ * @brief Raíz del AVL y arena de sus nodos.
+ */
+typedef struct {
+    NodoDistancia *raiz;
+    Arena nodos;
+} IndiceDistancias;
+
+/**
+ * @struct RecorridoDistancias
+ * @brief Recorrido en orden de los elementos con distancia en [mínimo, máximo].
+ *
+ * La pila guarda los antecesores pendientes de visitar; el índice no debe cambiar
+ * mientras dura el recorrido.
+ */
+typedef struct {
+    NodoDistancia *pila[INDICE_DISTANCIAS_ALTURA_MAX];
+    int n;
+    int maximo;
+} RecorridoDistancias;
+
+/** @brief Inicializa un índice vacío. */
+static inline void indice_distancias_crear(IndiceDistancias *ind) {
+    ind->raiz = NULL;
+    arena_iniciar(&ind->nodos, sizeof(NodoDistancia), INDICE_DISTANCIAS_BLOQUE);
+}
+
+/** @brief Libera todos los nodos de golpe (no los elementos); el índice queda vacío. */
+static inline void indice_distancias_liberar(IndiceDistancias *ind) {
+    arena_destruir(&ind->nodos);
+    ind->raiz = NULL;
+}
+
+/** @brief Número de elementos del índice. */
+static inline int indice_distancias_tamano(const IndiceDistancias *ind) {
+    return ind->raiz ? ind->raiz->tamano : 0;
+}
+
+static inline int indice_distancias_altura(const NodoDistancia *n) { return n ? n->altura : 0; }
+static inline int indice_distancias_nodos(const NodoDistancia *n) { return n ? n->tamano : 0; }
+
+/** @brief Recalcula altura y tamaño de un nodo a partir de sus hijos. */
+static inline void indice_distancias_actualizar(NodoDistancia *n) {
+    int hi = indice_distancias_altura(n->izquierdo), hd = indice_distancias_altura(n->derecho);
+    n->altura = 1 + (hi > hd ? hi : hd);
+    n->tamano = 1 + indice_distancias_nodos(n->izquierdo) + indice_distancias_nodos(n->derecho);
+}
+
+/** @brief Compara la clave (distancia, elemento) con la de un nodo (<0, 0, >0). */
+static inline int indice_distancias_comparar(int distancia, const void *elemento, const NodoDistancia *n) {
+    if (distancia != n->distancia) return distancia < n->distancia ? -1 : 1;
+    if ((uintptr_t)elemento != (uintptr_t)n->elemento) return (uintptr_t)elemento < (uintptr_t)n->elemento ? -1 : 1;
+    return 0;
+}
+
+static inline NodoDistancia *indice_distancias_rotar_derecha(NodoDistancia *y) {
+    NodoDistancia *x = y->izquierdo;
+    y->izquierdo = x->derecho;
+    x->derecho = y;
+    indice_distancias_actualizar(y);
+    indice_distancias_actualizar(x);
+    return x;
+}
+
+static inline NodoDistancia *indice_distancias_rotar_izquierda(NodoDistancia *x) {
+    NodoDistancia *y = x->derecho;
+    x->derecho = y->izquierdo;
+    y->izquierdo = x;
+    indice_distancias_actualizar(x);
+    indice_distancias_actualizar(y);
+    return y;
+}
+
+/** @brief Actualiza un nodo y lo reequilibra con una rotación simple o doble si hace falta. */
+static inline NodoDistancia *indice_distancias_equilibrar(NodoDistancia *n) {
+    indice_distancias_actualizar(n);
+    int balance = indice_distancias_altura(n->izquierdo) - indice_distancias_altura(n->derecho);
+    if (balance > 1) {
+        if (indice_distancias_altura(n->izquierdo->izquierdo) < indice_distancias_altura(n->izquierdo->derecho))
+            n->izquierdo = indice_distancias_rotar_izquierda(n->izquierdo);
+        return indice_distancias_rotar_derecha(n);
+    }
+    if (balance < -1) {
+        if (indice_distancias_altura(n->derecho->derecho) < indice_distancias_altura(n->derecho->izquierdo))
+            n->derecho = indice_distancias_rotar_derecha(n->derecho);
+        return indice_distancias_rotar_izquierda(n);
+    }
+    return n;
+}
+
+static inline NodoDistancia *indice_distancias_insertar_nodo(NodoDistancia *raiz, NodoDistancia *nuevo) {
+    if (raiz == NULL) return nuevo;
+    if (indice_distancias_comparar(nuevo->distancia, nuevo->elemento, raiz) < 0)
+        raiz->izquierdo = indice_distancias_insertar_nodo(raiz->izquierdo, nuevo);
+    else
+        raiz->derecho = indice_distancias_insertar_nodo(raiz->derecho, nuevo);
+    return indice_distancias_equilibrar(raiz);
+}
+
+/** @brief Desengancha el mínimo de un subárbol en @p minimo y devuelve el subárbol reequilibrado. */
+static inline NodoDistancia *indice_distancias_quitar_minimo(NodoDistancia *raiz, NodoDistancia **minimo) {
+    if (raiz->izquierdo == NULL) {
+        *minimo = raiz;
+        return raiz->derecho;
+    }
+    raiz->izquierdo = indice_distancias_quitar_minimo(raiz->izquierdo, minimo);
+    return indice_distancias_equilibrar(raiz);
+}
+
+static inline NodoDistancia *indice_distancias_quitar_nodo(IndiceDistancias *ind, NodoDistancia *raiz,
+                                                           int distancia, const void *elemento, int *quitado) {
+    if (raiz == NULL) return NULL;
+    int cmp = indice_distancias_comparar(distancia, elemento, raiz);
+    if (cmp < 0) {
+        raiz->izquierdo = indice_distancias_quitar_nodo(ind, raiz->izquierdo, distancia, elemento, quitado);
+    } else if (cmp > 0) {
+        raiz->derecho = indice_distancias_quitar_nodo(ind, raiz->derecho, distancia, elemento, quitado);
+    } else {
+        NodoDistancia *sustituto;
+        *quitado = 1;
+        if (raiz->izquierdo == NULL || raiz->derecho == NULL) {
+            sustituto = raiz->izquierdo ? raiz->izquierdo : raiz->derecho;
+        } else {
+            /// El sucesor se reenlaza en el hueco (sin copiar claves entre nodos).
+            NodoDistancia *derecho = indice_distancias_quitar_minimo(raiz->derecho, &sustituto);
+            sustituto->izquierdo = raiz->izquierdo;
+            sustituto->derecho = derecho;
+        }
+        arena_liberar(&ind->nodos, raiz);
+        return sustituto ? indice_distancias_equilibrar(sustituto) : NULL;
+    }
+    return indice_distancias_equilibrar(raiz);
+}
+
+/**
+ * @brief Añade un elemento con su distancia.
+ * @return 1 si se añade, 0 si falla la memoria.
+ */
+static inline int indice_distancias_insertar(IndiceDistancias *ind, int distancia, void *elemento) {
+    NodoDistancia *nuevo = (NodoDistancia *)arena_reservar(&ind->nodos);
+    if (nuevo == NULL) return 0;
+    nuevo->distancia = distancia;
+    nuevo->elemento = elemento;
+    nuevo->izquierdo = nuevo->derecho = NULL;
+    nuevo->altura = nuevo->tamano = 1;
+    ind->raiz = indice_distancias_insertar_nodo(ind->raiz, nuevo);
+    return 1;
+}
+
+/**
+ * @brief Quita un elemento; @p distancia debe ser la que tenía al insertarlo.
+ * @return 1 si estaba y se quita, 0 si no estaba.
+ */
+static inline int indice_distancias_quitar(IndiceDistancias *ind, int distancia, const void *elemento) {
+    int quitado = 0;
+    ind->raiz = indice_distancias_quitar_nodo(ind, ind->raiz, distancia, elemento, &quitado);
+    return quitado;
+}
+
+/**
+ * @brief Cuenta los elementos con distancia menor que @p distancia (o menor o igual si
+ *        @p incluida) bajando una sola rama.
+ */
+static inline int indice_distancias_contar_menores(const IndiceDistancias *ind, int distancia, int incluida) {
+    int cuenta = 0;
+    const NodoDistancia *n = ind->raiz;
+    while (n != NULL) {
+        if (n->distancia < distancia || (incluida && n->distancia == distancia)) {
+            cuenta += indice_distancias_nodos(n->izquierdo) + 1;
+            n = n->derecho;
+        } else {
+            n = n->izquierdo;
+        }
+    }
+    return cuenta;
+}
+
+/** @brief Cuenta los elementos con distancia en [@p minimo, @p maximo] en O(log n). */
+static inline int indice_distancias_contar(const IndiceDistancias *ind, int minimo, int maximo) {
+    if (minimo > maximo) return 0;
+    return indice_distancias_contar_menores(ind, maximo, 1) - indice_distancias_contar_menores(ind, minimo, 0);
+}
+
+/**
+ * @brief Prepara el recorrido de los elementos con distancia en [@p minimo, @p maximo].
+ *
+ * Se baja buscando el primer nodo con distancia >= mínimo y se apilan los nodos en los que
+ * se gira a la izquierda, que son los que quedan por visitar después.
+ */
+static inline void indice_distancias_recorrido_iniciar(RecorridoDistancias *r, const IndiceDistancias *ind,
+                                                       int minimo, int maximo) {
+    r->n = 0;
+    r->maximo = maximo;
+    NodoDistancia *n = ind->raiz;
+    while (n != NULL) {
+        if (n->distancia >= minimo) {
+            r->pila[r->n++] = n;
+            n = n->izquierdo;
+        } else {
+            n = n->derecho;
+        }
+    }
+}
+
+/**
+ * @brief Siguiente elemento del rango en orden de distancia.
+ * @param distancia Si no es NULL, recibe la distancia del elemento.
+ * @return El elemento, o NULL cuando se acaba el rango.
+ */
+static inline void *indice_distancias_recorrido_siguiente(RecorridoDistancias *r, int *distancia) {
+    if (r->n == 0) return NULL;
+    NodoDistancia *n = r->pila[--r->n];
+    if (n->distancia > r->maximo) {
+        r->n = 0;
+        return NULL;
+    }
+    for (NodoDistancia *m = n->derecho; m != NULL; m = m->izquierdo) {
+        r->pila[r->n++] = m;
+    }
+    if (distancia) *distancia = n->distancia;
+    return n->elemento;
+}
+
+#endif
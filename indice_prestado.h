@@ -0,0 +1,312 @@
+#ifndef INDICE_PRESTADO_H
+#define INDICE_PRESTADO_H
+
+#include <strings.h>
+#include "libros_io.h"
+
+/**
+ * @file indice_prestado.h
+ * @brief Índice de mapa de bits comprimido sobre el estado de préstamo.
+ *
+ * Para cada estado ("Si" y "No") se guarda un mapa de bits con un bit por
+ * registro del archivo de datos: el bit i vale 1 si el libro i tiene ese
+ * estado. Los mapas se comprimen con codificación por rachas de palabras
+ * alineadas (WAH) de 64 bits:
+ *
+ *  - Palabra literal (bit 63 = 0): los 63 bits bajos son 63 registros seguidos.
+ *  - Palabra de relleno (bit 63 = 1): el bit 62 indica el valor repetido y los
+ *    62 bits bajos cuántos grupos de 63 registros tienen todos ese valor.
+ *
+ * Contar los libros prestados es sumar `popcount` de las literales y
+ * 63 × grupos de los rellenos de unos: O(palabras), sin leer los datos.
+ * Para listar, se recorren las posiciones a 1 y solo se leen esos registros.
+ *
+ * Ambos mapas se guardan en `libros_biblioteca_prestado.idx` junto con el
+ * número de registros y la suma de control de los datos que indexan.
+ */
+
+/** @brief Nombre del archivo con los mapas de bits de préstamo. */
+#define NOMBRE_INDICE_PRESTADO "libros_biblioteca_prestado.idx"
+
+/** @brief Número mágico del índice (bytes 'L','P','R','E' en el archivo). */
+#define PRESTADO_MAGICO 0x4552504Cu
+
+/** @brief Versión del formato del índice de préstamo. */
+#define PRESTADO_VERSION 1
+
+/** @brief Registros representados por cada palabra literal. */
+#define BITS_GRUPO 63
+
+#define WAH_RELLENO   (1ULL << 63)   /**< Marca de palabra de relleno. */
+#define WAH_VALOR     (1ULL << 62)   /**< Valor repetido en una palabra de relleno. */
+#define WAH_MAX_GRUPOS (WAH_VALOR - 1) /**< Máximo de grupos en un solo relleno. */
+
+/**
+ * @struct MapaBits
+ * @brief Mapa de bits comprimido con WAH.
+ */
+typedef struct {
+    uint64_t *palabras;   /**< Palabras codificadas. */
+    uint64_t num;         /**< Palabras ocupadas. */
+    uint64_t capacidad;   /**< Palabras reservadas. */
+    uint64_t bits;        /**< Registros representados. */
+    uint64_t grupo;       /**< Grupo de 63 bits en construcción (aún sin codificar). */
+} MapaBits;
+
+/**
+ * @struct CabeceraPrestado
+ * @brief Cabecera del archivo de índice de préstamo.
+ */
+typedef struct {
+    uint32_t magico;            /**< Siempre @ref PRESTADO_MAGICO. */
+    uint16_t version;           /**< @ref PRESTADO_VERSION. */
+    uint16_t reservado;         /**< 0. */
+    uint64_t registros_datos;   /**< Registros del archivo de datos al construir. */
+    uint32_t suma_datos;        /**< Suma de control del archivo de datos al construir. */
+    uint32_t reservado2;        /**< 0. */
+    uint64_t palabras_si;       /**< Palabras del mapa "Si". */
+    uint64_t palabras_no;       /**< Palabras del mapa "No". */
+} CabeceraPrestado;
+
+/**
+ * @struct IndicePrestado
+ * @brief Índice de préstamo cargado en memoria.
+ */
+typedef struct {
+    CabeceraPrestado cab;
+    MapaBits si;     /**< Libros prestados. */
+    MapaBits no;     /**< Libros disponibles. */
+} IndicePrestado;
+
+/**
+ * @brief Función llamada con la posición de cada bit a 1.
+ * @return 0 para seguir, distinto de 0 para detener el recorrido.
+ */
+typedef int (*VisitaPosicion)(long pos, void *ctx);
+
+/**
+ * @brief Añade una palabra codificada al final del mapa.
+ * @return 1 si se ha añadido, 0 si no hay memoria.
+ */
+static inline int mapa_bits_poner_palabra(MapaBits *m, uint64_t palabra) {
+    if (m->num == m->capacidad) {
+        uint64_t nueva = m->capacidad ? m->capacidad * 2 : 16;
+        uint64_t *p = realloc(m->palabras, sizeof(uint64_t) * nueva);
+        if (!p) return 0;
+        m->palabras = p;
+        m->capacidad = nueva;
+    }
+    m->palabras[m->num++] = palabra;
+    return 1;
+}
+
+/**
+ * @brief Codifica el grupo en construcción (literal o extensión de un relleno).
+ */
+static inline int mapa_bits_cerrar_grupo(MapaBits *m) {
+    const uint64_t lleno = (1ULL << BITS_GRUPO) - 1;
+    uint64_t g = m->grupo;
+    m->grupo = 0;
+
+    if (g != 0 && g != lleno) return mapa_bits_poner_palabra(m, g);
+
+    uint64_t valor = g ? WAH_VALOR : 0;
+    if (m->num > 0) {
+        uint64_t *ultima = &m->palabras[m->num - 1];
+        if ((*ultima & WAH_RELLENO) && (*ultima & WAH_VALOR) == valor &&
+            (*ultima & WAH_MAX_GRUPOS) < WAH_MAX_GRUPOS) {
+            (*ultima)++;
+            return 1;
+        }
+    }
+    return mapa_bits_poner_palabra(m, WAH_RELLENO | valor | 1);
+}
+
+/**
+ * @brief Añade el bit del siguiente registro.
+ * @return 1 si se ha añadido, 0 si no hay memoria.
+ */
+static inline int mapa_bits_anadir(MapaBits *m, int bit) {
+    uint64_t desp = m->bits % BITS_GRUPO;
+    if (bit) m->grupo |= 1ULL << desp;
+    m->bits++;
+    if (desp == BITS_GRUPO - 1) return mapa_bits_cerrar_grupo(m);
+    return 1;
+}
+
+/**
+ * @brief Termina la construcción codificando el último grupo incompleto.
+ *
+ * Un grupo incompleto siempre se guarda como literal, para que un relleno
+ * de unos nunca cuente registros que no existen.
+ */
+static inline int mapa_bits_terminar(MapaBits *m) {
+    if (m->bits % BITS_GRUPO == 0) return 1;
+    uint64_t g = m->grupo;
+    m->grupo = 0;
+    if (g == 0) return mapa_bits_cerrar_grupo(m);
+    return mapa_bits_poner_palabra(m, g);
+}
+
+/**
+ * @brief Número de bits a 1 (registros con el estado del mapa).
+ */
+static inline long mapa_bits_contar(const MapaBits *m) {
+    long total = 0;
+    for (uint64_t i = 0; i < m->num; i++) {
+        uint64_t w = m->palabras[i];
+        if (!(w & WAH_RELLENO)) total += __builtin_popcountll(w);
+        else if (w & WAH_VALOR) total += (long)(w & WAH_MAX_GRUPOS) * BITS_GRUPO;
+    }
+    return total;
+}
+
+/**
+ * @brief Llama a @p visitar con la posición de cada bit a 1, en orden creciente.
+ * @return Número de posiciones visitadas.
+ */
+static inline long mapa_bits_recorrer(const MapaBits *m, VisitaPosicion visitar, void *ctx) {
+    long base = 0, visitadas = 0;
+    for (uint64_t i = 0; i < m->num; i++) {
+        uint64_t w = m->palabras[i];
+        if (w & WAH_RELLENO) {
+            long cuantos = (long)(w & WAH_MAX_GRUPOS) * BITS_GRUPO;
+            if (w & WAH_VALOR) {
+                for (long p = base; p < base + cuantos; p++) {
+                    visitadas++;
+                    if (visitar(p, ctx)) return visitadas;
+                }
+            }
+            base += cuantos;
+        } else {
+            while (w) {
+                visitadas++;
+                if (visitar(base + __builtin_ctzll(w), ctx)) return visitadas;
+                w &= w - 1; // Quitar el bit a 1 más bajo
+            }
+            base += BITS_GRUPO;
+        }
+    }
+    return visitadas;
+}
+
+/**
+ * @brief Libera la memoria de un mapa de bits.
+ */
+static inline void mapa_bits_liberar(MapaBits *m) {
+    free(m->palabras);
+    memset(m, 0, sizeof(*m));
+}
+
+/**
+ * @brief Construye (o reconstruye) el índice de préstamo de un archivo de libros.
+ *
+ * @param archivo_datos Archivo binario de libros.
+ * @param archivo_indice Archivo de índice a generar.
+ * @return Número de registros indexados, o -1 en caso de error.
+ */
+static inline long indice_prestado_construir(const char *archivo_datos, const char *archivo_indice) {
+    ArchivoLibros datos;
+    if (!libros_abrir(&datos, archivo_datos)) {
+        perror(archivo_datos);
+        return -1;
+    }
+
+    MapaBits si = {0}, no = {0};
+    Libro libro;
+    int ok = 1;
+    while (ok && libros_leer(&datos, &libro)) {
+        ok = mapa_bits_anadir(&si, strcasecmp(libro.prestado, "si") == 0) &&
+             mapa_bits_anadir(&no, strcasecmp(libro.prestado, "no") == 0);
+    }
+    ok = ok && !libros_error(&datos) && mapa_bits_terminar(&si) && mapa_bits_terminar(&no);
+
+    CabeceraPrestado cab = {0};
+    cab.magico = PRESTADO_MAGICO;
+    cab.version = PRESTADO_VERSION;
+    cab.registros_datos = datos.cab.num_registros;
+    cab.suma_datos = datos.cab.suma_control;
+    cab.palabras_si = si.num;
+    cab.palabras_no = no.num;
+    libros_cerrar(&datos);
+
+    FILE *f = ok ? fopen(archivo_indice, "wb") : NULL;
+    if (f) {
+        ok = fwrite(&cab, sizeof(cab), 1, f) == 1 &&
+             fwrite(si.palabras, sizeof(uint64_t), si.num, f) == si.num &&
+             fwrite(no.palabras, sizeof(uint64_t), no.num, f) == no.num;
+        if (fclose(f) != 0) ok = 0;
+    } else {
+        ok = 0;
+    }
+
+    long n = (long)si.bits;
+    mapa_bits_liberar(&si);
+    mapa_bits_liberar(&no);
+    if (!ok) {
+        perror(archivo_indice);
+        return -1;
+    }
+    return n;
+}
+
+/**
+ * @brief Lee un mapa de @p num palabras del archivo de índice.
+ */
+static inline int indice_prestado_leer_mapa(FILE *f, uint64_t num, uint64_t bits, MapaBits *m) {
+    memset(m, 0, sizeof(*m));
+    m->palabras = malloc(sizeof(uint64_t) * (num ? num : 1));
+    if (!m->palabras) return 0;
+    m->num = m->capacidad = num;
+    m->bits = bits;
+    return fread(m->palabras, sizeof(uint64_t), num, f) == num;
+}
+
+/**
+ * @brief Carga en memoria el índice de préstamo.
+ * @return 1 si se carga correctamente, 0 si no existe o no es válido.
+ */
+static inline int indice_prestado_abrir(IndicePrestado *ind, const char *archivo_indice) {
+    memset(ind, 0, sizeof(*ind));
+    FILE *f = fopen(archivo_indice, "rb");
+    if (!f) return 0;
+
+    int ok = fread(&ind->cab, sizeof(CabeceraPrestado), 1, f) == 1 &&
+             ind->cab.magico == PRESTADO_MAGICO &&
+             ind->cab.version == PRESTADO_VERSION &&
+             indice_prestado_leer_mapa(f, ind->cab.palabras_si, ind->cab.registros_datos, &ind->si) &&
+             indice_prestado_leer_mapa(f, ind->cab.palabras_no, ind->cab.registros_datos, &ind->no);
+    fclose(f);
+
+    if (!ok) {
+        mapa_bits_liberar(&ind->si);
+        mapa_bits_liberar(&ind->no);
+    }
+    return ok;
+}
+
+/**
+ * @brief Comprueba que el índice corresponde al contenido actual del archivo de datos.
+ * @return 1 si el índice está al día, 0 si hay que reconstruirlo.
+ */
+static inline int indice_prestado_vigente(const IndicePrestado *ind, const ArchivoLibros *datos) {
+    return ind->cab.registros_datos == datos->cab.num_registros &&
+           ind->cab.suma_datos == datos->cab.suma_control;
+}
+
+/**
+ * @brief Devuelve el mapa del estado indicado ("Si" o "No", sin distinguir mayúsculas).
+ */
+static inline const MapaBits *indice_prestado_mapa(const IndicePrestado *ind, const char *estado) {
+    return strcasecmp(estado, "si") == 0 ? &ind->si : &ind->no;
+}
+
+/**
+ * @brief Libera la memoria del índice de préstamo.
+ */
+static inline void indice_prestado_liberar(IndicePrestado *ind) {
+    mapa_bits_liberar(&ind->si);
+    mapa_bits_liberar(&ind->no);
+}
+
+#endif // INDICE_PRESTADO_H
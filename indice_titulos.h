@@ -0,0 +1,325 @@
+#ifndef INDICE_TITULOS_H
+#define INDICE_TITULOS_H
+
+#include "libros_io.h"
+
+/**
+ * @file indice_titulos.h
+ * @brief Índice persistente de títulos en forma de árbol B+ (`libros_biblioteca.idx`).
+ *
+ * El índice se guarda en un archivo aparte, dividido en páginas de
+ * @ref TAM_PAGINA_INDICE bytes. La página 0 es la cabecera; el resto son nodos
+ * del árbol B+. Las hojas guardan pares (título, posición del registro en el
+ * archivo de datos) ordenados por título y enlazadas con la hoja siguiente;
+ * los nodos internos guardan, para cada hijo, el menor título de su subárbol.
+ *
+ * Una búsqueda lee una página por nivel, es decir O(log N) lecturas en lugar
+ * de recorrer los N registros. El índice se construye de abajo arriba a partir
+ * de las claves ordenadas (carga masiva), con las páginas completamente llenas.
+ *
+ * La cabecera guarda el número de registros y la suma de control del archivo
+ * de datos con el que se construyó, para detectar índices desactualizados.
+ */
+
+/** @brief Nombre del archivo de índice de títulos. */
+#define NOMBRE_INDICE_TITULOS "libros_biblioteca.idx"
+
+/** @brief Número mágico del índice (bytes 'L','I','D','X' en el archivo). */
+#define INDICE_MAGICO 0x5844494Cu
+
+/** @brief Versión del formato del índice. */
+#define INDICE_VERSION 1
+
+/** @brief Tamaño de cada página del índice en bytes. */
+#define TAM_PAGINA_INDICE 4096
+
+/** @brief Entradas que caben en una página (hoja o nodo interno). */
+#define ENTRADAS_POR_PAGINA 42
+
+/**
+ * @struct EntradaIndice
+ * @brief Par clave/valor de una página del índice.
+ */
+typedef struct {
+    char clave[CAD_TITULO];   /**< Título (clave de ordenación). */
+    int64_t valor;            /**< Hoja: posición del registro. Interno: página hija. */
+} EntradaIndice;
+
+/**
+ * @struct PaginaIndice
+ * @brief Nodo del árbol B+ tal y como se guarda en disco.
+ */
+typedef struct {
+    uint16_t hoja;            /**< 1 si es una hoja, 0 si es un nodo interno. */
+    uint16_t num;             /**< Entradas ocupadas. */
+    uint32_t siguiente;       /**< Hojas: página de la hoja siguiente (0 si es la última). */
+    EntradaIndice e[ENTRADAS_POR_PAGINA];
+    char relleno[TAM_PAGINA_INDICE - 8 - ENTRADAS_POR_PAGINA * sizeof(EntradaIndice)];
+} PaginaIndice;
+
+/**
+ * @struct CabeceraIndice
+ * @brief Contenido de la página 0 del índice.
+ */
+typedef struct {
+    uint32_t magico;            /**< Siempre @ref INDICE_MAGICO. */
+    uint16_t version;           /**< @ref INDICE_VERSION. */
+    uint16_t tam_registro;      /**< sizeof(Libro) de los datos indexados. */
+    uint32_t raiz;              /**< Página de la raíz (0 si el índice está vacío). */
+    uint32_t altura;            /**< Niveles del árbol (1 si la raíz es una hoja). */
+    uint64_t num_claves;        /**< Títulos indexados. */
+    uint64_t registros_datos;   /**< Registros del archivo de datos al construir. */
+    uint32_t suma_datos;        /**< Suma de control del archivo de datos al construir. */
+    uint32_t num_paginas;       /**< Páginas totales, incluida la cabecera. */
+} CabeceraIndice;
+
+/**
+ * @struct IndiceTitulos
+ * @brief Índice de títulos abierto para consulta.
+ */
+typedef struct {
+    FILE *f;                    /**< Archivo del índice. */
+    CabeceraIndice cab;         /**< Cabecera leída de la página 0. */
+    long paginas_leidas;        /**< Páginas leídas en la última búsqueda. */
+} IndiceTitulos;
+
+/**
+ * @brief Orden de las entradas: por título y, a igualdad, por posición.
+ */
+static inline int comparar_entradas_indice(const void *a, const void *b) {
+    const EntradaIndice *x = (const EntradaIndice *)a;
+    const EntradaIndice *y = (const EntradaIndice *)b;
+    int cmp = strcmp(x->clave, y->clave);
+    if (cmp != 0) return cmp;
+    return (x->valor > y->valor) - (x->valor < y->valor);
+}
+
+/**
+ * @brief Escribe un nivel del árbol agrupando @p n entradas en páginas llenas.
+ *
+ * @param f Archivo del índice, posicionado al final.
+ * @param entradas Entradas del nivel, ya ordenadas.
+ * @param n Número de entradas.
+ * @param hoja 1 si el nivel es de hojas.
+ * @param siguiente_pagina Número de la próxima página libre (se actualiza).
+ * @param superiores Vector donde se dejan las entradas del nivel superior
+ *        (menor clave de cada página escrita y número de página).
+ * @return Número de páginas escritas, o -1 si hay error de escritura.
+ */
+static inline long indice_escribir_nivel(FILE *f, const EntradaIndice *entradas, long n, int hoja,
+                                         uint32_t *siguiente_pagina, EntradaIndice *superiores) {
+    PaginaIndice pag;
+    long paginas = (n + ENTRADAS_POR_PAGINA - 1) / ENTRADAS_POR_PAGINA;
+
+    for (long p = 0; p < paginas; p++) {
+        long inicio = p * ENTRADAS_POR_PAGINA;
+        long cuantas = n - inicio < ENTRADAS_POR_PAGINA ? n - inicio : ENTRADAS_POR_PAGINA;
+
+        memset(&pag, 0, sizeof(pag));
+        pag.hoja = (uint16_t)hoja;
+        pag.num = (uint16_t)cuantas;
+        pag.siguiente = (hoja && p + 1 < paginas) ? *siguiente_pagina + 1 : 0;
+        memcpy(pag.e, &entradas[inicio], sizeof(EntradaIndice) * cuantas);
+
+        superiores[p] = entradas[inicio];
+        superiores[p].valor = *siguiente_pagina;
+
+        if (fwrite(&pag, sizeof(pag), 1, f) != 1) return -1;
+        (*siguiente_pagina)++;
+    }
+    return paginas;
+}
+
+/**
+ * @brief Construye (o reconstruye) el índice de títulos de un archivo de libros.
+ *
+ * @param archivo_datos Archivo binario de libros.
+ * @param archivo_indice Archivo de índice a generar.
+ * @return Número de títulos indexados, o -1 en caso de error.
+ */
+static inline long indice_titulos_construir(const char *archivo_datos, const char *archivo_indice) {
+    ArchivoLibros datos;
+    if (!libros_abrir(&datos, archivo_datos)) {
+        perror(archivo_datos);
+        return -1;
+    }
+
+    long n = libros_total(&datos);
+    EntradaIndice *entradas = malloc(sizeof(EntradaIndice) * (n > 0 ? n : 1));
+    EntradaIndice *superiores = malloc(sizeof(EntradaIndice) * (n / ENTRADAS_POR_PAGINA + 1));
+    if (!entradas || !superiores) {
+        perror("Error al reservar memoria para el índice");
+        free(entradas);
+        free(superiores);
+        libros_cerrar(&datos);
+        return -1;
+    }
+
+    // 1. Extraer los pares (título, posición) y ordenarlos
+    Libro libro;
+    long leidos = 0;
+    while (leidos < n && libros_leer(&datos, &libro)) {
+        memset(&entradas[leidos], 0, sizeof(EntradaIndice));
+        memcpy(entradas[leidos].clave, libro.titulo, CAD_TITULO);
+        entradas[leidos].clave[CAD_TITULO - 1] = '\0';
+        entradas[leidos].valor = leidos;
+        leidos++;
+    }
+    n = leidos;
+    qsort(entradas, n, sizeof(EntradaIndice), comparar_entradas_indice);
+
+    CabeceraIndice cab = {0};
+    cab.magico = INDICE_MAGICO;
+    cab.version = INDICE_VERSION;
+    cab.tam_registro = (uint16_t)sizeof(Libro);
+    cab.num_claves = (uint64_t)n;
+    cab.registros_datos = datos.cab.num_registros;
+    cab.suma_datos = datos.cab.suma_control;
+    libros_cerrar(&datos);
+
+    FILE *f = fopen(archivo_indice, "wb");
+    if (!f) {
+        perror(archivo_indice);
+        free(entradas);
+        free(superiores);
+        return -1;
+    }
+
+    // 2. Reservar la página 0 para la cabecera y escribir los niveles de abajo arriba
+    PaginaIndice vacia;
+    memset(&vacia, 0, sizeof(vacia));
+    int ok = fwrite(&vacia, sizeof(vacia), 1, f) == 1;
+    uint32_t siguiente_pagina = 1;
+
+    long en_nivel = n;
+    int hoja = 1;
+    EntradaIndice *nivel = entradas;
+    while (ok && en_nivel > 0) {
+        long paginas = indice_escribir_nivel(f, nivel, en_nivel, hoja, &siguiente_pagina, superiores);
+        if (paginas < 0) { ok = 0; break; }
+        cab.altura++;
+        if (paginas == 1) {
+            cab.raiz = siguiente_pagina - 1;
+            break;
+        }
+        // Las entradas del nivel superior pasan a ser el nivel actual
+        memcpy(entradas, superiores, sizeof(EntradaIndice) * paginas);
+        nivel = entradas;
+        en_nivel = paginas;
+        hoja = 0;
+    }
+    cab.num_paginas = siguiente_pagina;
+
+    // 3. Escribir la cabecera definitiva en la página 0
+    if (ok) {
+        memset(&vacia, 0, sizeof(vacia));
+        memcpy(&vacia, &cab, sizeof(cab));
+        ok = fseek(f, 0, SEEK_SET) == 0 && fwrite(&vacia, sizeof(vacia), 1, f) == 1;
+    }
+    if (fclose(f) != 0) ok = 0;
+
+    free(entradas);
+    free(superiores);
+    if (!ok) {
+        perror(archivo_indice);
+        return -1;
+    }
+    return n;
+}
+
+/**
+ * @brief Abre un índice de títulos para consulta.
+ * @return 1 si se abre correctamente, 0 si no existe o no es válido.
+ */
+static inline int indice_titulos_abrir(IndiceTitulos *ind, const char *archivo_indice) {
+    memset(ind, 0, sizeof(*ind));
+    ind->f = fopen(archivo_indice, "rb");
+    if (!ind->f) return 0;
+    if (fread(&ind->cab, sizeof(CabeceraIndice), 1, ind->f) != 1 ||
+        ind->cab.magico != INDICE_MAGICO ||
+        ind->cab.version != INDICE_VERSION ||
+        ind->cab.tam_registro != sizeof(Libro)) {
+        fclose(ind->f);
+        ind->f = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Comprueba que el índice corresponde al contenido actual del archivo de datos.
+ * @return 1 si el índice está al día, 0 si hay que reconstruirlo.
+ */
+static inline int indice_titulos_vigente(const IndiceTitulos *ind, const ArchivoLibros *datos) {
+    return ind->cab.registros_datos == datos->cab.num_registros &&
+           ind->cab.suma_datos == datos->cab.suma_control;
+}
+
+/**
+ * @brief Lee la página @p num del índice.
+ * @return 1 si se ha leído, 0 en caso de error.
+ */
+static inline int indice_leer_pagina(IndiceTitulos *ind, uint32_t num, PaginaIndice *pag) {
+    if (num == 0 || num >= ind->cab.num_paginas) return 0;
+    if (fseek(ind->f, (long)num * TAM_PAGINA_INDICE, SEEK_SET) != 0) return 0;
+    if (fread(pag, sizeof(PaginaIndice), 1, ind->f) != 1) return 0;
+    ind->paginas_leidas++;
+    return 1;
+}
+
+/**
+ * @brief Busca un título exacto en el índice.
+ *
+ * Desciende desde la raíz leyendo una página por nivel. Si hay títulos
+ * repetidos devuelve la primera posición, igual que la búsqueda lineal.
+ *
+ * @param ind Índice abierto.
+ * @param titulo Título buscado.
+ * @return Posición del registro en el archivo de datos, o -1 si no está.
+ */
+static inline long indice_titulos_buscar(IndiceTitulos *ind, const char *titulo) {
+    PaginaIndice pag;
+    uint32_t num = ind->cab.raiz;
+    ind->paginas_leidas = 0;
+
+    if (!indice_leer_pagina(ind, num, &pag)) return -1;
+
+    // 1. Nodos internos: bajar por el último hijo cuya menor clave es < título
+    while (!pag.hoja) {
+        int izq = 0, der = pag.num - 1, hijo = 0;
+        while (izq <= der) {
+            int cen = (izq + der) / 2;
+            if (strcmp(pag.e[cen].clave, titulo) < 0) { hijo = cen; izq = cen + 1; }
+            else der = cen - 1;
+        }
+        if (!indice_leer_pagina(ind, (uint32_t)pag.e[hijo].valor, &pag)) return -1;
+    }
+
+    // 2. Hoja: primera entrada con clave >= título
+    int izq = 0, der = pag.num;
+    while (izq < der) {
+        int cen = (izq + der) / 2;
+        if (strcmp(pag.e[cen].clave, titulo) < 0) izq = cen + 1;
+        else der = cen;
+    }
+
+    // Si todas las claves de la hoja son menores, la primera coincidencia
+    // solo puede estar al principio de la hoja siguiente
+    if (izq == pag.num) {
+        if (pag.siguiente == 0 || !indice_leer_pagina(ind, pag.siguiente, &pag)) return -1;
+        izq = 0;
+    }
+
+    if (izq < pag.num && strcmp(pag.e[izq].clave, titulo) == 0) return (long)pag.e[izq].valor;
+    return -1;
+}
+
+/**
+ * @brief Cierra el índice.
+ */
+static inline void indice_titulos_cerrar(IndiceTitulos *ind) {
+    if (ind->f) fclose(ind->f);
+    ind->f = NULL;
+}
+
+#endif // INDICE_TITULOS_H
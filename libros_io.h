@@ -0,0 +1,450 @@
+#ifndef LIBROS_IO_H
+#define LIBROS_IO_H
+
+#include <stdint.h>
+#include "common.h"
+
+/**
+ * @file libros_io.h
+ * @brief Almacenamiento de libros en un formato binario con cabecera y versión.
+ *
+ * Todos los programas de la biblioteca leen y escriben `libros_biblioteca.bin`
+ * a través de este módulo. El archivo empieza con una cabecera fija
+ * (@ref CabeceraLibros) que guarda un número mágico, la versión del formato,
+ * el número de registros, la clave por la que está ordenado y una suma de control.
+ * A continuación van los registros `Libro` uno tras otro, de modo que el
+ * registro N está en `sizeof(CabeceraLibros) + N * sizeof(Libro)` y se puede
+ * leer directamente sin recorrer el archivo.
+ *
+ * Los archivos antiguos (sin cabecera) se siguen pudiendo leer: se detectan
+ * al abrirlos y se tratan como "legado", calculando el número de registros a
+ * partir del tamaño del archivo.
+ *
+ * Uso típico:
+ * @code
+ * ArchivoLibros a;
+ * Libro l;
+ * if (libros_abrir(&a, NOMBRE_ARCHIVO)) {
+ *     while (libros_leer(&a, &l)) { ... }
+ *     libros_cerrar(&a);
+ * }
+ * @endcode
+ */
+
+// ---------------------------------------------------------------------------
+// CONSTANTES DEL FORMATO
+// ---------------------------------------------------------------------------
+
+/** @brief Número mágico de la cabecera (bytes 'L','I','B','R' en el archivo). */
+#define LIBROS_MAGICO 0x5242494Cu
+
+/** @brief Versión actual del formato binario. */
+#define LIBROS_VERSION 1
+
+/** @brief Versión ficticia asignada a los archivos antiguos sin cabecera. */
+#define LIBROS_VERSION_LEGADO 0
+
+/** @brief Valor inicial de la suma de control (FNV-1a de 32 bits). */
+#define LIBROS_SUMA_INICIAL 2166136261u
+
+/** @brief Modo de apertura de un @ref ArchivoLibros. */
+enum { LIBROS_LECTURA = 0, LIBROS_ESCRITURA = 1 };
+
+/**
+ * @brief Clave por la que están ordenados los registros del archivo.
+ */
+typedef enum {
+    ORDEN_NINGUNO = 0,  /**< Orden de inserción. */
+    ORDEN_ANIO = 1,     /**< Ascendente por año de publicación. */
+    ORDEN_PRECIO = 2,   /**< Ascendente por precio. */
+    ORDEN_TITULO = 3    /**< Ascendente por título. */
+} ClaveOrden;
+
+// ---------------------------------------------------------------------------
+// ESTRUCTURAS
+// ---------------------------------------------------------------------------
+
+/**
+ * @struct CabeceraLibros
+ * @brief Cabecera fija de 32 bytes al inicio de cada archivo de libros.
+ *
+ * Su tamaño es múltiplo de 8 para que los registros que la siguen queden
+ * alineados igual que en memoria.
+ */
+typedef struct {
+    uint32_t magico;         /**< Siempre @ref LIBROS_MAGICO. */
+    uint16_t version;        /**< Versión del formato (@ref LIBROS_VERSION). */
+    uint16_t clave_orden;    /**< Valor de @ref ClaveOrden. */
+    uint32_t tam_registro;   /**< sizeof(Libro) con el que se escribió el archivo. */
+    uint32_t suma_control;   /**< FNV-1a de los bytes de todos los registros. */
+    uint64_t num_registros;  /**< Número de registros Libro del archivo. */
+    uint64_t reservado;      /**< Reservado para futuras versiones (0). */
+} CabeceraLibros;
+
+/**
+ * @struct ArchivoLibros
+ * @brief Descriptor de un archivo de libros abierto.
+ */
+typedef struct {
+    FILE *f;                 /**< Archivo subyacente. */
+    CabeceraLibros cab;      /**< Copia en memoria de la cabecera. */
+    long desplazamiento;     /**< Bytes antes del primer registro (0 en legado). */
+    uint64_t leidos;         /**< Registros consumidos por la lectura secuencial. */
+    int modo;                /**< LIBROS_LECTURA o LIBROS_ESCRITURA. */
+    int fin;                 /**< 1 cuando la lectura secuencial se ha agotado. */
+} ArchivoLibros;
+
+/**
+ * @brief Función de visita usada por @ref libros_recorrer.
+ * @return 0 para seguir recorriendo, distinto de 0 para detenerse.
+ */
+typedef int (*VisitaLibro)(const Libro *libro, long pos, void *ctx);
+
+// ---------------------------------------------------------------------------
+// FUNCIONES INTERNAS
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Acumula bytes en una suma de control FNV-1a de 32 bits.
+ * @param suma Suma acumulada hasta ahora.
+ * @param datos Bytes a añadir.
+ * @param n Número de bytes.
+ * @return Nueva suma de control.
+ */
+static inline uint32_t libros_suma(uint32_t suma, const void *datos, size_t n) {
+    const unsigned char *p = (const unsigned char *)datos;
+    for (size_t i = 0; i < n; i++) {
+        suma ^= p[i];
+        suma *= 16777619u;
+    }
+    return suma;
+}
+
+/**
+ * @brief Escribe la cabecera en memoria al inicio del archivo.
+ * @return 1 si se escribe correctamente, 0 en caso de error.
+ */
+static inline int libros_escribir_cabecera(ArchivoLibros *a) {
+    if (fseek(a->f, 0, SEEK_SET) != 0) return 0;
+    return fwrite(&a->cab, sizeof(CabeceraLibros), 1, a->f) == 1;
+}
+
+// ---------------------------------------------------------------------------
+// APERTURA Y CIERRE
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Crea (o trunca) un archivo de libros vacío listo para añadir registros.
+ * @param a Descriptor a inicializar.
+ * @param nombre Ruta del archivo.
+ * @param clave_orden Orden que tendrán los registros escritos.
+ * @return 1 si se crea correctamente, 0 en caso de error.
+ */
+static inline int libros_crear(ArchivoLibros *a, const char *nombre, ClaveOrden clave_orden) {
+    memset(a, 0, sizeof(*a));
+    a->f = fopen(nombre, "w+b");
+    if (!a->f) {
+        perror(nombre);
+        return 0;
+    }
+    a->cab.magico = LIBROS_MAGICO;
+    a->cab.version = LIBROS_VERSION;
+    a->cab.clave_orden = (uint16_t)clave_orden;
+    a->cab.tam_registro = (uint32_t)sizeof(Libro);
+    a->cab.suma_control = LIBROS_SUMA_INICIAL;
+    a->desplazamiento = (long)sizeof(CabeceraLibros);
+    a->modo = LIBROS_ESCRITURA;
+
+    if (!libros_escribir_cabecera(a)) {
+        perror(nombre);
+        fclose(a->f);
+        a->f = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Indica si una cabecera es coherente con un archivo de @p bytes bytes.
+ *
+ * Un archivo antiguo cuyo primer título empiece por "LIBR" también tiene el
+ * número mágico al principio, así que además se comprueban la versión, el
+ * tamaño de registro, los campos fijos y, si se conoce (@p bytes distinto de
+ * 0), que el tamaño del archivo corresponda al número de registros.
+ *
+ * @return 1 si la cabecera es coherente, 0 en caso contrario.
+ */
+static inline int libros_cabecera_coherente(const CabeceraLibros *cab, uint64_t bytes) {
+    if (cab->magico != LIBROS_MAGICO || cab->version != LIBROS_VERSION ||
+        cab->tam_registro != sizeof(Libro) || cab->clave_orden > ORDEN_TITULO || cab->reservado != 0) {
+        return 0;
+    }
+    return bytes == 0 || bytes - sizeof(CabeceraLibros) == cab->num_registros * sizeof(Libro);
+}
+
+/**
+ * @brief Indica si un archivo de @p bytes bytes puede ser un archivo antiguo.
+ *
+ * Un archivo con cabecera mide 32 + 152·n bytes, que nunca es múltiplo de
+ * `sizeof(Libro)`: una cabecera coherente con el tamaño basta para
+ * distinguir los dos formatos.
+ */
+static inline int libros_tamano_legado(uint64_t bytes) {
+    return bytes % sizeof(Libro) == 0;
+}
+
+/**
+ * @brief Lee y valida la cabecera de un archivo ya abierto.
+ *
+ * Si el archivo no empieza por una cabecera coherente con su tamaño
+ * (@ref libros_cabecera_coherente) se considera un archivo antiguo sin
+ * cabecera y el número de registros se deduce de su tamaño. Un archivo con
+ * número mágico cuyo tamaño no puede ser de legado se rechaza.
+ *
+ * @return 1 si el archivo es válido, 0 si la cabecera es incompatible.
+ */
+static inline int libros_cargar_cabecera(ArchivoLibros *a, const char *nombre) {
+    CabeceraLibros cab;
+    size_t n = fread(&cab, sizeof(CabeceraLibros), 1, a->f);
+
+    if (fseek(a->f, 0, SEEK_END) != 0) return 0;
+    long bytes = ftell(a->f);
+    if (bytes < 0) return 0;
+
+    if (n == 1 && libros_cabecera_coherente(&cab, (uint64_t)bytes)) {
+        if (fseek(a->f, (long)sizeof(CabeceraLibros), SEEK_SET) != 0) return 0;
+        a->cab = cab;
+        a->desplazamiento = (long)sizeof(CabeceraLibros);
+        return 1;
+    }
+    if (n == 1 && cab.magico == LIBROS_MAGICO && !libros_tamano_legado((uint64_t)bytes)) {
+        fprintf(stderr, "%s: formato incompatible (versión %u, registro de %u bytes)\n",
+                nombre, cab.version, cab.tam_registro);
+        return 0;
+    }
+
+    // Archivo antiguo: solo registros Libro consecutivos
+    if (fseek(a->f, 0, SEEK_SET) != 0) return 0;
+
+    memset(&a->cab, 0, sizeof(a->cab));
+    a->cab.magico = LIBROS_MAGICO;
+    a->cab.version = LIBROS_VERSION_LEGADO;
+    a->cab.tam_registro = (uint32_t)sizeof(Libro);
+    a->cab.num_registros = (uint64_t)bytes / sizeof(Libro);
+    a->desplazamiento = 0;
+    return 1;
+}
+
+/**
+ * @brief Abre un archivo de libros existente para lectura.
+ * @param a Descriptor a inicializar.
+ * @param nombre Ruta del archivo.
+ * @return 1 si se abre correctamente, 0 en caso de error.
+ */
+static inline int libros_abrir(ArchivoLibros *a, const char *nombre) {
+    memset(a, 0, sizeof(*a));
+    a->f = fopen(nombre, "rb");
+    if (!a->f) return 0;
+    a->modo = LIBROS_LECTURA;
+    if (!libros_cargar_cabecera(a, nombre)) {
+        fclose(a->f);
+        a->f = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Abre un archivo de libros para añadir registros al final.
+ *
+ * Si el archivo no existe se crea vacío. Los archivos antiguos sin cabecera
+ * no se pueden ampliar: hay que regenerarlos con `text_a_bin_biblioteca`.
+ *
+ * @param a Descriptor a inicializar.
+ * @param nombre Ruta del archivo.
+ * @return 1 si se abre correctamente, 0 en caso de error.
+ */
+static inline int libros_abrir_anexar(ArchivoLibros *a, const char *nombre) {
+    memset(a, 0, sizeof(*a));
+    a->f = fopen(nombre, "r+b");
+    if (!a->f) return libros_crear(a, nombre, ORDEN_NINGUNO);
+
+    if (!libros_cargar_cabecera(a, nombre)) {
+        fclose(a->f);
+        a->f = NULL;
+        return 0;
+    }
+    if (a->cab.version == LIBROS_VERSION_LEGADO) {
+        fprintf(stderr, "%s: archivo sin cabecera, no se puede ampliar.\n", nombre);
+        fclose(a->f);
+        a->f = NULL;
+        return 0;
+    }
+    a->modo = LIBROS_ESCRITURA;
+    a->cab.clave_orden = ORDEN_NINGUNO; // Añadir al final rompe cualquier orden previo
+    return fseek(a->f, 0, SEEK_END) == 0;
+}
+
+/**
+ * @brief Cierra el archivo. En modo escritura actualiza antes la cabecera
+ *        con el número de registros y la suma de control definitivos.
+ * @param a Descriptor abierto.
+ * @return 1 si todo se escribe correctamente, 0 en caso de error.
+ */
+static inline int libros_cerrar(ArchivoLibros *a) {
+    int ok = 1;
+    if (!a->f) return 0;
+    if (a->modo == LIBROS_ESCRITURA) {
+        ok = libros_escribir_cabecera(a);
+    }
+    if (fclose(a->f) != 0) ok = 0;
+    a->f = NULL;
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// ESCRITURA
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Añade un registro al final del archivo.
+ * @return 1 si se escribe correctamente, 0 en caso de error.
+ */
+static inline int libros_anadir(ArchivoLibros *a, const Libro *libro) {
+    if (fwrite(libro, sizeof(Libro), 1, a->f) != 1) return 0;
+    a->cab.suma_control = libros_suma(a->cab.suma_control, libro, sizeof(Libro));
+    a->cab.num_registros++;
+    return 1;
+}
+
+/**
+ * @brief Añade un bloque de registros consecutivos con una sola escritura.
+ * @return Número de registros escritos.
+ */
+static inline size_t libros_anadir_varios(ArchivoLibros *a, const Libro *libros, size_t n) {
+    size_t escritos = fwrite(libros, sizeof(Libro), n, a->f);
+    a->cab.suma_control = libros_suma(a->cab.suma_control, libros, escritos * sizeof(Libro));
+    a->cab.num_registros += escritos;
+    return escritos;
+}
+
+/**
+ * @brief Fija la clave de orden que se guardará en la cabecera al cerrar.
+ */
+static inline void libros_fijar_orden(ArchivoLibros *a, ClaveOrden clave_orden) {
+    a->cab.clave_orden = (uint16_t)clave_orden;
+}
+
+// ---------------------------------------------------------------------------
+// LECTURA SECUENCIAL Y ACCESO DIRECTO
+// ---------------------------------------------------------------------------
+
+/** @brief Número de registros del archivo (leído de la cabecera, sin recorrerlo). */
+static inline long libros_total(const ArchivoLibros *a) {
+    return (long)a->cab.num_registros;
+}
+
+/** @brief Indica si la última lectura secuencial no encontró más registros. */
+static inline int libros_fin(const ArchivoLibros *a) {
+    return a->fin;
+}
+
+/** @brief Indica si se produjo un error de E/S en el archivo. */
+static inline int libros_error(const ArchivoLibros *a) {
+    return ferror(a->f);
+}
+
+/**
+ * @brief Lee el siguiente registro de la lectura secuencial.
+ * @param a Descriptor abierto.
+ * @param libro Destino del registro leído.
+ * @return 1 si se ha leído un registro, 0 al llegar al final o si hay error.
+ */
+static inline int libros_leer(ArchivoLibros *a, Libro *libro) {
+    if (a->leidos >= a->cab.num_registros || fread(libro, sizeof(Libro), 1, a->f) != 1) {
+        a->fin = 1;
+        return 0;
+    }
+    a->leidos++;
+    return 1;
+}
+
+/**
+ * @brief Lee hasta @p max registros consecutivos con una sola llamada a fread.
+ * @return Número de registros leídos.
+ */
+static inline size_t libros_leer_varios(ArchivoLibros *a, Libro *libros, size_t max) {
+    uint64_t quedan = a->cab.num_registros - a->leidos;
+    if (max > quedan) max = (size_t)quedan;
+    size_t n = fread(libros, sizeof(Libro), max, a->f);
+    a->leidos += n;
+    if (n < max || a->leidos >= a->cab.num_registros) a->fin = 1;
+    return n;
+}
+
+/**
+ * @brief Sitúa la lectura secuencial en el registro @p n (índice 0).
+ * @return 1 si la posición es válida, 0 en caso contrario.
+ */
+static inline int libros_ir_a(ArchivoLibros *a, long n) {
+    if (n < 0 || (uint64_t)n > a->cab.num_registros) return 0;
+    if (fseek(a->f, a->desplazamiento + n * (long)sizeof(Libro), SEEK_SET) != 0) return 0;
+    a->leidos = (uint64_t)n;
+    a->fin = 0;
+    return 1;
+}
+
+/**
+ * @brief Lee directamente el registro @p n sin recorrer los anteriores.
+ * @return 1 si se ha leído el registro, 0 si no existe o hay error.
+ */
+static inline int libros_leer_en(ArchivoLibros *a, long n, Libro *libro) {
+    return libros_ir_a(a, n) && libros_leer(a, libro);
+}
+
+/**
+ * @brief Recorre los registros desde la posición actual llamando a @p visitar.
+ * @return Número de registros visitados.
+ */
+static inline long libros_recorrer(ArchivoLibros *a, VisitaLibro visitar, void *ctx) {
+    Libro libro;
+    long visitados = 0;
+    while (libros_leer(a, &libro)) {
+        visitados++;
+        if (visitar(&libro, (long)a->leidos - 1, ctx)) break;
+    }
+    return visitados;
+}
+
+/**
+ * @brief Recalcula la suma de control y la compara con la de la cabecera.
+ *
+ * Deja la lectura secuencial al principio del archivo. Los archivos antiguos
+ * no tienen suma de control y se consideran siempre válidos.
+ *
+ * @return 1 si la suma coincide, 0 si el contenido está dañado.
+ */
+static inline int libros_verificar(ArchivoLibros *a) {
+    if (a->cab.version == LIBROS_VERSION_LEGADO) return 1;
+
+    Libro libro;
+    uint32_t suma = LIBROS_SUMA_INICIAL;
+    libros_ir_a(a, 0);
+    while (libros_leer(a, &libro)) {
+        suma = libros_suma(suma, &libro, sizeof(Libro));
+    }
+    libros_ir_a(a, 0);
+    return suma == a->cab.suma_control;
+}
+
+/** @brief Nombre legible de una clave de orden. */
+static inline const char *libros_nombre_orden(ClaveOrden clave_orden) {
+    switch (clave_orden) {
+        case ORDEN_ANIO:   return "año";
+        case ORDEN_PRECIO: return "precio";
+        case ORDEN_TITULO: return "título";
+        default:           return "ninguno";
+    }
+}
+
+#endif // LIBROS_IO_H
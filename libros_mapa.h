@@ -0,0 +1,191 @@
+#ifndef LIBROS_MAPA_H
+#define LIBROS_MAPA_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "libros_io.h"
+
+/**
+ * @file libros_mapa.h
+ * @brief Lectura sin copias de archivos de libros mediante mmap.
+ *
+ * En lugar de hacer un `fread` (una llamada y una copia) por cada registro,
+ * el archivo completo se proyecta en memoria y se ofrece como un vector
+ * `const Libro*` sobre el que los recorridos evalúan sus condiciones
+ * directamente. Se pide al núcleo lectura anticipada secuencial con
+ * `madvise(MADV_SEQUENTIAL)`.
+ *
+ * Si la entrada no se puede proyectar (por ejemplo una tubería o la entrada
+ * estándar, indicada con el nombre "-"), @ref libros_escanear lee por bloques
+ * de @ref LIBROS_BLOQUE_LECTURA registros con un búfer intermedio.
+ */
+
+/** @brief Registros leídos por cada fread en el modo con búfer (tuberías). */
+#define LIBROS_BLOQUE_LECTURA 4096
+
+/**
+ * @struct VistaLibros
+ * @brief Vista de solo lectura sobre todos los registros de un archivo proyectado.
+ */
+typedef struct {
+    const Libro *registros;  /**< Primer registro (tras la cabecera, si la hay). */
+    long total;              /**< Número de registros accesibles en la vista. */
+    void *base;              /**< Dirección devuelta por mmap. */
+    size_t longitud;         /**< Bytes proyectados. */
+    CabeceraLibros cab;      /**< Cabecera del archivo (o una de legado). */
+} VistaLibros;
+
+/**
+ * @brief Interpreta los primeros bytes de un archivo como cabecera.
+ *
+ * Se siguen las mismas reglas que @ref libros_cargar_cabecera: un número
+ * mágico con una cabecera incoherente es el principio de un título de un
+ * archivo antiguo, salvo que el tamaño del archivo no pueda ser de legado.
+ *
+ * @param datos Inicio del archivo.
+ * @param bytes Bytes disponibles en @p datos.
+ * @param total Tamaño del archivo completo, o 0 si no se conoce (tuberías).
+ * @param cab Cabecera resultante (de legado si no hay una cabecera válida).
+ * @return Desplazamiento del primer registro, o -1 si el formato es incompatible.
+ */
+static inline long libros_interpretar_cabecera(const void *datos, size_t bytes, uint64_t total, CabeceraLibros *cab) {
+    if (bytes >= sizeof(CabeceraLibros)) {
+        memcpy(cab, datos, sizeof(CabeceraLibros));
+        if (libros_cabecera_coherente(cab, total)) return (long)sizeof(CabeceraLibros);
+        if (cab->magico == LIBROS_MAGICO && total != 0 && !libros_tamano_legado(total)) return -1;
+    }
+    memset(cab, 0, sizeof(*cab));
+    cab->magico = LIBROS_MAGICO;
+    cab->version = LIBROS_VERSION_LEGADO;
+    cab->tam_registro = (uint32_t)sizeof(Libro);
+    cab->num_registros = bytes / sizeof(Libro);
+    return 0;
+}
+
+/**
+ * @brief Proyecta un archivo de libros completo en memoria.
+ *
+ * @param nombre Ruta de un archivo regular.
+ * @param v Vista a inicializar.
+ * @return 1 si la proyección se ha realizado, 0 si el archivo no existe,
+ *         no es un archivo regular o tiene un formato incompatible.
+ */
+static inline int libros_mapear(const char *nombre, VistaLibros *v) {
+    struct stat st;
+    memset(v, 0, sizeof(*v));
+
+    int fd = open(nombre, O_RDONLY);
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return 0;
+    }
+
+    v->longitud = (size_t)st.st_size;
+    if (v->longitud > 0) {
+        v->base = mmap(NULL, v->longitud, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (v->base == MAP_FAILED) {
+            close(fd);
+            v->base = NULL;
+            return 0;
+        }
+        madvise(v->base, v->longitud, MADV_SEQUENTIAL);
+    }
+    close(fd); // La proyección sigue siendo válida tras cerrar el descriptor
+
+    long desplazamiento = libros_interpretar_cabecera(v->base, v->longitud, v->longitud, &v->cab);
+    if (desplazamiento < 0) {
+        fprintf(stderr, "%s: formato incompatible.\n", nombre);
+        if (v->base) munmap(v->base, v->longitud);
+        v->base = NULL;
+        return 0;
+    }
+
+    // Nunca se expone más de lo que realmente contiene el archivo
+    uint64_t disponibles = (v->longitud - (size_t)desplazamiento) / sizeof(Libro);
+    if (v->cab.num_registros > disponibles) v->cab.num_registros = disponibles;
+
+    v->registros = (const Libro *)((const char *)v->base + desplazamiento);
+    v->total = (long)v->cab.num_registros;
+    return 1;
+}
+
+/**
+ * @brief Libera la proyección creada con @ref libros_mapear.
+ */
+static inline void libros_desmapear(VistaLibros *v) {
+    if (v->base) munmap(v->base, v->longitud);
+    memset(v, 0, sizeof(*v));
+}
+
+/**
+ * @brief Recorre un flujo no proyectable (tubería) leyendo por bloques.
+ * @return Número de registros visitados, o -1 si el formato es incompatible.
+ */
+static inline long libros_escanear_flujo(FILE *f, VisitaLibro visitar, void *ctx) {
+    Libro *bloque = malloc(sizeof(Libro) * LIBROS_BLOQUE_LECTURA);
+    if (!bloque) {
+        perror("Error al reservar el búfer de lectura");
+        return -1;
+    }
+
+    // Los primeros bytes pueden ser la cabecera o el inicio del primer registro;
+    // si la entrada es un archivo regular su tamaño ayuda a distinguirlos
+    struct stat st;
+    uint64_t total = fstat(fileno(f), &st) == 0 && S_ISREG(st.st_mode) ? (uint64_t)st.st_size : 0;
+    CabeceraLibros cab;
+    size_t previos = fread(bloque, 1, sizeof(CabeceraLibros), f);
+    if (libros_interpretar_cabecera(bloque, previos, total, &cab) < 0) {
+        fprintf(stderr, "Entrada con formato incompatible.\n");
+        free(bloque);
+        return -1;
+    }
+    uint64_t limite = cab.version == LIBROS_VERSION_LEGADO ? UINT64_MAX : cab.num_registros;
+    if (cab.version != LIBROS_VERSION_LEGADO) previos = 0;
+
+    long pos = 0;
+    int detener = 0;
+    while (!detener && (uint64_t)pos < limite) {
+        size_t bytes = previos + fread((char *)bloque + previos, 1,
+                                       sizeof(Libro) * LIBROS_BLOQUE_LECTURA - previos, f);
+        size_t n = bytes / sizeof(Libro);
+        previos = 0;
+        if (n == 0) break;
+        for (size_t i = 0; i < n && (uint64_t)pos < limite; i++, pos++) {
+            if (visitar(&bloque[i], pos, ctx)) { detener = 1; pos++; break; }
+        }
+    }
+
+    free(bloque);
+    return pos;
+}
+
+/**
+ * @brief Recorre todos los registros de un archivo evaluando @p visitar sobre cada uno.
+ *
+ * Usa la vista proyectada cuando es posible (sin copias) y, si no, la
+ * lectura por bloques. El nombre "-" indica la entrada estándar.
+ *
+ * @return Número de registros visitados, o -1 si no se pudo abrir la entrada.
+ */
+static inline long libros_escanear(const char *nombre, VisitaLibro visitar, void *ctx) {
+    VistaLibros v;
+    if (strcmp(nombre, "-") != 0 && libros_mapear(nombre, &v)) {
+        long i;
+        for (i = 0; i < v.total; i++) {
+            if (visitar(&v.registros[i], i, ctx)) { i++; break; }
+        }
+        libros_desmapear(&v);
+        return i;
+    }
+
+    FILE *f = strcmp(nombre, "-") == 0 ? stdin : fopen(nombre, "rb");
+    if (!f) return -1;
+    long n = libros_escanear_flujo(f, visitar, ctx);
+    if (f != stdin) fclose(f);
+    return n;
+}
+
+#endif // LIBROS_MAPA_H
@@ -14,6 +14,12 @@
 #include <string.h>
 #include <strings.h> ///< Para usar strcasecmp() (comparación sin distinción entre mayúsculas y minúsculas)
 #include "common.h"  ///< Incluye la definición de la estructura Libro y constantes globales
+#include "libros_io.h" ///< Lectura del archivo binario con cabecera
+#include "libros_mapa.h" ///< Recorrido sin copias sobre el archivo proyectado con mmap
+#include "indice_prestado.h" ///< Mapas de bits comprimidos sobre el campo prestado
+
+int validar_estado_prestamo(const char *respuesta);
+void imprimir_resumen(int libros_encontrados, const char *respuesta_usuario);
 
 /**
  * @brief Imprime una línea horizontal de separación.
@@ -29,27 +35,16 @@ void imprimir_separador(void) {
 }
 
 /**
- * @brief Lista los libros en función de su estado de préstamo ("Si"/"No").
+ * @brief Pregunta al usuario qué estado de préstamo desea listar.
  *
- * Esta función solicita al usuario un criterio ("Si" para libros prestados,
- * "No" para los disponibles) y recorre el archivo binario `libros_biblioteca.bin`
- * mostrando únicamente los libros cuyo campo `prestado` coincide con el criterio.
+ * Muestra el menú de selección, lee la respuesta de forma segura y la valida
+ * (solo se aceptan "Si" o "No", sin distinguir mayúsculas y minúsculas).
  *
- * El formato de salida se muestra en una tabla con columnas:
- * - POS: posición del libro en el resultado
- * - AUTOR
- * - TÍTULO
- * - PRESTADO
- *
- * La comparación de cadenas se realiza sin distinguir mayúsculas ni minúsculas.
+ * @param respuesta Buffer donde se guarda la respuesta.
+ * @param tam Tamaño del buffer.
+ * @return 1 si la respuesta es válida, 0 en caso contrario.
  */
-void listar_por_prestado(void) {
-    FILE *archivo = NULL;             ///< Puntero al archivo binario
-    Libro libro_actual;               ///< Variable temporal para almacenar cada registro leído
-    char respuesta_usuario[5];        ///< Respuesta del usuario ("Si" o "No")
-    int libros_encontrados = 0;       ///< Contador de resultados encontrados
-    size_t elementos_leidos;          ///< Control del número de elementos leídos por fread()
-
+int pedir_estado_prestamo(char *respuesta, int tam) {
     // 1. Mostrar menú e introducir el criterio de búsqueda
     printf("========================================================================================\n");
     printf("                                LISTADO DE LIBROS POR ESTADO DE PRÉSTAMO\n");
@@ -60,24 +55,56 @@ void listar_por_prestado(void) {
     printf("  Respuesta (Si/No): ");
 
     // Lectura segura de la respuesta del usuario
-    if (fgets(respuesta_usuario, sizeof(respuesta_usuario), stdin) == NULL) {
+    if (fgets(respuesta, tam, stdin) == NULL) {
         printf("\nERROR de lectura de la entrada.\n");
-        return;
+        return 0;
     }
 
     // Elimina el salto de línea al final de la cadena
-    chomp(respuesta_usuario);
+    chomp(respuesta);
+    return validar_estado_prestamo(respuesta);
+}
 
+/**
+ * @brief Comprueba que el criterio sea "Si" o "No" (sin distinguir mayúsculas).
+ * @return 1 si es válido, 0 en caso contrario (mostrando un mensaje de error).
+ */
+int validar_estado_prestamo(const char *respuesta) {
     // 2. Validar la respuesta ingresada (solo se aceptan "Si" o "No")
-    if (strcasecmp(respuesta_usuario, "si") != 0 && strcasecmp(respuesta_usuario, "no") != 0) {
+    if (strcasecmp(respuesta, "si") != 0 && strcasecmp(respuesta, "no") != 0) {
         printf("\nERROR: Respuesta no válida. Debe introducir 'Si' o 'No'.\n");
-        return;
+        return 0;
     }
+    return 1;
+}
+
+/**
+ * @brief Lista los libros en función de su estado de préstamo ("Si"/"No").
+ *
+ * Recorre el archivo binario (por defecto `libros_biblioteca.bin`) mostrando
+ * únicamente los libros cuyo campo `prestado` coincide con el criterio ("Si"
+ * para libros prestados, "No" para los disponibles).
+ *
+ * El formato de salida se muestra en una tabla con columnas:
+ * - POS: posición del libro en el resultado
+ * - AUTOR
+ * - TÍTULO
+ * - PRESTADO
+ *
+ * La comparación de cadenas se realiza sin distinguir mayúsculas ni minúsculas.
+ *
+ * @param nombre_archivo Archivo binario de libros.
+ * @param respuesta_usuario Criterio ya validado ("Si" o "No").
+ */
+void listar_por_prestado(const char *nombre_archivo, const char *respuesta_usuario) {
+    ArchivoLibros archivo;            ///< Archivo binario de libros
+    Libro libro_actual;               ///< Variable temporal para almacenar cada registro leído
+    int libros_encontrados = 0;       ///< Contador de resultados encontrados
 
     // 3. Abrir el archivo binario en modo lectura
-    archivo = fopen(NOMBRE_ARCHIVO, "rb");
-    if (archivo == NULL) {
-        perror("\nERROR al abrir el archivo binario " NOMBRE_ARCHIVO);
+    if (!libros_abrir(&archivo, nombre_archivo)) {
+        fprintf(stderr, "\nERROR al abrir el archivo binario %s: ", nombre_archivo);
+        perror(NULL);
         return;
     }
 
@@ -88,7 +115,7 @@ void listar_por_prestado(void) {
     imprimir_separador();
 
     // 4. Recorrer todos los registros del archivo binario
-    while ((elementos_leidos = fread(&libro_actual, sizeof(Libro), 1, archivo)) == 1) {
+    while (libros_leer(&archivo, &libro_actual)) {
 
         // Comparar el campo prestado con la respuesta del usuario
         if (strcasecmp(libro_actual.prestado, respuesta_usuario) == 0) {
@@ -103,7 +130,14 @@ void listar_por_prestado(void) {
     }
 
     // 5. Cerrar archivo y mostrar resumen
-    fclose(archivo);
+    libros_cerrar(&archivo);
+    imprimir_resumen(libros_encontrados, respuesta_usuario);
+}
+
+/**
+ * @brief Muestra el total de libros encontrados al final del listado.
+ */
+void imprimir_resumen(int libros_encontrados, const char *respuesta_usuario) {
     imprimir_separador();
 
     if (libros_encontrados == 0) {
@@ -115,14 +149,269 @@ void listar_por_prestado(void) {
     printf("========================================================================================\n");
 }
 
+/**
+ * @brief Contexto del listado sobre los registros proyectados.
+ */
+typedef struct {
+    const char *estado;  ///< Criterio "Si" o "No"
+    int encontrados;     ///< Libros mostrados hasta ahora
+} ListadoPrestado;
+
+/**
+ * @brief Condición evaluada directamente sobre cada registro proyectado.
+ * @return Siempre 0: el listado recorre todo el archivo.
+ */
+static int mostrar_si_coincide(const Libro *libro, long pos, void *ctx) {
+    ListadoPrestado *l = (ListadoPrestado *)ctx;
+    (void)pos;
+    if (strcasecmp(libro->prestado, l->estado) == 0) {
+        l->encontrados++;
+        printf("| %-5d | %-30s | %-30s | %-10s |\n",
+               l->encontrados, libro->autor, libro->titulo, libro->prestado);
+    }
+    return 0;
+}
+
+/**
+ * @brief Lista los libros por estado de préstamo sin copiar los registros.
+ *
+ * Igual que @ref listar_por_prestado, pero el archivo se proyecta en memoria
+ * con mmap y la comparación se hace sobre cada registro en su sitio. Si la
+ * entrada no se puede proyectar ("-" o una tubería) se lee por bloques.
+ *
+ * @param nombre_archivo Archivo binario de libros, o "-" para la entrada estándar.
+ * @param respuesta_usuario Criterio ya validado ("Si" o "No").
+ */
+void listar_por_prestado_mapeado(const char *nombre_archivo, const char *respuesta_usuario) {
+    ListadoPrestado l = { .estado = respuesta_usuario, .encontrados = 0 };
+
+    printf("\nListando libros con estado: %s (modo mmap)\n", respuesta_usuario);
+    imprimir_separador();
+    printf("| %-5s | %-30s | %-30s | %-10s |\n", "POS", "AUTOR", "TÍTULO", "PRESTADO");
+    imprimir_separador();
+
+    if (libros_escanear(nombre_archivo, mostrar_si_coincide, &l) < 0) {
+        perror("\nERROR al abrir el archivo binario");
+        return;
+    }
+
+    imprimir_resumen(l.encontrados, respuesta_usuario);
+}
+
+/**
+ * @brief Contexto del listado guiado por el mapa de bits.
+ */
+typedef struct {
+    ArchivoLibros *archivo;  ///< Archivo de datos abierto
+    int encontrados;         ///< Libros mostrados hasta ahora
+    int error;               ///< 1 si falló la lectura de algún registro
+} ListadoIndexado;
+
+/**
+ * @brief Lee y muestra el registro de la posición indicada por el mapa de bits.
+ * @return 0 para seguir, 1 para detener el recorrido si hay un error de lectura.
+ */
+static int mostrar_registro_indexado(long pos, void *ctx) {
+    ListadoIndexado *l = (ListadoIndexado *)ctx;
+    Libro libro;
+    if (!libros_leer_en(l->archivo, pos, &libro)) {
+        l->error = 1;
+        return 1;
+    }
+    l->encontrados++;
+    printf("| %-5d | %-30s | %-30s | %-10s |\n",
+           l->encontrados, libro.autor, libro.titulo, libro.prestado);
+    return 0;
+}
+
+/**
+ * @brief Nombre del índice de préstamo que corresponde a un archivo de datos.
+ *
+ * Se sustituye la extensión `.bin` por `_prestado.idx` (o se añade si no la
+ * tiene), así que para `libros_biblioteca.bin` es @ref NOMBRE_INDICE_PRESTADO.
+ *
+ * @param nombre_archivo Archivo binario de libros.
+ * @param nombre_indice Buffer donde se escribe el nombre.
+ * @param tam Tamaño del buffer.
+ * @return 1 si el nombre cabe en el buffer, 0 en caso contrario.
+ */
+static int nombre_indice_prestado(const char *nombre_archivo, char *nombre_indice, size_t tam) {
+    size_t len = strlen(nombre_archivo);
+    if (len >= 4 && strcmp(nombre_archivo + len - 4, ".bin") == 0) len -= 4;
+    int n = snprintf(nombre_indice, tam, "%.*s_prestado.idx", (int)len, nombre_archivo);
+    return n >= 0 && (size_t)n < tam;
+}
+
+/**
+ * @brief Carga el índice de préstamo si existe y corresponde al archivo abierto.
+ * @param nombre_archivo Ruta del archivo de datos (de ella sale la del índice).
+ * @return 1 si el índice se puede usar, 0 si hay que recorrer el archivo.
+ */
+static int cargar_indice_prestado(IndicePrestado *indice, const ArchivoLibros *archivo, const char *nombre_archivo) {
+    char nombre_indice[FILENAME_MAX];
+    if (!nombre_indice_prestado(nombre_archivo, nombre_indice, sizeof(nombre_indice))) {
+        printf("Aviso: ruta demasiado larga para el índice. Se recorre el archivo completo.\n");
+        return 0;
+    }
+    if (indice_prestado_abrir(indice, nombre_indice)) {
+        if (indice_prestado_vigente(indice, archivo)) return 1;
+        indice_prestado_liberar(indice);
+    }
+    printf("Aviso: índice '%s' ausente o desactualizado (ejecute indexar_biblioteca). "
+           "Se recorre el archivo completo.\n", nombre_indice);
+    return 0;
+}
+
+/**
+ * @brief Lista los libros por estado de préstamo usando el mapa de bits.
+ *
+ * Recorre las posiciones a 1 del mapa comprimido del estado pedido y lee
+ * únicamente esos registros con acceso directo. Si el índice no está
+ * disponible recurre a @ref listar_por_prestado.
+ *
+ * @param nombre_archivo Archivo binario de libros.
+ * @param respuesta_usuario Criterio ya validado ("Si" o "No").
+ */
+void listar_por_prestado_indexado(const char *nombre_archivo, const char *respuesta_usuario) {
+    ArchivoLibros archivo;
+    IndicePrestado indice;
+
+    if (!libros_abrir(&archivo, nombre_archivo)) {
+        fprintf(stderr, "\nERROR al abrir el archivo binario %s: ", nombre_archivo);
+        perror(NULL);
+        return;
+    }
+    if (!cargar_indice_prestado(&indice, &archivo, nombre_archivo)) {
+        libros_cerrar(&archivo);
+        listar_por_prestado(nombre_archivo, respuesta_usuario);
+        return;
+    }
+
+    printf("\nListando libros con estado: %s (índice de mapa de bits)\n", respuesta_usuario);
+    imprimir_separador();
+    printf("| %-5s | %-30s | %-30s | %-10s |\n", "POS", "AUTOR", "TÍTULO", "PRESTADO");
+    imprimir_separador();
+
+    ListadoIndexado l = { .archivo = &archivo, .encontrados = 0, .error = 0 };
+    mapa_bits_recorrer(indice_prestado_mapa(&indice, respuesta_usuario), mostrar_registro_indexado, &l);
+    if (l.error) perror("\nERROR de lectura del archivo binario");
+
+    indice_prestado_liberar(&indice);
+    libros_cerrar(&archivo);
+    imprimir_resumen(l.encontrados, respuesta_usuario);
+}
+
+/**
+ * @brief Cuenta un registro proyectado si coincide con el estado buscado.
+ * @return Siempre 0: el recuento recorre todo el archivo.
+ */
+static int contar_si_coincide(const Libro *libro, long pos, void *ctx) {
+    ListadoPrestado *l = (ListadoPrestado *)ctx;
+    (void)pos;
+    if (strcasecmp(libro->prestado, l->estado) == 0) l->encontrados++;
+    return 0;
+}
+
+/**
+ * @brief Muestra cuántos libros tienen el estado de préstamo indicado.
+ *
+ * Con el índice vigente el recuento es un popcount sobre las palabras del
+ * mapa comprimido, sin leer los registros. Si no, o si la entrada es "-"
+ * (que no tiene índice), recorre el archivo.
+ *
+ * @param nombre_archivo Archivo binario de libros, o "-" para la entrada estándar.
+ * @param respuesta_usuario Criterio ya validado ("Si" o "No").
+ * @return Número de libros con ese estado, o -1 si hubo un error.
+ */
+long contar_por_prestado(const char *nombre_archivo, const char *respuesta_usuario) {
+    ArchivoLibros archivo;
+    IndicePrestado indice;
+    ListadoPrestado l = { .estado = respuesta_usuario, .encontrados = 0 };
+    long total;
+
+    if (strcmp(nombre_archivo, "-") == 0) {
+        total = libros_escanear(nombre_archivo, contar_si_coincide, &l) < 0 ? -1 : l.encontrados;
+    } else if (!libros_abrir(&archivo, nombre_archivo)) {
+        fprintf(stderr, "\nERROR al abrir el archivo binario %s: ", nombre_archivo);
+        perror(NULL);
+        return -1;
+    } else {
+        if (cargar_indice_prestado(&indice, &archivo, nombre_archivo)) {
+            total = mapa_bits_contar(indice_prestado_mapa(&indice, respuesta_usuario));
+            indice_prestado_liberar(&indice);
+        } else {
+            total = libros_escanear(nombre_archivo, contar_si_coincide, &l) < 0 ? -1 : l.encontrados;
+        }
+        libros_cerrar(&archivo);
+    }
+
+    if (total >= 0) printf("Libros con estado %s: %ld\n", respuesta_usuario, total);
+    return total;
+}
+
 /**
  * @brief Función principal del programa.
  *
- * Llama a la función `listar_por_prestado()` para mostrar los libros según su estado de préstamo.
+ * Pide el criterio y muestra los libros según su estado de préstamo.
+ *
+ * Por defecto el listado usa el índice de mapa de bits (`libros_biblioteca_prestado.idx`).
  *
- * @return 0 si el programa se ejecuta correctamente.
+ * Opciones de línea de órdenes:
+ *  - `--contar`: solo muestra cuántos libros tienen el estado indicado.
+ *  - `--lineal`: fuerza el recorrido secuencial clásico con fread (para comparar).
+ *  - `--mmap`: recorre el archivo proyectado en memoria en lugar de usar fread.
+ *  - `--archivo=RUTA`: archivo a consultar en cualquier modo; su índice es
+ *    `RUTA` con `.bin` cambiado por `_prestado.idx`. "-" lee de una tubería
+ *    (solo por recorrido: el listado pasa a `--mmap`). Como la entrada
+ *    estándar son los registros, el criterio es obligatorio en la línea de órdenes.
+ *  - `Si` | `No`: criterio; si se omite se pregunta por consola.
+ *
+ * @return 0 si el programa se ejecuta correctamente, 1 si hay un error.
  */
-int main(void) {
-    listar_por_prestado();
+int main(int argc, char *argv[]) {
+    char respuesta_usuario[5];        ///< Respuesta del usuario ("Si" o "No")
+    const char *archivo = NOMBRE_ARCHIVO;
+    const char *criterio = NULL;
+    int modo_mmap = 0;
+    int modo_lineal = 0;
+    int solo_contar = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--contar") == 0) {
+            solo_contar = 1;
+        } else if (strcmp(argv[i], "--lineal") == 0) {
+            modo_lineal = 1;
+        } else if (strcmp(argv[i], "--mmap") == 0) {
+            modo_mmap = 1;
+        } else if (strncmp(argv[i], "--archivo=", 10) == 0) {
+            archivo = argv[i] + 10;
+        } else {
+            criterio = argv[i];
+        }
+    }
+
+    if (!criterio && strcmp(archivo, "-") == 0) {
+        fprintf(stderr, "Uso: %s [--contar | --mmap] --archivo=- Si|No < libros.bin\n"
+                        "Con --archivo=- la entrada estándar son los registros: indique el criterio.\n",
+                argv[0]);
+        return 1;
+    }
+
+    if (criterio) {
+        snprintf(respuesta_usuario, sizeof(respuesta_usuario), "%s", criterio);
+        if (!validar_estado_prestamo(respuesta_usuario)) return 1;
+    } else if (!pedir_estado_prestamo(respuesta_usuario, sizeof(respuesta_usuario))) {
+        return 1;
+    }
+
+    if (solo_contar) {
+        return contar_por_prestado(archivo, respuesta_usuario) < 0;
+    } else if (modo_mmap || strcmp(archivo, "-") == 0) {
+        listar_por_prestado_mapeado(archivo, respuesta_usuario);
+    } else if (modo_lineal) {
+        listar_por_prestado(archivo, respuesta_usuario);
+    } else {
+        listar_por_prestado_indexado(archivo, respuesta_usuario);
+    }
     return 0;
 }
@@ -0,0 +1,278 @@
+#ifndef MONTICULO_DARIO_H
+#define MONTICULO_DARIO_H
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file monticulo_dario.h
+ * @brief Montículo de mínimos d-ario con las claves separadas de los datos.
+ *
+ * El montículo binario de los gestores guarda un vector de `Salida` (puntero
+ * y clave juntos) y baja los nodos de forma recursiva: cada nivel compara dos
+ * hijos que arrastran sus punteros a la caché. Esta versión:
+ *
+ *  - Tiene @p D hijos por nodo (hijos de i en D·i+1 .. D·i+D), así que la
+ *    altura es log_D(n) en lugar de log2(n).
+ *  - Guarda las claves en un vector denso y los datos en otro paralelo: al
+ *    bajar solo se leen claves, y los D hijos de un nodo son contiguos.
+ *  - Desplaza el vector de claves D-1 posiciones sobre un bloque alineado a
+ *    @ref MONTICULO_LINEA, de modo que los hijos de cada nodo empiezan en un
+ *    múltiplo de D claves: con D = 8 y claves de 8 bytes, una línea de caché.
+ *  - Sube y baja de forma iterativa, moviendo los nodos hacia el hueco y
+ *    colocando el elemento una sola vez al final.
+ *
+ * Para ver los elementos en orden sin extraerlos ni copiar el montículo hay
+ * un recorrido perezoso (`RecorridoMonticulo_S`): guarda una frontera con las
+ * posiciones candidatas, ordenada a su vez como un montículo binario por la
+ * clave. Empieza con la raíz; cada paso saca la menor y mete sus D hijos, así
+ * que los K primeros cuestan O(K·log K) y la frontera no pasa de (D-1)·K+1.
+ *
+ * El módulo se genera para cada tipo de clave y dato con @ref MONTICULO_DEFINIR.
+ * Cada vez que un dato cambia de posición se invoca `MOVER(dato, i)` (con
+ * i = -1 al salir del montículo), para quien necesite localizar sus elementos;
+ * si no, basta con @ref MONTICULO_SIN_POSICION.
+ */
+
+/** @brief Hijos por nodo de los montículos de salidas; se elige al compilar con -DHEAP_ARIDAD=2, 4 u 8. */
+#ifndef HEAP_ARIDAD
+#define HEAP_ARIDAD 4
+#endif
+
+/** @brief Alineación del bloque de claves (una línea de caché). */
+#define MONTICULO_LINEA 64
+
+/** @brief MOVER que no hace nada (montículos sin posiciones guardadas). */
+#define MONTICULO_SIN_POSICION(dato, i) ((void)(dato))
+
+/**
+ * @brief Genera un montículo de mínimos d-ario para claves @p Clave y datos @p Dato.
+ *
+ * Define:
+ *  - `Monticulo_S`: claves[0..tamano), datos[0..tamano), capacidad.
+ *  - `monticulo_S_crear(M, capacidad)` / `monticulo_S_reservar(M, capacidad)`:
+ *    1 si hay memoria para al menos @p capacidad elementos, 0 si no.
+ *  - `monticulo_S_liberar(M)`.
+ *  - `monticulo_S_subir(M, i)` / `monticulo_S_bajar(M, i)`: restauran el orden
+ *    desde la posición i hacia la raíz o hacia las hojas.
+ *  - `monticulo_S_insertar(M, clave, dato)`: 1, o 0 si no hay memoria.
+ *  - `monticulo_S_extraer(M, &clave)`: quita el mínimo (el montículo no debe
+ *    estar vacío) y devuelve su dato.
+ *  - `monticulo_S_quitar(M, i)`: quita el elemento de la posición i.
+ *  - `monticulo_S_cambiar_clave(M, i, clave)`: cambia la clave de la
+ *    posición i en cualquier sentido.
+ *  - `monticulo_S_construir(M)`: ordena de abajo arriba (Floyd) los tamano
+ *    elementos escritos a mano en claves/datos, en O(n).
+ *  - `RecorridoMonticulo_S` con `monticulo_S_recorrido_iniciar(R, M)`,
+ *    `monticulo_S_recorrido_siguiente(R)` y `monticulo_S_recorrido_liberar(R)`:
+ *    cada llamada a siguiente devuelve la posición en M del siguiente elemento
+ *    en orden de clave, -1 al terminar o -2 si falta memoria. M no debe
+ *    cambiar mientras dure el recorrido.
+ *
+ * @param S Sufijo de los nombres generados.
+ * @param Clave Tipo de las claves (con <).
+ * @param Dato Tipo de los datos asociados.
+ * @param D Hijos por nodo (2 o más).
+ * @param MOVER Macro o función `MOVER(dato, i)` llamada al colocar un dato en i.
+ */
+#define MONTICULO_DEFINIR(S, Clave, Dato, D, MOVER)                                         \
+                                                                                            \
+typedef struct {                                                                            \
+    Clave *claves;     /* Claves (desplazadas D-1 posiciones dentro de bloque). */          \
+    Dato *datos;       /* Dato de cada clave, en la misma posición. */                      \
+    Clave *bloque;     /* Bloque alineado que contiene las claves. */                       \
+    int tamano;        /* Elementos en el montículo. */                                     \
+    int capacidad;     /* Elementos que caben sin volver a reservar. */                     \
+} Monticulo_##S;                                                                            \
+                                                                                            \
+static inline int monticulo_##S##_reservar(Monticulo_##S *m, int capacidad) {              \
+    if (capacidad <= m->capacidad) return 1;                                                \
+    size_t bytes = sizeof(Clave) * ((size_t)capacidad + (D) - 1);                           \
+    bytes = (bytes + MONTICULO_LINEA - 1) / MONTICULO_LINEA * MONTICULO_LINEA;              \
+    Clave *bloque = aligned_alloc(MONTICULO_LINEA, bytes);                                  \
+    Dato *datos = realloc(m->datos, sizeof(Dato) * (size_t)capacidad);                      \
+    if (datos != NULL) m->datos = datos;                                                    \
+    if (bloque == NULL || datos == NULL) {                                                  \
+        free(bloque);                                                                       \
+        return 0;                                                                           \
+    }                                                                                       \
+    if (m->tamano > 0) memcpy(bloque + (D) - 1, m->claves, sizeof(Clave) * m->tamano);      \
+    free(m->bloque);                                                                        \
+    m->bloque = bloque;                                                                     \
+    m->claves = bloque + (D) - 1;                                                           \
+    m->capacidad = capacidad;                                                               \
+    return 1;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline int monticulo_##S##_crear(Monticulo_##S *m, int capacidad) {                 \
+    memset(m, 0, sizeof(*m));                                                               \
+    return monticulo_##S##_reservar(m, capacidad);                                          \
+}                                                                                           \
+                                                                                            \
+static inline void monticulo_##S##_liberar(Monticulo_##S *m) {                             \
+    free(m->bloque); free(m->datos);                                                        \
+    memset(m, 0, sizeof(*m));                                                               \
+}                                                                                           \
+                                                                                            \
+static inline void monticulo_##S##_subir(Monticulo_##S *m, int i) {                        \
+    Clave *c = m->claves;                                                                   \
+    Clave clave = c[i];                                                                     \
+    Dato dato = m->datos[i];                                                                \
+    while (i > 0) {                                                                         \
+        int padre = (i - 1) / (D);                                                          \
+        if (!(clave < c[padre])) break;                                                     \
+        c[i] = c[padre];                                                                    \
+        m->datos[i] = m->datos[padre];                                                      \
+        MOVER(m->datos[i], i);                                                              \
+        i = padre;                                                                          \
+    }                                                                                       \
+    c[i] = clave;                                                                           \
+    m->datos[i] = dato;                                                                     \
+    MOVER(dato, i);                                                                         \
+}                                                                                           \
+                                                                                            \
+static inline void monticulo_##S##_bajar(Monticulo_##S *m, int i) {                        \
+    Clave *c = m->claves;                                                                   \
+    int n = m->tamano;                                                                      \
+    Clave clave = c[i];                                                                     \
+    Dato dato = m->datos[i];                                                                \
+    for (;;) {                                                                              \
+        int primero = (D) * i + 1;                                                          \
+        if (primero >= n) break;                                                            \
+        int min = primero;                                                                  \
+        if (primero + (D) <= n) {                                                           \
+            /* Nodo completo: D comparaciones sobre claves contiguas */                     \
+            for (int j = 1; j < (D); j++) {                                                 \
+                if (c[primero + j] < c[min]) min = primero + j;                             \
+            }                                                                               \
+        } else {                                                                            \
+            for (int j = primero + 1; j < n; j++) {                                         \
+                if (c[j] < c[min]) min = j;                                                 \
+            }                                                                               \
+        }                                                                                   \
+        if (!(c[min] < clave)) break;                                                       \
+        c[i] = c[min];                                                                      \
+        m->datos[i] = m->datos[min];                                                        \
+        MOVER(m->datos[i], i);                                                              \
+        i = min;                                                                            \
+    }                                                                                       \
+    c[i] = clave;                                                                           \
+    m->datos[i] = dato;                                                                     \
+    MOVER(dato, i);                                                                         \
+}                                                                                           \
+                                                                                            \
+static inline int monticulo_##S##_insertar(Monticulo_##S *m, Clave clave, Dato dato) {     \
+    if (m->tamano == m->capacidad &&                                                        \
+        !monticulo_##S##_reservar(m, m->capacidad > 0 ? m->capacidad * 2 : 16)) return 0;   \
+    m->claves[m->tamano] = clave;                                                           \
+    m->datos[m->tamano] = dato;                                                             \
+    monticulo_##S##_subir(m, m->tamano++);                                                  \
+    return 1;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline Dato monticulo_##S##_extraer(Monticulo_##S *m, Clave *clave) {               \
+    Dato dato = m->datos[0];                                                                \
+    if (clave != NULL) *clave = m->claves[0];                                               \
+    m->tamano--;                                                                            \
+    if (m->tamano > 0) {                                                                    \
+        m->claves[0] = m->claves[m->tamano];                                                \
+        m->datos[0] = m->datos[m->tamano];                                                  \
+        monticulo_##S##_bajar(m, 0);                                                        \
+    }                                                                                       \
+    MOVER(dato, -1);                                                                        \
+    return dato;                                                                            \
+}                                                                                           \
+                                                                                            \
+static inline void monticulo_##S##_quitar(Monticulo_##S *m, int i) {                       \
+    Dato dato = m->datos[i];                                                                \
+    m->tamano--;                                                                            \
+    if (i < m->tamano) {                                                                    \
+        /* El último ocupa el hueco y sube o baja según su clave */                         \
+        m->claves[i] = m->claves[m->tamano];                                                \
+        m->datos[i] = m->datos[m->tamano];                                                  \
+        if (i > 0 && m->claves[i] < m->claves[(i - 1) / (D)]) monticulo_##S##_subir(m, i);  \
+        else monticulo_##S##_bajar(m, i);                                                   \
+    }                                                                                       \
+    MOVER(dato, -1);                                                                        \
+}                                                                                           \
+                                                                                            \
+static inline void monticulo_##S##_cambiar_clave(Monticulo_##S *m, int i, Clave clave) {   \
+    int sube = clave < m->claves[i];                                                        \
+    m->claves[i] = clave;                                                                   \
+    if (sube) monticulo_##S##_subir(m, i);                                                  \
+    else monticulo_##S##_bajar(m, i);                                                       \
+}                                                                                           \
+                                                                                            \
+static inline void monticulo_##S##_construir(Monticulo_##S *m) {                           \
+    for (int i = 0; i < m->tamano; i++) MOVER(m->datos[i], i);                              \
+    for (int i = (m->tamano - 2) / (D); i >= 0 && m->tamano > 1; i--) {                     \
+        monticulo_##S##_bajar(m, i);                                                        \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+typedef struct {                                                                            \
+    const Monticulo_##S *m;  /* Montículo recorrido (no se modifica). */                    \
+    int *frontera;           /* Posiciones candidatas, montículo binario por clave. */      \
+    int tamano;              /* Posiciones en la frontera. */                               \
+    int capacidad;           /* Posiciones que caben en la frontera. */                     \
+} RecorridoMonticulo_##S;                                                                   \
+                                                                                            \
+static inline void monticulo_##S##_recorrido_meter(RecorridoMonticulo_##S *r, int p) {     \
+    const Clave *c = r->m->claves;                                                          \
+    int i = r->tamano++;                                                                    \
+    while (i > 0 && c[p] < c[r->frontera[(i - 1) / 2]]) {                                   \
+        r->frontera[i] = r->frontera[(i - 1) / 2];                                          \
+        i = (i - 1) / 2;                                                                    \
+    }                                                                                       \
+    r->frontera[i] = p;                                                                     \
+}                                                                                           \
+                                                                                            \
+static inline int monticulo_##S##_recorrido_iniciar(RecorridoMonticulo_##S *r,             \
+                                                    const Monticulo_##S *m) {               \
+    r->m = m;                                                                               \
+    r->tamano = 0;                                                                          \
+    r->capacidad = 4 * (D);                                                                 \
+    r->frontera = malloc(sizeof(int) * (size_t)r->capacidad);                               \
+    if (r->frontera == NULL) return 0;                                                      \
+    if (m->tamano > 0) r->frontera[r->tamano++] = 0;                                        \
+    return 1;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline void monticulo_##S##_recorrido_liberar(RecorridoMonticulo_##S *r) {          \
+    free(r->frontera);                                                                      \
+    r->frontera = NULL;                                                                     \
+    r->tamano = r->capacidad = 0;                                                           \
+}                                                                                           \
+                                                                                            \
+static inline int monticulo_##S##_recorrido_siguiente(RecorridoMonticulo_##S *r) {         \
+    if (r->tamano == 0) return -1;                                                          \
+    if (r->tamano + (D) > r->capacidad) {                                                   \
+        int *f = realloc(r->frontera, sizeof(int) * (size_t)r->capacidad * 2);              \
+        if (f == NULL) return -2;                                                           \
+        r->frontera = f;                                                                    \
+        r->capacidad *= 2;                                                                  \
+    }                                                                                       \
+                                                                                            \
+    /* Se saca la menor posición de la frontera (bajada del binario) */                     \
+    const Clave *c = r->m->claves;                                                          \
+    int *f = r->frontera;                                                                   \
+    int p = f[0], ultima = f[--r->tamano], i = 0;                                           \
+    for (;;) {                                                                              \
+        int h = 2 * i + 1;                                                                  \
+        if (h >= r->tamano) break;                                                          \
+        if (h + 1 < r->tamano && c[f[h + 1]] < c[f[h]]) h++;                                \
+        if (!(c[f[h]] < c[ultima])) break;                                                  \
+        f[i] = f[h];                                                                        \
+        i = h;                                                                              \
+    }                                                                                       \
+    if (r->tamano > 0) f[i] = ultima;                                                       \
+                                                                                            \
+    /* Sus hijos pasan a ser candidatos */                                                  \
+    int primero = (D) * p + 1;                                                              \
+    for (int j = primero; j < primero + (D) && j < r->m->tamano; j++) {                     \
+        monticulo_##S##_recorrido_meter(r, j);                                              \
+    }                                                                                       \
+    return p;                                                                               \
+}
+
+#endif
@@ -4,11 +4,19 @@
  *
  * El programa genera un vector de números aleatorios, los ordena y permite
  * al usuario introducir un valor para realizar una búsqueda binaria.
+ *
+ * Con el argumento `--comprobar` solo comprueba la ordenación con casos fijos
+ * (valores NaN, -0.0, duplicados) y vectores aleatorios, y termina.
  */
 
 #include <stdio.h> 
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
 #include <time.h> 
+#include "ordenacion_pdq.h"
+#include "busqueda_eytzinger.h"
 
 /**
  * @brief Estructura que representa una asignatura con su nombre,
@@ -22,58 +30,33 @@ typedef struct{
 
 
 /**
- * @brief Ordena un vector mediante el método de inserción directa.
+ * @brief Ordena un vector de menor a mayor con pdqsort (ver ordenacion_pdq.h).
+ *
+ * O(n log n) en el peor caso y O(n) si el vector ya está ordenado.
  *
  * @param v Vector de números a ordenar.
  * @param n Cantidad de elementos del vector.
  */
 void ordenacion(double *v, int n){
-    int i, j; 
-    double aux; 
-    
-    for (i = 0; i < n; i++){
-        aux = v[i];
-        j = i; 
-        
-        while (j > 0 && v[j-1] > aux){
-            v[j] = v[j-1]; 
-            j--; 
-        }
-        
-        v[j] = aux;
-    }
+    ordenar_doubles(v, n); 
 }
 
 
 /**
- * @brief Realiza una búsqueda binaria sobre un vector ordenado.
+ * @brief Realiza una búsqueda binaria sin saltos sobre un vector ordenado.
+ *
+ * Ver busqueda_sin_saltos_double() en busqueda_eytzinger.h.
  *
  * @param v Vector ordenado donde se realiza la búsqueda.
  * @param n Número de elementos del vector.
  * @param x Valor a buscar.
  *
- * @return int Devuelve la posición donde se encontró el valor,
- *             o -1 si el valor no se encuentra.
+ * @return int Devuelve la posición donde se encontró el valor (la primera
+ *             si está repetido), o -1 si el valor no se encuentra.
  */
 int binaria(double *v, int n, double x){
-
-    int izq = 0, der = n - 1;
-    int cen;
-
-    while (izq <= der){
-        cen = (izq + der) / 2;
-
-        if (v[cen] == x){
-            return cen;
-        }
-        else if (v[cen] > x){
-            der = cen - 1;
-        }
-        else{
-            izq = cen + 1;
-        }
-    }
-    return -1;
+    int comps; 
+    return busqueda_sin_saltos_double(v, n, x, &comps); 
 }
 
 
@@ -104,6 +87,104 @@ void imprimir(double *v, int n){
 }
 
 
+/**
+ * @brief Compara dos doubles por su representación en bits (para qsort).
+ *
+ * Así los NaN y -0.0 cuentan como valores distintos al comprobar que el
+ * resultado es una permutación de la entrada.
+ */
+int comparar_bits(const void *a, const void *b){
+    uint64_t x, y; 
+    memcpy(&x, a, sizeof(x)); 
+    memcpy(&y, b, sizeof(y)); 
+    return (x > y) - (x < y); 
+}
+
+
+/**
+ * @brief Ordena una copia de v[0..n) y comprueba el resultado.
+ *
+ * El resultado debe ser una permutación de la entrada y, si no hay NaN,
+ * estar en orden ascendente.
+ *
+ * @return int 1 si es correcto, 0 si no (mostrando el motivo).
+ */
+int comprobar_caso(const double *v, int n, const char *nombre){
+    double *ordenado = malloc(sizeof(double) * (n > 0 ? n : 1)); 
+    double *original = malloc(sizeof(double) * (n > 0 ? n : 1)); 
+    if (!ordenado || !original){
+        free(ordenado); 
+        free(original); 
+        printf("Sin memoria para el caso %s\n", nombre); 
+        return 0; 
+    }
+    memcpy(ordenado, v, sizeof(double) * n); 
+    memcpy(original, v, sizeof(double) * n); 
+    ordenacion(ordenado, n); 
+
+    int hay_nan = 0; 
+    for (int i = 0; i < n; i++) hay_nan |= isnan(v[i]); 
+    int ok = 1; 
+    for (int i = 1; i < n && !hay_nan; i++){
+        if (ordenado[i] < ordenado[i - 1]) ok = 0; 
+    }
+    if (!ok) printf("FALLO (%s, n=%d): el resultado no está ordenado\n", nombre, n); 
+
+    qsort(original, n, sizeof(double), comparar_bits); 
+    qsort(ordenado, n, sizeof(double), comparar_bits); 
+    if (ok && memcmp(original, ordenado, sizeof(double) * n) != 0){
+        printf("FALLO (%s, n=%d): el resultado no es una permutación de la entrada\n", nombre, n); 
+        ok = 0; 
+    }
+
+    free(ordenado); 
+    free(original); 
+    return ok; 
+}
+
+
+/**
+ * @brief Comprueba ordenacion() con casos fijos y vectores aleatorios.
+ *
+ * @return int Número de casos que fallan (0 si todo es correcto).
+ */
+int comprobar_ordenacion(void){
+    int fallos = 0; 
+    double v[512]; 
+
+    // 14 elementos con 6 NaN: con la red AVX2 un NaN acababa en el relleno
+    for (int i = 0; i < 14; i++) v[i] = i < 6 ? NAN : 14 - i; 
+    fallos += !comprobar_caso(v, 14, "14 con 6 NaN"); 
+
+    for (int i = 0; i < 16; i++) v[i] = NAN; 
+    fallos += !comprobar_caso(v, 16, "todo NaN"); 
+
+    for (int i = 0; i < 16; i++) v[i] = i % 3 == 0 ? NAN : (i % 2 ? -0.0 : 0.0); 
+    fallos += !comprobar_caso(v, 16, "NaN, 0.0 y -0.0"); 
+
+    for (int i = 0; i < 512; i++) v[i] = 512 - i; 
+    fallos += !comprobar_caso(v, 512, "inverso"); 
+
+    for (int i = 0; i < 512; i++) v[i] = i % 7; 
+    fallos += !comprobar_caso(v, 512, "duplicados"); 
+
+    // Vectores aleatorios de todos los tamaños, la mitad con algún NaN
+    srand(1); 
+    for (int prueba = 0; prueba < 20000; prueba++){
+        int n = rand() % 512; 
+        int con_nan = prueba % 2; 
+        for (int i = 0; i < n; i++){
+            v[i] = con_nan && rand() % 10 == 0 ? NAN : rand() % 100 - 50; 
+        }
+        fallos += !comprobar_caso(v, n, con_nan ? "aleatorio con NaN" : "aleatorio"); 
+    }
+
+    if (fallos == 0) printf("Ordenación correcta en todos los casos.\n"); 
+    else printf("%d casos fallidos.\n", fallos); 
+    return fallos; 
+}
+
+
 /**
  * @brief Función principal del programa.
  *
@@ -112,8 +193,12 @@ void imprimir(double *v, int n){
  *
  * @return int Devuelve 0 si el programa finaliza correctamente.
  */
-int main () {
+int main (int argc, char *argv[]) {
     
+    if (argc > 1 && strcmp(argv[1], "--comprobar") == 0){
+        return comprobar_ordenacion() != 0; 
+    }
+
     srand(time(NULL));
 
     int n = 10; 
@@ -0,0 +1,713 @@
+#ifndef ORDENACION_EXTERNA_H
+#define ORDENACION_EXTERNA_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include "libros_io.h"
+#include "seleccion_reemplazo.h"
+#include "ordenacion_radix.h"
+
+/**
+ * @file ordenacion_externa.h
+ * @brief Ordenación externa de archivos de libros con mezcla de K vías.
+ *
+ * El proceso tiene dos fases:
+ *
+ *  1. Generación de secuencias por selección con reemplazo (ver
+ *     `seleccion_reemplazo.h`) con un búfer de M registros: secuencias de
+ *     2·M registros de media. Para año y precio se puede optar por cargar
+ *     bloques de M registros y ordenarlos por residuos (ver
+ *     `ordenacion_radix.h`): secuencias de M registros, pero más baratas de
+ *     generar. Si el archivo cabe en M registros se escribe ordenado
+ *     directamente y no hay más pasadas.
+ *  2. Mezcla de K secuencias a la vez con un árbol de perdedores (árbol de
+ *     torneo): cada registro emitido cuesta log2(K) comparaciones. Cada
+ *     secuencia se lee con su propio búfer de M/(K+1) registros.
+ *
+ * La mezcla puede ser:
+ *
+ *  - Multivía equilibrada (por defecto): en cada pasada se mezclan grupos de
+ *    K secuencias de un archivo temporal en otro, hasta que quedan K o menos,
+ *    que se mezclan directamente en el archivo de salida. Con N secuencias
+ *    iniciales hacen falta ceil(log_K N) pasadas.
+ *  - Polifásica: las secuencias se reparten entre K cintas (archivos
+ *    temporales) según una distribución de Fibonacci generalizada, completada
+ *    con secuencias ficticias (algoritmo D de Knuth), y cada fase mezcla en la
+ *    cinta vacía hasta que se agota una de las entradas. Solo se mueve en cada
+ *    fase parte de los datos, con K+1 archivos en total.
+ *
+ * Los registros se pueden ordenar por año, precio o título.
+ */
+
+/** @brief Registros en memoria por defecto (M), unos 40 MB. */
+#define ORDEN_EXT_MEMORIA_DEFECTO (1L << 18)
+
+/** @brief Secuencias mezcladas a la vez por defecto (K). */
+#define ORDEN_EXT_FAN_IN_DEFECTO 16
+
+/** @brief Máximo de secuencias mezcladas a la vez. */
+#define ORDEN_EXT_FAN_IN_MAX 256
+
+/** @brief Patrón de nombre de los archivos temporales (cintas). */
+#define ORDEN_EXT_TEMPORAL "ordext_%d.tmp"
+
+/**
+ * @struct OpcionesOrdenacion
+ * @brief Parámetros de la ordenación externa.
+ */
+typedef struct {
+    ClaveOrden clave;   /**< Campo por el que se ordena. */
+    long memoria;       /**< Registros en memoria (M). */
+    int fan_in;         /**< Secuencias mezcladas a la vez (K). */
+    int polifasica;     /**< 1 para usar la distribución polifásica. */
+    int radix;          /**< 1 para generar las secuencias por residuos (año y precio). */
+} OpcionesOrdenacion;
+
+/**
+ * @struct EstadisticasOrdenacion
+ * @brief Datos del trabajo realizado por la ordenación externa.
+ */
+typedef struct {
+    long registros;            /**< Registros ordenados. */
+    long secuencias;           /**< Secuencias generadas en la primera fase. */
+    int pasadas;               /**< Pasadas (multivía) o fases (polifásica) de mezcla. */
+    long long escritos;        /**< Registros escritos en total, incluida la salida. */
+} EstadisticasOrdenacion;
+
+/**
+ * @struct Cinta
+ * @brief Archivo temporal con una cola de secuencias escritas una tras otra.
+ */
+typedef struct {
+    int fd;                /**< Descriptor del archivo temporal. */
+    char nombre[32];       /**< Nombre del archivo temporal. */
+    long *longitudes;      /**< Cola con la longitud de cada secuencia (0 = ficticia). */
+    long cabeza;           /**< Primera secuencia pendiente de la cola. */
+    long num;              /**< Fin de la cola. */
+    long capacidad;        /**< Huecos reservados en la cola. */
+    off_t lectura;         /**< Byte donde empieza la primera secuencia pendiente. */
+} Cinta;
+
+/**
+ * @struct LectorSecuencia
+ * @brief Lectura de una secuencia con un búfer propio.
+ */
+typedef struct {
+    int fd;                /**< Archivo de la secuencia. */
+    off_t pos;             /**< Siguiente byte por leer. */
+    long restantes;        /**< Registros de la secuencia aún no cargados en el búfer. */
+    Libro *buf;            /**< Búfer de lectura. */
+    long cap, n, i;        /**< Capacidad, registros cargados y siguiente registro. */
+    int error;             /**< 1 si falló alguna lectura. */
+} LectorSecuencia;
+
+/**
+ * @struct SalidaRegistros
+ * @brief Escritura con búfer hacia una cinta o hacia el archivo de salida final.
+ */
+typedef struct {
+    int fd;                /**< Cinta de destino (si @ref archivo es NULL). */
+    ArchivoLibros *archivo;/**< Archivo de salida final, o NULL. */
+    Libro *buf;            /**< Búfer de escritura. */
+    long cap, n;           /**< Capacidad y registros pendientes. */
+    long long escritos;    /**< Registros escritos desde el principio. */
+    int error;             /**< 1 si falló alguna escritura. */
+} SalidaRegistros;
+
+// ---------------------------------------------------------------------------
+// CINTAS
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Crea (vacía) el archivo temporal número @p num.
+ * @return 1 si se crea correctamente, 0 en caso de error.
+ */
+static inline int cinta_abrir(Cinta *c, int num) {
+    memset(c, 0, sizeof(*c));
+    snprintf(c->nombre, sizeof(c->nombre), ORDEN_EXT_TEMPORAL, num);
+    c->fd = open(c->nombre, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (c->fd < 0) {
+        perror(c->nombre);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Descarta el contenido de la cinta para volver a escribir en ella.
+ */
+static inline int cinta_vaciar(Cinta *c) {
+    c->cabeza = c->num = 0;
+    c->lectura = 0;
+    return ftruncate(c->fd, 0) == 0 && lseek(c->fd, 0, SEEK_SET) == 0;
+}
+
+/**
+ * @brief Cierra y borra el archivo temporal.
+ */
+static inline void cinta_cerrar(Cinta *c) {
+    if (c->fd >= 0) {
+        close(c->fd);
+        remove(c->nombre);
+    }
+    free(c->longitudes);
+    c->longitudes = NULL;
+    c->fd = -1;
+}
+
+/** @brief Secuencias pendientes de leer en la cinta (incluidas las ficticias). */
+static inline long cinta_pendientes(const Cinta *c) {
+    return c->num - c->cabeza;
+}
+
+/**
+ * @brief Añade una secuencia de @p longitud registros al final de la cola.
+ * @return 1 si se añade, 0 si no hay memoria.
+ */
+static inline int cinta_encolar(Cinta *c, long longitud) {
+    if (c->num == c->capacidad) {
+        long nueva = c->capacidad ? c->capacidad * 2 : 64;
+        long *p = realloc(c->longitudes, sizeof(long) * nueva);
+        if (!p) return 0;
+        c->longitudes = p;
+        c->capacidad = nueva;
+    }
+    c->longitudes[c->num++] = longitud;
+    return 1;
+}
+
+/**
+ * @brief Coloca @p ficticias secuencias vacías delante de las de la cinta.
+ * @return 1 si se añaden, 0 si no hay memoria.
+ */
+static inline int cinta_anteponer_ficticias(Cinta *c, long ficticias) {
+    long reales = cinta_pendientes(c);
+    for (long i = 0; i < ficticias; i++) {
+        if (!cinta_encolar(c, 0)) return 0;
+    }
+    memmove(&c->longitudes[c->cabeza + ficticias], &c->longitudes[c->cabeza], sizeof(long) * reales);
+    for (long i = 0; i < ficticias; i++) c->longitudes[c->cabeza + i] = 0;
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+// LECTURA Y ESCRITURA CON BÚFER
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Prepara un lector para la secuencia de @p longitud registros que empieza en @p pos.
+ */
+static inline void lector_iniciar(LectorSecuencia *l, int fd, off_t pos, long longitud) {
+    l->fd = fd;
+    l->pos = pos;
+    l->restantes = longitud;
+    l->n = l->i = 0;
+    l->error = 0;
+}
+
+/**
+ * @brief Carga en el búfer el siguiente bloque de la secuencia (sin pasar a la siguiente).
+ */
+static inline void lector_rellenar(LectorSecuencia *l) {
+    long pedir = l->restantes < l->cap ? l->restantes : l->cap;
+    size_t total = sizeof(Libro) * (size_t)pedir, hechos = 0;
+
+    while (hechos < total) {
+        ssize_t r = pread(l->fd, (char *)l->buf + hechos, total - hechos, l->pos + (off_t)hechos);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) {
+            l->error = 1;
+            pedir = (long)(hechos / sizeof(Libro));
+            break;
+        }
+        hechos += (size_t)r;
+    }
+    l->pos += (off_t)(sizeof(Libro) * (size_t)pedir);
+    l->restantes = l->error ? 0 : l->restantes - pedir;
+    l->n = pedir;
+    l->i = 0;
+}
+
+/**
+ * @brief Registro actual de la secuencia.
+ * @return Puntero al registro dentro del búfer, o NULL si la secuencia se ha agotado.
+ */
+static inline const Libro *lector_actual(LectorSecuencia *l) {
+    if (l->i == l->n) {
+        if (l->restantes == 0) return NULL;
+        lector_rellenar(l);
+        if (l->n == 0) return NULL;
+    }
+    return &l->buf[l->i];
+}
+
+/**
+ * @brief Vuelca a disco los registros pendientes del búfer de salida.
+ */
+static inline void salida_vaciar(SalidaRegistros *s) {
+    if (s->n == 0) return;
+    if (s->archivo) {
+        if (libros_anadir_varios(s->archivo, s->buf, (size_t)s->n) != (size_t)s->n) s->error = 1;
+    } else {
+        size_t total = sizeof(Libro) * (size_t)s->n, hechos = 0;
+        while (hechos < total) {
+            ssize_t w = write(s->fd, (const char *)s->buf + hechos, total - hechos);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) { s->error = 1; break; }
+            hechos += (size_t)w;
+        }
+    }
+    s->escritos += s->n;
+    s->n = 0;
+}
+
+/**
+ * @brief Añade un registro al búfer de salida.
+ * @return 1 si no ha habido errores de escritura, 0 en caso contrario.
+ */
+static inline int salida_poner(SalidaRegistros *s, const Libro *libro) {
+    s->buf[s->n++] = *libro;
+    if (s->n == s->cap) salida_vaciar(s);
+    return !s->error;
+}
+
+/**
+ * @brief Cambia el destino de la salida, volcando antes lo pendiente.
+ */
+static inline void salida_redirigir(SalidaRegistros *s, int fd, ArchivoLibros *archivo) {
+    salida_vaciar(s);
+    s->fd = fd;
+    s->archivo = archivo;
+}
+
+// ---------------------------------------------------------------------------
+// MEZCLA CON ÁRBOL DE PERDEDORES
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Indica si la secuencia @p a gana (sale antes) frente a la @p b.
+ *
+ * Una secuencia agotada pierde siempre; a igualdad de clave gana la de menor
+ * índice, lo que hace la mezcla estable.
+ */
+static inline int perdedores_gana(const Libro *const *cabeza, CompararLibros cmp, int a, int b) {
+    if (!cabeza[a]) return 0;
+    if (!cabeza[b]) return 1;
+    int c = cmp(cabeza[a], cabeza[b]);
+    return c < 0 || (c == 0 && a < b);
+}
+
+/**
+ * @brief Mezcla @p k secuencias en una sola con un árbol de perdedores.
+ *
+ * Los nodos internos 1..k-1 guardan el perdedor de cada partido y
+ * `perdedor[0]` el ganador absoluto. Tras emitir el ganador solo se
+ * rejuegan los partidos de su camino hasta la raíz.
+ *
+ * @param lectores Secuencias de entrada, ya iniciadas.
+ * @param k Número de secuencias.
+ * @param cmp Clave de ordenación.
+ * @param salida Destino de los registros mezclados.
+ * @return Registros escritos, o -1 si hubo un error de E/S o de memoria.
+ */
+static inline long mezclar_secuencias(LectorSecuencia *lectores, int k, CompararLibros cmp, SalidaRegistros *salida) {
+    const Libro **cabeza = malloc(sizeof(const Libro *) * k);
+    int *perdedor = malloc(sizeof(int) * k);
+    int *ganador = malloc(sizeof(int) * 2 * k);
+    if (!cabeza || !perdedor || !ganador) {
+        free(cabeza); free(perdedor); free(ganador);
+        return -1;
+    }
+
+    // 1. Jugar el torneo inicial de abajo arriba (hojas en k..2k-1)
+    for (int i = 0; i < k; i++) {
+        cabeza[i] = lector_actual(&lectores[i]);
+        ganador[k + i] = i;
+    }
+    for (int n = k - 1; n >= 1; n--) {
+        int a = ganador[2 * n], b = ganador[2 * n + 1];
+        if (perdedores_gana(cabeza, cmp, a, b)) { ganador[n] = a; perdedor[n] = b; }
+        else { ganador[n] = b; perdedor[n] = a; }
+    }
+    perdedor[0] = k > 1 ? ganador[1] : 0;
+
+    // 2. Emitir el ganador y rejugar su camino hasta la raíz
+    long escritos = 0;
+    int ok = 1;
+    while (ok && cabeza[perdedor[0]]) {
+        int s = perdedor[0];
+        ok = salida_poner(salida, cabeza[s]);
+        escritos++;
+
+        lectores[s].i++;
+        cabeza[s] = lector_actual(&lectores[s]);
+
+        for (int n = (k + s) / 2; n >= 1; n /= 2) {
+            if (perdedores_gana(cabeza, cmp, perdedor[n], s)) {
+                int t = perdedor[n];
+                perdedor[n] = s;
+                s = t;
+            }
+        }
+        perdedor[0] = s;
+    }
+    for (int i = 0; i < k; i++) {
+        if (lectores[i].error) ok = 0;
+    }
+
+    free(cabeza);
+    free(perdedor);
+    free(ganador);
+    return ok ? escritos : -1;
+}
+
+// ---------------------------------------------------------------------------
+// GENERACIÓN Y REPARTO DE SECUENCIAS
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Estado del reparto de secuencias entre cintas durante la primera fase.
+ *
+ * En modo polifásico sigue el algoritmo D de Knuth: `objetivo[j]` es la
+ * distribución perfecta del nivel actual y `ficticias[j]` las secuencias que
+ * aún faltan en la cinta j para alcanzarla.
+ */
+typedef struct {
+    Cinta *cintas;          /**< Cintas de destino. */
+    int num_cintas;         /**< Cintas de entrada para la mezcla (P). */
+    int polifasica;         /**< 1 para la distribución de Fibonacci. */
+    SalidaRegistros *salida;/**< Salida compartida, redirigida en cada secuencia. */
+    int directa;            /**< 1 si todo cabe en memoria y va a la salida final. */
+    ArchivoLibros *final;   /**< Archivo de salida final (modo directo). */
+    const char *nombre_final; /**< Ruta del archivo de salida final. */
+    ClaveOrden clave;       /**< Clave que se anota en la cabecera de la salida. */
+    int final_abierto;      /**< 1 cuando ya se ha creado la salida final. */
+    long actual;            /**< Secuencia en curso (-1 antes de la primera). */
+    long longitud;          /**< Registros de la secuencia en curso. */
+    int destino;            /**< Cinta de la secuencia en curso. */
+    long *objetivo;         /**< Distribución perfecta del nivel (P+1 huecos). */
+    long *ficticias;        /**< Secuencias ficticias pendientes (P+1 huecos). */
+    int error;              /**< 1 si algo falló. */
+} RepartoCintas;
+
+/**
+ * @brief Elige la cinta de la siguiente secuencia según el algoritmo D de Knuth.
+ */
+static inline void reparto_siguiente_cinta(RepartoCintas *r) {
+    int p = r->num_cintas;
+    int j = r->destino;
+
+    if (r->ficticias[j] < r->ficticias[j + 1]) {
+        j++;
+    } else {
+        if (r->ficticias[j] == 0) {
+            // Subir de nivel: nueva distribución perfecta de Fibonacci generalizada
+            long a = r->objetivo[0];
+            for (int i = 0; i < p; i++) {
+                r->ficticias[i] = a + r->objetivo[i + 1] - r->objetivo[i];
+                r->objetivo[i] = a + r->objetivo[i + 1];
+            }
+        }
+        j = 0;
+    }
+    r->destino = j;
+}
+
+/**
+ * @brief Cierra la secuencia en curso anotando su longitud en la cinta.
+ */
+static inline void reparto_cerrar_secuencia(RepartoCintas *r) {
+    if (r->actual < 0 || r->directa) return;
+    if (!cinta_encolar(&r->cintas[r->destino], r->longitud)) r->error = 1;
+}
+
+/**
+ * @brief Crea el archivo de salida final del modo directo.
+ *
+ * Se crea al emitir el primer registro, cuando la selección con reemplazo ya
+ * ha cargado toda la entrada: así la salida puede ser el mismo archivo.
+ */
+static inline int reparto_abrir_final(RepartoCintas *r) {
+    if (r->final_abierto) return 1;
+    if (!libros_crear(r->final, r->nombre_final, r->clave)) return 0;
+    r->final_abierto = 1;
+    salida_redirigir(r->salida, -1, r->final);
+    return 1;
+}
+
+/**
+ * @brief Recibe cada registro de la selección con reemplazo y lo escribe en su cinta.
+ */
+static inline int reparto_emitir(const Libro *libro, long secuencia, void *ctx) {
+    RepartoCintas *r = (RepartoCintas *)ctx;
+
+    if (r->directa && !reparto_abrir_final(r)) {
+        r->error = 1;
+        return 0;
+    }
+    if (secuencia != r->actual && !r->directa) {
+        reparto_cerrar_secuencia(r);
+        if (r->actual >= 0) {
+            if (r->polifasica) reparto_siguiente_cinta(r);
+            else r->destino = 0; // Multivía: todas las secuencias en la misma cinta
+        }
+        if (r->polifasica) r->ficticias[r->destino]--;
+        salida_redirigir(r->salida, r->cintas[r->destino].fd, NULL);
+        r->longitud = 0;
+    }
+    r->actual = secuencia;
+    r->longitud++;
+    return salida_poner(r->salida, libro) && !r->error;
+}
+
+// ---------------------------------------------------------------------------
+// FASES DE MEZCLA
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Mezcla la primera secuencia pendiente de cada cinta de @p origen.
+ *
+ * @param cintas Cintas disponibles.
+ * @param origen Índices de las cintas de las que se toma una secuencia.
+ * @param k Número de cintas de origen.
+ * @param lectores Lectores (con búfer ya reservado), al menos @p k.
+ * @return Registros escritos, o -1 en caso de error.
+ */
+static inline long mezclar_cabezas(Cinta *cintas, const int *origen, int k, LectorSecuencia *lectores,
+                                   CompararLibros cmp, SalidaRegistros *salida) {
+    long total = 0;
+    for (int i = 0; i < k; i++) {
+        Cinta *c = &cintas[origen[i]];
+        long len = c->longitudes[c->cabeza++];
+        lector_iniciar(&lectores[i], c->fd, c->lectura, len);
+        c->lectura += (off_t)(sizeof(Libro) * (size_t)len);
+        total += len;
+    }
+    if (total == 0) return 0; // Todas ficticias: no hay nada que leer
+    return mezclar_secuencias(lectores, k, cmp, salida);
+}
+
+/**
+ * @brief Mezcla multivía equilibrada entre las cintas 0 y 1.
+ *
+ * @return Número de pasadas realizadas, o -1 en caso de error.
+ */
+static inline int mezcla_multivia(Cinta *cintas, int k, LectorSecuencia *lectores, CompararLibros cmp,
+                                  SalidaRegistros *salida, ArchivoLibros *final) {
+    int origen = 0, pasadas = 0;
+
+    for (;;) {
+        Cinta *src = &cintas[origen], *dst = &cintas[1 - origen];
+        long pendientes = cinta_pendientes(src);
+        int ultima = pendientes <= k;
+
+        if (ultima) salida_redirigir(salida, -1, final);
+        else if (!cinta_vaciar(dst)) break;
+        else salida_redirigir(salida, dst->fd, NULL);
+        pasadas++;
+
+        // Cada grupo de K secuencias consecutivas se lee con K lectores a la vez
+        while (cinta_pendientes(src) > 0) {
+            int g = cinta_pendientes(src) < k ? (int)cinta_pendientes(src) : k;
+            long escritos, desde = src->cabeza;
+            off_t pos = src->lectura;
+            for (int i = 0; i < g; i++) {
+                long len = src->longitudes[desde + i];
+                lector_iniciar(&lectores[i], src->fd, pos, len);
+                pos += (off_t)(sizeof(Libro) * (size_t)len);
+            }
+            src->cabeza += g;
+            src->lectura = pos;
+            escritos = mezclar_secuencias(lectores, g, cmp, salida);
+            if (escritos < 0 || (!ultima && !cinta_encolar(dst, escritos))) return -1;
+        }
+        salida_vaciar(salida);
+        if (salida->error) break;
+        if (ultima) return pasadas;
+        cinta_vaciar(src);
+        origen = 1 - origen;
+    }
+    return -1;
+}
+
+/**
+ * @brief Mezcla polifásica sobre @p t cintas.
+ *
+ * En cada fase la cinta vacía recibe las mezclas de una secuencia de cada
+ * una de las demás hasta que alguna se agota; esa pasa a ser la de salida de
+ * la fase siguiente. Cuando a ninguna cinta le queda más de una secuencia,
+ * la última mezcla se escribe directamente en el archivo final.
+ *
+ * @return Número de fases realizadas, o -1 en caso de error.
+ */
+static inline int mezcla_polifasica(Cinta *cintas, int t, LectorSecuencia *lectores, CompararLibros cmp,
+                                    SalidaRegistros *salida, ArchivoLibros *final) {
+    int *origen = malloc(sizeof(int) * t);
+    int fases = 0;
+    if (!origen) return -1;
+
+    for (;;) {
+        int k = 0, salida_fase = -1, ultima = 1;
+        long fusiones = -1;
+        for (int i = 0; i < t; i++) {
+            long p = cinta_pendientes(&cintas[i]);
+            if (p > 1) ultima = 0;
+            if (p == 0) {
+                if (salida_fase < 0) salida_fase = i;
+            } else {
+                origen[k++] = i;
+                if (fusiones < 0 || p < fusiones) fusiones = p;
+            }
+        }
+        fases++;
+
+        if (ultima) {
+            // Una secuencia (real o ficticia) por cinta: mezcla final
+            salida_redirigir(salida, -1, final);
+            long r = k > 0 ? mezclar_cabezas(cintas, origen, k, lectores, cmp, salida) : 0;
+            salida_vaciar(salida);
+            free(origen);
+            return (r < 0 || salida->error) ? -1 : fases;
+        }
+
+        // Con una distribución perfecta siempre quedan varias cintas con secuencias
+        if (k < 2 || salida_fase < 0) break;
+
+        Cinta *dst = &cintas[salida_fase];
+        if (!cinta_vaciar(dst)) break;
+        salida_redirigir(salida, dst->fd, NULL);
+
+        for (long f = 0; f < fusiones; f++) {
+            long r = mezclar_cabezas(cintas, origen, k, lectores, cmp, salida);
+            if (r < 0 || !cinta_encolar(dst, r)) {
+                free(origen);
+                return -1;
+            }
+        }
+        salida_vaciar(salida);
+        if (salida->error) break;
+    }
+    free(origen);
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+// INTERFAZ PRINCIPAL
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Rellena @p op con los valores por defecto para la clave @p clave.
+ */
+static inline void opciones_ordenacion_defecto(OpcionesOrdenacion *op, ClaveOrden clave) {
+    op->clave = clave;
+    op->memoria = ORDEN_EXT_MEMORIA_DEFECTO;
+    op->fan_in = ORDEN_EXT_FAN_IN_DEFECTO;
+    op->polifasica = 0;
+    op->radix = 0;
+}
+
+/**
+ * @brief Ordena un archivo de libros que no tiene por qué caber en memoria.
+ *
+ * @param entrada Archivo a ordenar.
+ * @param salida Archivo ordenado (puede ser el mismo que @p entrada).
+ * @param op Clave, memoria, número de vías, tipo de mezcla y generación de secuencias.
+ * @param est Si no es NULL, recibe las estadísticas del proceso.
+ * @return 1 si la ordenación termina correctamente, 0 en caso de error.
+ */
+static inline int ordenar_externo(const char *entrada, const char *salida,
+                                  const OpcionesOrdenacion *op, EstadisticasOrdenacion *est) {
+    CompararLibros cmp = comparador_libros(op->clave);
+    long memoria = op->memoria > 0 ? op->memoria : 1;
+    int k = op->fan_in;
+    if (k < 2) k = 2;
+    if (k > ORDEN_EXT_FAN_IN_MAX) k = ORDEN_EXT_FAN_IN_MAX;
+    int t = op->polifasica ? k + 1 : 2;
+
+    EstadisticasOrdenacion e = {0};
+    if (!cmp) {
+        fprintf(stderr, "Clave de ordenación no válida.\n");
+        return 0;
+    }
+
+    ArchivoLibros ent, fin;
+    if (!libros_abrir(&ent, entrada)) {
+        perror(entrada);
+        return 0;
+    }
+    e.registros = libros_total(&ent);
+    int directa = e.registros <= memoria; // Cabe entero en el montículo
+
+    // Búfer de escritura y de cada lector: M/(K+1) registros
+    long cap = memoria / (k + 1);
+    if (cap < 1) cap = 1;
+
+    Cinta cintas[ORDEN_EXT_FAN_IN_MAX + 1];
+    int abiertas = 0, ok = 1;
+    for (int i = 0; ok && !directa && i < t; i++) {
+        ok = cinta_abrir(&cintas[i], i);
+        if (ok) abiertas++;
+    }
+
+    SalidaRegistros sal = { .fd = -1, .cap = cap };
+    sal.buf = malloc(sizeof(Libro) * cap);
+    long objetivo[ORDEN_EXT_FAN_IN_MAX + 1] = {0}, ficticias[ORDEN_EXT_FAN_IN_MAX + 1] = {0};
+    for (int i = 0; i < t - 1; i++) objetivo[i] = ficticias[i] = 1;
+
+    RepartoCintas r = {
+        .cintas = cintas, .num_cintas = t - 1, .polifasica = op->polifasica,
+        .salida = &sal, .directa = directa, .final = &fin, .nombre_final = salida,
+        .clave = op->clave, .actual = -1, .objetivo = objetivo, .ficticias = ficticias
+    };
+
+    // 1. Generar las secuencias iniciales (o la salida completa si cabe en memoria)
+    if (ok && sal.buf) {
+        long m = directa ? (e.registros > 0 ? e.registros : 1) : memoria;
+        e.secuencias = op->radix && radix_admite(op->clave)
+            ? secuencias_radix(&ent, m, op->clave, reparto_emitir, &r)
+            : seleccion_reemplazo(&ent, m, cmp, reparto_emitir, &r);
+        reparto_cerrar_secuencia(&r);
+        salida_vaciar(&sal);
+        ok = e.secuencias >= 0 && !r.error && !sal.error;
+        libros_cerrar(&ent);
+        if (ok && directa) ok = reparto_abrir_final(&r); // Entrada vacía: salida vacía
+    } else {
+        ok = 0;
+        libros_cerrar(&ent);
+    }
+
+    // 2. Mezclar las secuencias hasta dejar una en el archivo de salida
+    if (ok && !directa) {
+        if (op->polifasica) {
+            for (int i = 0; ok && i < t - 1; i++) ok = cinta_anteponer_ficticias(&cintas[i], ficticias[i]);
+        }
+        LectorSecuencia *lectores = calloc(k, sizeof(LectorSecuencia));
+        for (int i = 0; ok && lectores && i < k; i++) {
+            lectores[i].cap = cap;
+            lectores[i].buf = malloc(sizeof(Libro) * cap);
+            if (!lectores[i].buf) ok = 0;
+        }
+        ok = ok && lectores && libros_crear(&fin, salida, op->clave);
+        if (ok) {
+            e.pasadas = op->polifasica
+                ? mezcla_polifasica(cintas, t, lectores, cmp, &sal, &fin)
+                : mezcla_multivia(cintas, k, lectores, cmp, &sal, &fin);
+            if (e.pasadas < 0) ok = 0;
+            if (!libros_cerrar(&fin)) ok = 0;
+        }
+        for (int i = 0; lectores && i < k; i++) free(lectores[i].buf);
+        free(lectores);
+    }
+    if (r.final_abierto && !libros_cerrar(&fin)) ok = 0;
+
+    e.escritos = sal.escritos;
+    for (int i = 0; i < abiertas; i++) cinta_cerrar(&cintas[i]);
+    free(sal.buf);
+
+    if (est) *est = e;
+    return ok;
+}
+
+#endif // ORDENACION_EXTERNA_H
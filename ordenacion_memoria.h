@@ -0,0 +1,291 @@
+#ifndef ORDENACION_MEMORIA_H
+#define ORDENACION_MEMORIA_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "libros_io.h"
+#include "ordenacion_radix.h"
+
+/**
+ * @file ordenacion_memoria.h
+ * @brief Ordenación en memoria y en paralelo de archivos de libros que caben en RAM.
+ *
+ * En lugar de mover registros `Libro` de 152 bytes, se ordenan pares
+ * (clave normalizada, índice) de 16 bytes:
+ *
+ *  - Año: entero con el bit de signo invertido, comparable como sin signo.
+ *  - Precio: bits del double transformados para que el orden de los enteros
+ *    sin signo coincida con el de los números.
+ *  - Título: los 8 primeros caracteres en orden big-endian; si coinciden se
+ *    desempata con strcmp sobre el título completo.
+ *
+ * El año y el precio quedan ordenados por completo con su clave normalizada y
+ * se ordenan por residuos (radix, o conteo para los años) con
+ * `ordenacion_radix.h`. El título necesita comparaciones: los pares se
+ * reparten en un tramo por hilo (pthreads), cada hilo ordena el suyo con
+ * mezcla ascendente y después los tramos se mezclan de dos en dos, también
+ * en paralelo. En ambos casos, a igualdad de clave se conserva el orden
+ * original (ordenación estable). Por último los registros se copian en el
+ * orden resultante y se escriben secuencialmente en bloques.
+ *
+ * Compilar con `-pthread` en sistemas donde pthreads no está en la libc.
+ */
+
+/** @brief Presupuesto de memoria por defecto para ordenar en RAM (bytes). */
+#define ORDEN_MEM_PRESUPUESTO_DEFECTO (1024L * 1024 * 1024)
+
+/** @brief Registros copiados en cada bloque de la escritura final. */
+#define ORDEN_MEM_BLOQUE 4096
+
+/** @brief Tramo mínimo por hilo: con menos pares no compensa repartir. */
+#define ORDEN_MEM_TRAMO_MINIMO 16384
+
+/** @brief Tamaño de los bloques ordenados por inserción antes de mezclar. */
+#define ORDEN_MEM_INSERCION 32
+
+/**
+ * @struct ContextoOrden
+ * @brief Datos compartidos por las comparaciones de pares.
+ */
+typedef struct {
+    const Libro *libros;     /**< Registros originales (para desempatar títulos). */
+    int desempate_titulo;    /**< 1 si la clave es un prefijo del título. */
+} ContextoOrden;
+
+/**
+ * @brief Indica si el par @p a va antes que el @p b.
+ */
+static inline int par_menor(const ParClave *a, const ParClave *b, const ContextoOrden *ctx) {
+    if (a->clave != b->clave) return a->clave < b->clave;
+    if (ctx->desempate_titulo) {
+        int c = strcmp(ctx->libros[a->indice].titulo, ctx->libros[b->indice].titulo);
+        if (c != 0) return c < 0;
+    }
+    return a->indice < b->indice;
+}
+
+/**
+ * @brief Mezcla dos tramos ordenados en @p dst.
+ */
+static inline void pares_mezclar(const ParClave *a, long na, const ParClave *b, long nb,
+                                 ParClave *dst, const ContextoOrden *ctx) {
+    long i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        if (par_menor(&b[j], &a[i], ctx)) dst[k++] = b[j++];
+        else dst[k++] = a[i++];
+    }
+    while (i < na) dst[k++] = a[i++];
+    while (j < nb) dst[k++] = b[j++];
+}
+
+/**
+ * @brief Ordena un tramo de pares con mezcla ascendente (resultado en @p v).
+ *
+ * Primero ordena por inserción bloques de @ref ORDEN_MEM_INSERCION pares y
+ * después los mezcla alternando entre @p v y @p tmp.
+ */
+static inline void pares_ordenar_tramo(ParClave *v, ParClave *tmp, long n, const ContextoOrden *ctx) {
+    for (long ini = 0; ini < n; ini += ORDEN_MEM_INSERCION) {
+        long fin = ini + ORDEN_MEM_INSERCION < n ? ini + ORDEN_MEM_INSERCION : n;
+        for (long i = ini + 1; i < fin; i++) {
+            ParClave x = v[i];
+            long j = i - 1;
+            while (j >= ini && par_menor(&x, &v[j], ctx)) {
+                v[j + 1] = v[j];
+                j--;
+            }
+            v[j + 1] = x;
+        }
+    }
+
+    ParClave *src = v, *dst = tmp;
+    for (long ancho = ORDEN_MEM_INSERCION; ancho < n; ancho *= 2) {
+        for (long ini = 0; ini < n; ini += 2 * ancho) {
+            long medio = ini + ancho < n ? ini + ancho : n;
+            long fin = ini + 2 * ancho < n ? ini + 2 * ancho : n;
+            pares_mezclar(&src[ini], medio - ini, &src[medio], fin - medio, &dst[ini], ctx);
+        }
+        ParClave *t = src; src = dst; dst = t;
+    }
+    if (src != v) memcpy(v, src, sizeof(ParClave) * n);
+}
+
+/**
+ * @struct TareaOrden
+ * @brief Trabajo de un hilo: ordenar un tramo o mezclar dos tramos contiguos.
+ */
+typedef struct {
+    ParClave *src, *dst;          /**< Origen y destino (en la fase de ordenación, vector y auxiliar). */
+    long ini, medio, fin;         /**< Tramos [ini, medio) y [medio, fin). */
+    int mezclar;                  /**< 0 = ordenar el tramo, 1 = mezclar los dos tramos. */
+    const ContextoOrden *ctx;     /**< Datos de comparación. */
+} TareaOrden;
+
+/**
+ * @brief Función de cada hilo.
+ */
+static inline void *tarea_orden_ejecutar(void *arg) {
+    TareaOrden *t = (TareaOrden *)arg;
+    if (t->mezclar) {
+        pares_mezclar(&t->src[t->ini], t->medio - t->ini, &t->src[t->medio], t->fin - t->medio,
+                      &t->dst[t->ini], t->ctx);
+    } else {
+        pares_ordenar_tramo(&t->src[t->ini], &t->dst[t->ini], t->fin - t->ini, t->ctx);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Lanza @p n tareas en paralelo y espera a que terminen.
+ *
+ * Si no se puede crear un hilo, la tarea se ejecuta en el hilo actual.
+ */
+static inline void tareas_orden_lanzar(TareaOrden *tareas, int n) {
+    pthread_t hilos[n > 0 ? n : 1];
+    int creado[n > 0 ? n : 1];
+    for (int i = 1; i < n; i++) {
+        creado[i] = pthread_create(&hilos[i], NULL, tarea_orden_ejecutar, &tareas[i]) == 0;
+        if (!creado[i]) tarea_orden_ejecutar(&tareas[i]);
+    }
+    if (n > 0) tarea_orden_ejecutar(&tareas[0]); // El hilo actual hace la primera
+    for (int i = 1; i < n; i++) {
+        if (creado[i]) pthread_join(hilos[i], NULL);
+    }
+}
+
+/**
+ * @brief Número de núcleos disponibles.
+ */
+static inline int ordenacion_num_hilos(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+/**
+ * @brief Ordena pares en paralelo con mezcla (merge sort) multihilo.
+ *
+ * @param pares Pares a ordenar.
+ * @param tmp Vector auxiliar del mismo tamaño.
+ * @param n Número de pares.
+ * @param ctx Datos de comparación.
+ * @param hilos Hilos a usar (<= 0 para todos los núcleos).
+ * @return Vector con el resultado ordenado (@p pares o @p tmp).
+ */
+static inline ParClave *ordenar_pares_paralelo(ParClave *pares, ParClave *tmp, long n,
+                                               const ContextoOrden *ctx, int hilos) {
+    if (hilos <= 0) hilos = ordenacion_num_hilos();
+    if (hilos > 64) hilos = 64;
+    if (n / hilos < ORDEN_MEM_TRAMO_MINIMO) hilos = (int)(n / ORDEN_MEM_TRAMO_MINIMO);
+    if (hilos < 1) hilos = 1;
+
+    long limites[65];
+    for (int i = 0; i <= hilos; i++) limites[i] = (long)((double)n * i / hilos);
+
+    // 1. Cada hilo ordena su tramo
+    TareaOrden tareas[64];
+    for (int i = 0; i < hilos; i++) {
+        tareas[i] = (TareaOrden){ pares, tmp, limites[i], limites[i + 1], limites[i + 1], 0, ctx };
+    }
+    tareas_orden_lanzar(tareas, hilos);
+
+    // 2. Mezclar los tramos de dos en dos hasta que quede uno
+    ParClave *src = pares, *dst = tmp;
+    for (int ancho = 1; ancho < hilos; ancho *= 2) {
+        int num = 0;
+        for (int i = 0; i < hilos; i += 2 * ancho) {
+            int m = i + ancho < hilos ? i + ancho : hilos;
+            int f = i + 2 * ancho < hilos ? i + 2 * ancho : hilos;
+            tareas[num++] = (TareaOrden){ src, dst, limites[i], limites[m], limites[f], 1, ctx };
+        }
+        tareas_orden_lanzar(tareas, num);
+        ParClave *t = src; src = dst; dst = t;
+    }
+    return src;
+}
+
+/**
+ * @brief Memoria necesaria para ordenar @p n registros en RAM (bytes).
+ */
+static inline long ordenacion_memoria_necesaria(long n) {
+    return n * (long)(sizeof(Libro) + 2 * sizeof(ParClave)) + ORDEN_MEM_BLOQUE * (long)sizeof(Libro);
+}
+
+/**
+ * @brief Ordena en memoria un archivo de libros y escribe el resultado.
+ *
+ * Carga el archivo con una sola lectura, ordena los pares (clave, índice) por
+ * residuos o con mezcla en paralelo y escribe los registros ordenados de forma secuencial.
+ *
+ * @param entrada Archivo a ordenar.
+ * @param salida Archivo ordenado (puede ser el mismo que @p entrada).
+ * @param clave Campo de ordenación.
+ * @param hilos Hilos de la mezcla (<= 0 para todos los núcleos).
+ * @param radix 1 para ordenar por residuos las claves numéricas, 0 para usar
+ *        siempre la mezcla por comparaciones.
+ * @return Número de registros ordenados, o -1 en caso de error.
+ */
+static inline long ordenar_libros_memoria(const char *entrada, const char *salida, ClaveOrden clave,
+                                          int hilos, int radix) {
+    ArchivoLibros f;
+    if (!libros_abrir(&f, entrada)) {
+        perror(entrada);
+        return -1;
+    }
+
+    long n = libros_total(&f);
+    if ((uint64_t)n > UINT32_MAX) {
+        fprintf(stderr, "%s: demasiados registros para ordenar en memoria.\n", entrada);
+        libros_cerrar(&f);
+        return -1;
+    }
+    Libro *libros = malloc(sizeof(Libro) * (n > 0 ? n : 1));
+    ParClave *pares = malloc(sizeof(ParClave) * (n > 0 ? n : 1));
+    ParClave *tmp = malloc(sizeof(ParClave) * (n > 0 ? n : 1));
+    Libro *bloque = malloc(sizeof(Libro) * ORDEN_MEM_BLOQUE);
+    if (!libros || !pares || !tmp || !bloque) {
+        perror("Error al reservar memoria para la ordenación");
+        free(libros); free(pares); free(tmp); free(bloque);
+        libros_cerrar(&f);
+        return -1;
+    }
+
+    // 1. Una sola lectura de todo el archivo
+    n = (long)libros_leer_varios(&f, libros, (size_t)n);
+    int ok = !libros_error(&f);
+    libros_cerrar(&f);
+
+    // 2. Ordenar los pares (clave, índice)
+    ContextoOrden ctx = { libros, clave == ORDEN_TITULO };
+    for (long i = 0; i < n; i++) {
+        pares[i].clave = clave_normalizada(&libros[i], clave);
+        pares[i].indice = (uint32_t)i;
+        pares[i].relleno = 0;
+    }
+    ParClave *orden = radix && radix_admite(clave)
+        ? radix_ordenar_pares(pares, tmp, n)
+        : ordenar_pares_paralelo(pares, tmp, n, &ctx, hilos);
+    if (!orden) ok = 0;
+
+    // 3. Escritura secuencial de los registros en el nuevo orden
+    ArchivoLibros out;
+    if (ok && libros_crear(&out, salida, clave)) {
+        for (long i = 0; ok && i < n; i += ORDEN_MEM_BLOQUE) {
+            long m = n - i < ORDEN_MEM_BLOQUE ? n - i : ORDEN_MEM_BLOQUE;
+            for (long j = 0; j < m; j++) bloque[j] = libros[orden[i + j].indice];
+            ok = libros_anadir_varios(&out, bloque, (size_t)m) == (size_t)m;
+        }
+        if (!libros_cerrar(&out)) ok = 0;
+    } else {
+        ok = 0;
+    }
+
+    free(libros); free(pares); free(tmp); free(bloque);
+    if (!ok) {
+        perror(salida);
+        return -1;
+    }
+    return n;
+}
+
+#endif // ORDENACION_MEMORIA_H
@@ -0,0 +1,400 @@
+#ifndef ORDENACION_PDQ_H
+#define ORDENACION_PDQ_H
+
+#include <math.h>
+#include <string.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/**
+ * @file ordenacion_pdq.h
+ * @brief Ordenación de vectores de double con pdqsort (quicksort que evita patrones).
+ *
+ * Es un quicksort con las defensas de pdqsort:
+ *
+ *  - Pivote por mediana de tres, o mediana de medianas de tres (ninther) en
+ *    tramos grandes.
+ *  - Si una partición queda muy desequilibrada se intercambian algunos
+ *    elementos para romper el patrón de la entrada; tras log2(n) particiones
+ *    malas el tramo se ordena por montículo (heapsort), así que el peor caso
+ *    es O(n log n).
+ *  - Si la partición no movió ningún elemento se intenta una inserción
+ *    limitada: las entradas ya ordenadas cuestan O(n).
+ *  - Si el pivote es igual al elemento anterior al tramo, los iguales se
+ *    agrupan de una vez: muchos duplicados cuestan O(n).
+ *
+ * Los tramos de @ref PDQ_PEQUENO elementos o menos se ordenan con una red
+ * de ordenación bitónica de 16 elementos en registros AVX2 si el programa se
+ * compila con `-mavx2` (o `-march=native` en una CPU que lo tenga) y por
+ * inserción en otro caso (o si el tramo contiene algún NaN).
+ *
+ * La ordenación no es estable y el resultado con valores NaN no está definido
+ * (aunque el vector sigue siendo una permutación del original).
+ */
+
+/** @brief Tamaño máximo de tramo que se ordena sin particionar. */
+#define PDQ_PEQUENO 16
+
+/** @brief A partir de este tamaño el pivote es la mediana de medianas (ninther). */
+#define PDQ_NINTHER 128
+
+/** @brief Desplazamientos permitidos en la inserción de un tramo casi ordenado. */
+#define PDQ_LIMITE_PARCIAL 8
+
+/**
+ * @brief Intercambia dos elementos del vector.
+ */
+static inline void pdq_intercambiar(double *v, long a, long b) {
+    double t = v[a];
+    v[a] = v[b];
+    v[b] = t;
+}
+
+/**
+ * @brief Ordena v[a], v[b] y v[c] de forma que v[a] <= v[b] <= v[c].
+ */
+static inline void pdq_ordenar3(double *v, long a, long b, long c) {
+    if (v[b] < v[a]) pdq_intercambiar(v, a, b);
+    if (v[c] < v[b]) pdq_intercambiar(v, b, c);
+    if (v[b] < v[a]) pdq_intercambiar(v, a, b);
+}
+
+/**
+ * @brief Ordenación por inserción directa de v[0..n).
+ */
+static inline void pdq_insercion(double *v, long n) {
+    for (long i = 1; i < n; i++) {
+        double x = v[i];
+        long j = i;
+        while (j > 0 && x < v[j - 1]) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = x;
+    }
+}
+
+#ifdef __AVX2__
+/**
+ * @brief Deja en @p a el mínimo y en @p b el máximo de cada carril.
+ *
+ * Se usa comparación y mezcla en lugar de _mm256_min_pd/_mm256_max_pd para
+ * que los valores se intercambien sin alterarse (-0.0 y 0.0, NaN).
+ */
+static inline void pdq_red_minmax(__m256d *a, __m256d *b) {
+    __m256d menor = _mm256_cmp_pd(*b, *a, _CMP_LT_OQ);
+    __m256d x = _mm256_blendv_pd(*a, *b, menor);
+    *b = _mm256_blendv_pd(*b, *a, menor);
+    *a = x;
+}
+
+/**
+ * @brief Compara cada carril con su pareja @p p y se queda con el menor en
+ *        los carriles bajos y el mayor en los altos (máscara @p altos).
+ *
+ * Ambos carriles de una pareja usan la misma comparación, de modo que los
+ * valores iguales no se duplican.
+ */
+#define PDQ_RED_PASO(v, p, altos) \
+    _mm256_blendv_pd((v), (p), _mm256_blend_pd(_mm256_cmp_pd((p), (v), _CMP_LT_OQ), \
+                                               _mm256_cmp_pd((v), (p), _CMP_LT_OQ), (altos)))
+
+/**
+ * @brief Ordena un vector bitónico de 4 elementos.
+ */
+static inline __m256d pdq_red_bitonico4(__m256d v) {
+    v = PDQ_RED_PASO(v, _mm256_permute2f128_pd(v, v, 0x01), 0xC); // Carriles (0,2) y (1,3)
+    return PDQ_RED_PASO(v, _mm256_permute_pd(v, 0x5), 0xA);       // Carriles (0,1) y (2,3)
+}
+
+/**
+ * @brief Invierte el orden de los 4 carriles.
+ */
+static inline __m256d pdq_red_invertir(__m256d v) {
+    return _mm256_permute4x64_pd(v, 0x1B);
+}
+
+/**
+ * @brief Mezcla dos vectores ordenados de 4 en 8 ordenados (@p a los menores).
+ */
+static inline void pdq_red_mezclar4(__m256d *a, __m256d *b) {
+    *b = pdq_red_invertir(*b);
+    pdq_red_minmax(a, b);
+    *a = pdq_red_bitonico4(*a);
+    *b = pdq_red_bitonico4(*b);
+}
+
+/**
+ * @brief Ordena 16 doubles con una red bitónica en cuatro registros AVX2.
+ *
+ * Se ordenan las columnas de los cuatro registros con una red de 4 entradas,
+ * se traspone la matriz 4x4 para obtener cuatro grupos ordenados y se
+ * mezclan por pares (4+4 y luego 8+8).
+ */
+static inline void pdq_red_ordenar16(double *v) {
+    __m256d a = _mm256_loadu_pd(v), b = _mm256_loadu_pd(v + 4);
+    __m256d c = _mm256_loadu_pd(v + 8), d = _mm256_loadu_pd(v + 12);
+
+    // 1. Ordenar cada columna (carril i de a, b, c, d)
+    pdq_red_minmax(&a, &b); pdq_red_minmax(&c, &d);
+    pdq_red_minmax(&a, &c); pdq_red_minmax(&b, &d);
+    pdq_red_minmax(&b, &c);
+
+    // 2. Trasponer: cada registro pasa a ser una columna ordenada
+    __m256d t0 = _mm256_unpacklo_pd(a, b), t1 = _mm256_unpackhi_pd(a, b);
+    __m256d t2 = _mm256_unpacklo_pd(c, d), t3 = _mm256_unpackhi_pd(c, d);
+    a = _mm256_permute2f128_pd(t0, t2, 0x20);
+    b = _mm256_permute2f128_pd(t1, t3, 0x20);
+    c = _mm256_permute2f128_pd(t0, t2, 0x31);
+    d = _mm256_permute2f128_pd(t1, t3, 0x31);
+
+    // 3. Mezclas 4+4: (a, b) y (c, d) quedan ordenados de 8 en 8
+    pdq_red_mezclar4(&a, &b);
+    pdq_red_mezclar4(&c, &d);
+
+    // 4. Mezcla 8+8: comparar con el segundo grupo invertido
+    __m256d ci = pdq_red_invertir(d), di = pdq_red_invertir(c);
+    pdq_red_minmax(&a, &ci);
+    pdq_red_minmax(&b, &di);
+    // (a, b) contiene los 8 menores y (ci, di) los 8 mayores, ambos bitónicos
+    pdq_red_minmax(&a, &b);
+    pdq_red_minmax(&ci, &di);
+
+    _mm256_storeu_pd(v, pdq_red_bitonico4(a));
+    _mm256_storeu_pd(v + 4, pdq_red_bitonico4(b));
+    _mm256_storeu_pd(v + 8, pdq_red_bitonico4(ci));
+    _mm256_storeu_pd(v + 12, pdq_red_bitonico4(di));
+}
+#endif
+
+/**
+ * @brief Indica si v[0..n) contiene algún NaN.
+ */
+static inline int pdq_hay_nan(const double *v, long n) {
+    int nan = 0;
+    for (long i = 0; i < n; i++) nan |= v[i] != v[i];
+    return nan;
+}
+
+/**
+ * @brief Ordena un tramo de a lo sumo @ref PDQ_PEQUENO elementos.
+ *
+ * La red no ordena los NaN respecto al relleno: uno podría acabar tras la
+ * posición n y dejar un HUGE_VAL del relleno en su lugar. Con NaN se usa la
+ * inserción, que solo mueve los valores del tramo.
+ */
+static inline void pdq_ordenar_pequeno(double *v, long n) {
+#ifdef __AVX2__
+    if (n > 4 && !pdq_hay_nan(v, n)) {
+        double buf[PDQ_PEQUENO];
+        memcpy(buf, v, sizeof(double) * n);
+        for (long i = n; i < PDQ_PEQUENO; i++) buf[i] = HUGE_VAL; // Relleno al final
+        pdq_red_ordenar16(buf);
+        memcpy(v, buf, sizeof(double) * n);
+        return;
+    }
+#endif
+    pdq_insercion(v, n);
+}
+
+/**
+ * @brief Ordenación por montículo de v[0..n), para los tramos con demasiadas particiones malas.
+ */
+static inline void pdq_monticulo(double *v, long n) {
+    for (long fin = n, i = n / 2 - 1; fin > 1; ) {
+        long raiz;
+        if (i >= 0) {
+            raiz = i--;            // Fase 1: construir el montículo de máximos
+        } else {
+            pdq_intercambiar(v, 0, --fin); // Fase 2: extraer el máximo
+            raiz = 0;
+        }
+        double x = v[raiz];
+        for (;;) {
+            long hijo = 2 * raiz + 1;
+            if (hijo >= fin) break;
+            if (hijo + 1 < fin && v[hijo] < v[hijo + 1]) hijo++;
+            if (!(x < v[hijo])) break;
+            v[raiz] = v[hijo];
+            raiz = hijo;
+        }
+        v[raiz] = x;
+    }
+}
+
+/**
+ * @brief Inserción que se rinde si el tramo v[ini..fin) no está casi ordenado.
+ * @return 1 si el tramo queda ordenado, 0 si se superó @ref PDQ_LIMITE_PARCIAL.
+ */
+static inline int pdq_insercion_parcial(double *v, long ini, long fin) {
+    long movidos = 0;
+    for (long i = ini + 1; i < fin; i++) {
+        if (v[i] < v[i - 1]) {
+            double x = v[i];
+            long j = i;
+            do {
+                v[j] = v[j - 1];
+                j--;
+            } while (j > ini && x < v[j - 1]);
+            v[j] = x;
+            movidos += i - j;
+            if (movidos > PDQ_LIMITE_PARCIAL) return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Particiona v[ini..fin) con el pivote v[ini]; los iguales van a la derecha.
+ *
+ * @param pos Recibe la posición final del pivote.
+ * @return 1 si no hubo que intercambiar nada (el tramo ya estaba particionado).
+ */
+static inline int pdq_particionar_der(double *v, long ini, long fin, long *pos) {
+    double pivote = v[ini];
+    long i = ini, j = fin;
+
+    // La mediana de tres garantiza un elemento >= pivote a la derecha
+    while (v[++i] < pivote);
+    if (i - 1 == ini) {
+        while (i < j && !(v[--j] < pivote));
+    } else {
+        while (!(v[--j] < pivote)); // v[i-1] < pivote lo detiene
+    }
+
+    int ya_particionado = i >= j;
+    while (i < j) {
+        pdq_intercambiar(v, i, j);
+        while (v[++i] < pivote);
+        while (!(v[--j] < pivote));
+    }
+
+    *pos = i - 1;
+    v[ini] = v[*pos];
+    v[*pos] = pivote;
+    return ya_particionado;
+}
+
+/**
+ * @brief Particiona v[ini..fin) con el pivote v[ini]; los iguales van a la izquierda.
+ *
+ * Se usa cuando el pivote coincide con el elemento anterior al tramo: todos
+ * los iguales quedan colocados y no vuelven a tratarse.
+ *
+ * @return Posición final del pivote.
+ */
+static inline long pdq_particionar_izq(double *v, long ini, long fin) {
+    double pivote = v[ini];
+    long i = ini, j = fin;
+
+    while (pivote < v[--j]); // v[ini] lo detiene
+    if (j + 1 == fin) {
+        while (i < j && !(pivote < v[++i]));
+    } else {
+        while (!(pivote < v[++i]));
+    }
+
+    while (i < j) {
+        pdq_intercambiar(v, i, j);
+        while (pivote < v[--j]);
+        while (!(pivote < v[++i]));
+    }
+
+    v[ini] = v[j];
+    v[j] = pivote;
+    return j;
+}
+
+/**
+ * @brief Intercambia unos pocos elementos de v[ini..fin) para romper patrones.
+ */
+static inline void pdq_romper_patrones(double *v, long ini, long fin) {
+    long n = fin - ini;
+    if (n < PDQ_PEQUENO) return;
+    long c = n / 4;
+    pdq_intercambiar(v, ini, ini + c);
+    pdq_intercambiar(v, fin - 1, fin - c);
+    if (n > PDQ_NINTHER) {
+        pdq_intercambiar(v, ini + 1, ini + c + 1);
+        pdq_intercambiar(v, ini + 2, ini + c + 2);
+        pdq_intercambiar(v, fin - 2, fin - c - 1);
+        pdq_intercambiar(v, fin - 3, fin - c - 2);
+    }
+}
+
+/**
+ * @brief Bucle principal de pdqsort sobre v[ini..fin).
+ *
+ * @param malas Particiones desequilibradas que se toleran antes de usar heapsort.
+ * @param extremo_izq 1 si el tramo empieza en v[0] (no hay elemento anterior).
+ */
+static inline void pdq_bucle(double *v, long ini, long fin, int malas, int extremo_izq) {
+    for (;;) {
+        long n = fin - ini;
+        if (n <= PDQ_PEQUENO) {
+            pdq_ordenar_pequeno(v + ini, n);
+            return;
+        }
+
+        // 1. Pivote en v[ini]
+        long m = ini + n / 2;
+        if (n > PDQ_NINTHER) {
+            pdq_ordenar3(v, ini, m, fin - 1);
+            pdq_ordenar3(v, ini + 1, m - 1, fin - 2);
+            pdq_ordenar3(v, ini + 2, m + 1, fin - 3);
+            pdq_ordenar3(v, m - 1, m, m + 1);
+            pdq_intercambiar(v, ini, m);
+        } else {
+            pdq_ordenar3(v, m, ini, fin - 1);
+        }
+
+        // 2. Pivote igual al anterior: los iguales ya están en su sitio
+        if (!extremo_izq && !(v[ini - 1] < v[ini])) {
+            ini = pdq_particionar_izq(v, ini, fin) + 1;
+            continue;
+        }
+
+        long pos;
+        int ya_particionado = pdq_particionar_der(v, ini, fin, &pos);
+        long izq = pos - ini, der = fin - (pos + 1);
+
+        // 3. Partición desequilibrada: romper patrones o pasar a heapsort
+        if (izq < n / 8 || der < n / 8) {
+            if (--malas == 0) {
+                pdq_monticulo(v + ini, n);
+                return;
+            }
+            pdq_romper_patrones(v, ini, pos);
+            pdq_romper_patrones(v, pos + 1, fin);
+        } else if (ya_particionado && pdq_insercion_parcial(v, ini, pos) &&
+                   pdq_insercion_parcial(v, pos + 1, fin)) {
+            return; // Entrada casi ordenada
+        }
+
+        // 4. Recursión en la parte menor y bucle en la mayor
+        if (izq < der) {
+            pdq_bucle(v, ini, pos, malas, extremo_izq);
+            ini = pos + 1;
+            extremo_izq = 0;
+        } else {
+            pdq_bucle(v, pos + 1, fin, malas, 0);
+            fin = pos;
+        }
+    }
+}
+
+/**
+ * @brief Ordena un vector de double en orden ascendente con pdqsort.
+ *
+ * @param v Vector a ordenar.
+ * @param n Número de elementos.
+ */
+static inline void ordenar_doubles(double *v, long n) {
+    if (n < 2) return;
+    int malas = 0;
+    for (long t = n; t > 1; t >>= 1) malas++; // log2(n)
+    pdq_bucle(v, 0, n, malas, 1);
+}
+
+#endif // ORDENACION_PDQ_H
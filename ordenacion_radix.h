@@ -0,0 +1,230 @@
+#ifndef ORDENACION_RADIX_H
+#define ORDENACION_RADIX_H
+
+#include <stdint.h>
+#include "libros_io.h"
+#include "seleccion_reemplazo.h"
+
+/**
+ * @file ordenacion_radix.h
+ * @brief Ordenación por residuos (radix LSD) de pares (clave, índice) de libros.
+ *
+ * Las claves numéricas se transforman en enteros sin signo de 64 bits cuyo
+ * orden coincide con el de los valores originales:
+ *
+ *  - Año: entero con el bit de signo invertido.
+ *  - Precio: bits del double con el bit de signo invertido si es positivo y
+ *    con todos los bits invertidos si es negativo.
+ *
+ * Los pares se ordenan byte a byte empezando por el menos significativo, con
+ * una pasada de conteo por byte. Los histogramas de los 8 bytes se calculan
+ * en un único recorrido y se omiten las pasadas en las que todas las claves
+ * comparten el byte, así que el año (que solo varía en los dos bytes bajos)
+ * cuesta a lo sumo dos pasadas. Si el rango de las claves es pequeño, como
+ * ocurre con los años, basta con una única ordenación por conteo.
+ *
+ * Todas las pasadas son estables: a igualdad de clave se conserva el orden de
+ * entrada, igual que en la mezcla. Los títulos no se pueden ordenar así
+ * (la clave es solo un prefijo) y siguen usando comparaciones.
+ */
+
+/** @brief Bits de cada dígito del radix. */
+#define RADIX_BITS 8
+
+/** @brief Cubetas por dígito (2^RADIX_BITS). */
+#define RADIX_CUBETAS (1 << RADIX_BITS)
+
+/** @brief Dígitos de una clave de 64 bits. */
+#define RADIX_DIGITOS (64 / RADIX_BITS)
+
+/** @brief Rango máximo de claves para usar una sola ordenación por conteo. */
+#define RADIX_RANGO_CONTEO (1L << 16)
+
+/**
+ * @struct ParClave
+ * @brief Clave normalizada de un registro y su posición en el vector original.
+ */
+typedef struct {
+    uint64_t clave;     /**< Clave comparable como entero sin signo. */
+    uint32_t indice;    /**< Posición del registro en el vector de libros. */
+    uint32_t relleno;   /**< Sin uso (alineación a 16 bytes). */
+} ParClave;
+
+/**
+ * @brief Calcula la clave normalizada de un libro.
+ *
+ * Para el título devuelve los 8 primeros caracteres en orden big-endian, que
+ * solo sirven como prefijo: los empates hay que resolverlos con strcmp.
+ */
+static inline uint64_t clave_normalizada(const Libro *l, ClaveOrden clave) {
+    switch (clave) {
+        case ORDEN_ANIO:
+            return (uint64_t)((uint32_t)l->anioPublicacion ^ 0x80000000u);
+        case ORDEN_PRECIO: {
+            double x = l->precio == 0.0 ? 0.0 : l->precio; // -0.0 y 0.0 son iguales
+            uint64_t bits;
+            memcpy(&bits, &x, sizeof(bits));
+            // Negativos: se invierten todos los bits; positivos: solo el de signo
+            return (bits & (1ULL << 63)) ? ~bits : bits | (1ULL << 63);
+        }
+        case ORDEN_TITULO: {
+            uint64_t k = 0;
+            int fin = 0;
+            for (int i = 0; i < 8; i++) {
+                unsigned char c = fin ? 0 : (unsigned char)l->titulo[i];
+                if (c == '\0') fin = 1;
+                k = (k << 8) | c;
+            }
+            return k;
+        }
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Indica si la clave se ordena por completo con su valor normalizado.
+ * @return 1 para año y precio, 0 para el título.
+ */
+static inline int radix_admite(ClaveOrden clave) {
+    return clave == ORDEN_ANIO || clave == ORDEN_PRECIO;
+}
+
+/**
+ * @brief Ordenación por conteo de claves en [minimo, minimo + rango).
+ *
+ * @param src Pares de entrada.
+ * @param dst Destino (no puede solaparse con @p src).
+ * @param n Número de pares.
+ * @param minimo Clave mínima.
+ * @param rango Número de claves distintas posibles.
+ * @return 1 si se ordena, 0 si no hay memoria para los contadores.
+ */
+static inline int conteo_ordenar_pares(const ParClave *src, ParClave *dst, long n,
+                                       uint64_t minimo, long rango) {
+    long *inicio = calloc((size_t)rango, sizeof(long));
+    if (!inicio) return 0;
+
+    for (long i = 0; i < n; i++) inicio[src[i].clave - minimo]++;
+    long suma = 0;
+    for (long c = 0; c < rango; c++) {
+        long cuenta = inicio[c];
+        inicio[c] = suma;
+        suma += cuenta;
+    }
+    for (long i = 0; i < n; i++) dst[inicio[src[i].clave - minimo]++] = src[i];
+
+    free(inicio);
+    return 1;
+}
+
+/**
+ * @brief Ordena pares por clave con radix LSD (o conteo si el rango es pequeño).
+ *
+ * @param v Pares a ordenar.
+ * @param tmp Vector auxiliar del mismo tamaño.
+ * @param n Número de pares.
+ * @return Vector con el resultado ordenado (@p v o @p tmp).
+ */
+static inline ParClave *radix_ordenar_pares(ParClave *v, ParClave *tmp, long n) {
+    if (n < 2) return v;
+
+    uint64_t minimo = v[0].clave, maximo = v[0].clave;
+    for (long i = 1; i < n; i++) {
+        if (v[i].clave < minimo) minimo = v[i].clave;
+        if (v[i].clave > maximo) maximo = v[i].clave;
+    }
+    if (minimo == maximo) return v;
+
+    // Rango pequeño (años): una sola pasada de conteo
+    if (maximo - minimo < (uint64_t)RADIX_RANGO_CONTEO &&
+        conteo_ordenar_pares(v, tmp, n, minimo, (long)(maximo - minimo + 1))) {
+        return tmp;
+    }
+
+    // Histogramas de los 8 bytes en un único recorrido
+    long (*cuenta)[RADIX_CUBETAS] = calloc(RADIX_DIGITOS, sizeof(*cuenta));
+    if (!cuenta) return NULL;
+    for (long i = 0; i < n; i++) {
+        uint64_t k = v[i].clave;
+        for (int d = 0; d < RADIX_DIGITOS; d++) {
+            cuenta[d][(k >> (d * RADIX_BITS)) & (RADIX_CUBETAS - 1)]++;
+        }
+    }
+
+    ParClave *src = v, *dst = tmp;
+    for (int d = 0; d < RADIX_DIGITOS; d++) {
+        int desp = d * RADIX_BITS;
+        // Si todas las claves comparten este byte la pasada no cambia nada
+        if (cuenta[d][(src[0].clave >> desp) & (RADIX_CUBETAS - 1)] == n) continue;
+
+        long inicio[RADIX_CUBETAS], suma = 0;
+        for (int c = 0; c < RADIX_CUBETAS; c++) {
+            inicio[c] = suma;
+            suma += cuenta[d][c];
+        }
+        for (long i = 0; i < n; i++) {
+            dst[inicio[(src[i].clave >> desp) & (RADIX_CUBETAS - 1)]++] = src[i];
+        }
+        ParClave *t = src; src = dst; dst = t;
+    }
+
+    free(cuenta);
+    return src;
+}
+
+/**
+ * @brief Genera secuencias iniciales cargando M registros y ordenándolos por radix.
+ *
+ * Alternativa a `seleccion_reemplazo` con la misma interfaz para claves
+ * numéricas: las secuencias miden M registros (la mitad que con selección con
+ * reemplazo en entradas aleatorias) pero cada registro cuesta unas pocas
+ * pasadas lineales en vez de log2(M) comparaciones. Además de los M registros
+ * usa dos vectores de M pares de 16 bytes.
+ *
+ * @param entrada Archivo de libros abierto para lectura.
+ * @param memoria Número máximo de registros en memoria (M).
+ * @param clave Clave de ordenación (año o precio).
+ * @param emitir Función que recibe cada registro con su número de secuencia.
+ * @param ctx Contexto para @p emitir.
+ * @return Número de secuencias generadas, o -1 si hubo un error.
+ */
+static inline long secuencias_radix(ArchivoLibros *entrada, long memoria, ClaveOrden clave,
+                                    EmitirLibro emitir, void *ctx) {
+    if (!radix_admite(clave)) return -1;
+    if (memoria < 1) memoria = 1;
+    if (memoria > UINT32_MAX) memoria = UINT32_MAX;
+
+    Libro *libros = malloc(sizeof(Libro) * memoria);
+    ParClave *pares = malloc(sizeof(ParClave) * memoria);
+    ParClave *tmp = malloc(sizeof(ParClave) * memoria);
+    if (!libros || !pares || !tmp) {
+        perror("Error al reservar memoria para las secuencias");
+        free(libros); free(pares); free(tmp);
+        return -1;
+    }
+
+    long secuencias = 0;
+    int ok = 1;
+    size_t n;
+    while (ok && (n = libros_leer_varios(entrada, libros, (size_t)memoria)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            pares[i].clave = clave_normalizada(&libros[i], clave);
+            pares[i].indice = (uint32_t)i;
+            pares[i].relleno = 0;
+        }
+        ParClave *orden = radix_ordenar_pares(pares, tmp, (long)n);
+        if (!orden) {
+            ok = 0;
+            break;
+        }
+        for (size_t i = 0; ok && i < n; i++) ok = emitir(&libros[orden[i].indice], secuencias, ctx);
+        secuencias++;
+    }
+    if (libros_error(entrada)) ok = 0;
+
+    free(libros); free(pares); free(tmp);
+    return ok ? secuencias : -1;
+}
+
+#endif // ORDENACION_RADIX_H
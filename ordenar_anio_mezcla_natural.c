@@ -24,15 +24,28 @@
  *
  * Dependencias:
  *  - common.h: define la estructura `Libro` y funciones auxiliares para manipulación de registros.
+ *  - libros_io.h: lectura y escritura del formato binario con cabecera.
+ *
+ * La primera separación genera las secuencias por selección con reemplazo
+ * (ver `seleccion_reemplazo.h`): con un búfer de M registros las secuencias
+ * miden de media 2·M, lo que reduce el número de pasadas de mezcla.
+ *
+ * Por defecto la ordenación se hace con la mezcla de K vías de
+ * `ordenacion_externa.h`; `--natural` conserva la mezcla natural con los
+ * dos archivos auxiliares.
  *
  * Ejemplo de uso:
- *  ./mezcla_natural_libros
+ *  ./mezcla_natural_libros [--natural] [--memoria=M] [--vias=K] [--polifasica] [--radix]
+ *  (con --natural, M = 0 usa solo las secuencias naturales)
  *  Preguntará si desea guardar el archivo ordenado y mostrará el contenido ordenado.
  */
 
 
 
 #include "common.h" ///< Incluye el archivo de cabecera con la definición de la estructura Libro y funciones auxiliares
+#include "libros_io.h" ///< Formato binario con cabecera (apertura, lectura y escritura de registros)
+#include "seleccion_reemplazo.h" ///< Generación de secuencias iniciales por selección con reemplazo
+#include "ordenacion_externa.h" ///< Mezcla de K vías con árbol de perdedores
 
 // --- Prototipos de módulos ---
 
@@ -41,8 +54,10 @@
  * @param nombreF Nombre del archivo principal.
  * @param nombreF1 Nombre del primer archivo auxiliar.
  * @param nombreF2 Nombre del segundo archivo auxiliar.
+ * @param memoria Registros en memoria para la primera separación por selección
+ *        con reemplazo (0 para separar solo las secuencias naturales).
  */
-void clasificacion_mezcla_natural(const char *nombreF, const char *nombreF1, const char *nombreF2);
+void clasificacion_mezcla_natural(const char *nombreF, const char *nombreF1, const char *nombreF2, long memoria);
 
 /**
  * @brief Separa el archivo original en dos archivos auxiliares con secuencias ordenadas.
@@ -52,13 +67,24 @@ void clasificacion_mezcla_natural(const char *nombreF, const char *nombreF1, con
  */
 void separar(const char *nombreF, const char *nombreF1, const char *nombreF2);
 
+/**
+ * @brief Primera separación: genera secuencias por selección con reemplazo y las
+ *        reparte alternando entre los dos archivos auxiliares.
+ * @param nombreF Nombre del archivo principal.
+ * @param nombreF1 Nombre del primer archivo auxiliar.
+ * @param nombreF2 Nombre del segundo archivo auxiliar.
+ * @param memoria Registros que caben en el montículo.
+ * @return Número de secuencias generadas.
+ */
+long separar_seleccion_reemplazo(const char *nombreF, const char *nombreF1, const char *nombreF2, long memoria);
+
 /**
  * @brief Copia una secuencia ordenada desde un archivo origen a uno destino.
  * @param f_origen Puntero al archivo origen.
  * @param f_destino Puntero al archivo destino.
  * @param reg Registro actual que se está copiando.
  */
-void copiar_secuencia(FILE *f_origen, FILE *f_destino, Libro *reg);
+void copiar_secuencia(ArchivoLibros *f_origen, ArchivoLibros *f_destino, Libro *reg);
 
 /**
  * @brief Lee el siguiente registro y verifica si se mantiene el orden por año.
@@ -66,7 +92,7 @@ void copiar_secuencia(FILE *f_origen, FILE *f_destino, Libro *reg);
  * @param reg Registro actual a comparar.
  * @param parar Indicador de fin de secuencia (1 si termina la secuencia).
  */
-void leer_y_chequear(FILE *f, Libro *reg, int *parar);
+void leer_y_chequear(ArchivoLibros *f, Libro *reg, int *parar);
 
 /**
  * @brief Mezcla las secuencias ordenadas de los dos archivos auxiliares en el archivo principal.
@@ -84,19 +110,44 @@ void mezcla_natural(const char *nombreF, const char *nombreF1, const char *nombr
  * Ordena los registros del archivo binario de libros por año de publicación 
  * usando el método de mezcla natural.
  * 
+ * Opciones: `--memoria=M` fija los registros en memoria, `--vias=K` y `--polifasica`
+ * configuran la mezcla de K vías, `--radix` genera las secuencias por conteo de
+ * años y `--natural` usa la mezcla natural clásica.
+ *
  * @return 0 si la ejecución fue correcta, 1 si ocurrió algún error.
  */
-int main(void) {
+int main(int argc, char *argv[]) {
     const char *nombreF  = "libros_biblioteca.bin";   ///< Archivo principal
     const char *nombreF1 = "aux1.bin";                ///< Archivo auxiliar 1
     const char *nombreF2 = "aux2.bin";                ///< Archivo auxiliar 2
+    long memoria = -1;                                ///< Registros en memoria (-1: por defecto)
+    int natural = 0;                                  ///< 1 para la mezcla natural clásica
+    OpcionesOrdenacion op;                            ///< Opciones de la mezcla de K vías
+    opciones_ordenacion_defecto(&op, ORDEN_ANIO);
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--memoria=", 10) == 0) memoria = atol(argv[i] + 10);
+        else if (strcmp(argv[i], "--natural") == 0) natural = 1;
+        else if (strncmp(argv[i], "--vias=", 7) == 0) op.fan_in = atoi(argv[i] + 7);
+        else if (strcmp(argv[i], "--polifasica") == 0) op.polifasica = 1;
+        else if (strcmp(argv[i], "--radix") == 0) op.radix = 1;
+    }
 
-    /// Clasificación por mezcla natural
-    clasificacion_mezcla_natural(nombreF, nombreF1, nombreF2);
+    if (natural) {
+        /// Clasificación por mezcla natural
+        clasificacion_mezcla_natural(nombreF, nombreF1, nombreF2, memoria < 0 ? SELECCION_MEMORIA_DEFECTO : memoria);
+    } else {
+        /// Ordenación externa con mezcla de K vías
+        EstadisticasOrdenacion est;
+        if (memoria > 0) op.memoria = memoria;
+        if (!ordenar_externo(nombreF, nombreF, &op, &est)) { fprintf(stderr, "Error en la ordenación externa\n"); return 1; }
+        printf("Secuencias iniciales: %ld | %s de mezcla de %d vías: %d\n", est.secuencias,
+               op.polifasica ? "Fases" : "Pasadas", op.fan_in, est.pasadas);
+    }
 
     /// Mostrar resultado final por pantalla
-    FILE *f = fopen(nombreF, "rb"); ///< Abre el archivo binario ya ordenado
-    if (!f) { perror("fopen resultado"); return 1; } ///< Verifica apertura correcta
+    ArchivoLibros f; ///< Archivo binario ya ordenado
+    if (!libros_abrir(&f, nombreF)) { perror("fopen resultado"); return 1; } ///< Verifica apertura correcta
 
     /// Cabecera de la tabla de salida
     printf("\n%-30s %-20s %-6s %-9s %-8s\n",
@@ -104,27 +155,30 @@ int main(void) {
     printf("-------------------------------------------------------------------------------\n");
 
     Libro L; ///< Registro auxiliar para lectura
-    while (fread(&L, sizeof(Libro), 1, f) == 1) { ///< Lee mientras haya registros
+    while (libros_leer(&f, &L)) { ///< Lee mientras haya registros
         printf("%-30s %-20s %-6d %-9s %8.2f\n",
                L.titulo, L.autor, L.anioPublicacion, L.prestado, L.precio);
     }
-    fclose(f);
+    libros_cerrar(&f);
 
     /// Pregunta al usuario si desea guardar el resultado ordenado en otro archivo
     char opcion;
     printf("\n¿Guardar resultado en 'libros_biblioteca_anio.bin'? (s/n): ");
     scanf(" %c", &opcion);
     if (opcion == 's' || opcion == 'S') {
-        FILE *orig = fopen(nombreF, "rb");
-        FILE *dest = fopen("libros_biblioteca_anio.bin", "wb");
-        if (!orig || !dest) { perror("fopen guardar"); return 1; }
+        ArchivoLibros orig, dest;
+        if (!libros_abrir(&orig, nombreF) ||
+            !libros_crear(&dest, "libros_biblioteca_anio.bin", ORDEN_ANIO)) {
+            perror("fopen guardar");
+            return 1;
+        }
 
         Libro reg;
-        while (fread(&reg, sizeof(Libro), 1, orig) == 1) ///< Copia todos los registros
-            fwrite(&reg, sizeof(Libro), 1, dest);
+        while (libros_leer(&orig, &reg)) ///< Copia todos los registros
+            libros_anadir(&dest, &reg);
 
-        fclose(orig);
-        fclose(dest);
+        libros_cerrar(&orig);
+        libros_cerrar(&dest);
         printf(" Guardado en 'libros_biblioteca_anio.bin'\n");
     }
 
@@ -136,11 +190,19 @@ int main(void) {
  * @param nombreF Nombre del archivo principal.
  * @param nombreF1 Nombre del primer archivo auxiliar.
  * @param nombreF2 Nombre del segundo archivo auxiliar.
+ * @param memoria Registros del montículo para la primera separación (0 = solo natural).
  */
-void clasificacion_mezcla_natural(const char *nombreF, const char *nombreF1, const char *nombreF2) {
+void clasificacion_mezcla_natural(const char *nombreF, const char *nombreF1, const char *nombreF2, long memoria) {
     int L = 0;
+    int primera = memoria > 0; ///< La primera pasada usa selección con reemplazo
     do {
-        separar(nombreF, nombreF1, nombreF2);          ///< Separa en dos archivos
+        if (primera) {
+            long s = separar_seleccion_reemplazo(nombreF, nombreF1, nombreF2, memoria);
+            printf("Secuencias iniciales por selección con reemplazo (M=%ld): %ld\n", memoria, s);
+            primera = 0;
+        } else {
+            separar(nombreF, nombreF1, nombreF2);      ///< Separa en dos archivos
+        }
         mezcla_natural(nombreF, nombreF1, nombreF2, &L); ///< Mezcla los archivos ordenadamente
     } while (L > 1); ///< Repite mientras haya más de una secuencia
 }
@@ -152,29 +214,66 @@ void clasificacion_mezcla_natural(const char *nombreF, const char *nombreF1, con
  * @param nombreF2 Nombre del segundo archivo auxiliar.
  */
 void separar(const char *nombreF, const char *nombreF1, const char *nombreF2) {
-    FILE *f  = fopen(nombreF, "rb");
-    FILE *f1 = fopen(nombreF1, "wb");
-    FILE *f2 = fopen(nombreF2, "wb");
-    if (!f || !f1 || !f2) { perror("fopen separar"); exit(1); }
+    ArchivoLibros f, f1, f2;
+    if (!libros_abrir(&f, nombreF) ||
+        !libros_crear(&f1, nombreF1, ORDEN_NINGUNO) ||
+        !libros_crear(&f2, nombreF2, ORDEN_NINGUNO)) { perror("fopen separar"); exit(1); }
 
     Libro reg;
-    if (fread(&reg, sizeof(Libro), 1, f) != 1) { ///< Si no hay registros, sale
-        fclose(f); fclose(f1); fclose(f2);
+    if (!libros_leer(&f, &reg)) { ///< Si no hay registros, sale
+        libros_cerrar(&f); libros_cerrar(&f1); libros_cerrar(&f2);
         return;
     }
 
     int alterna = 0; ///< Variable para alternar entre f1 y f2
-    while (!feof(f)) {
+    while (!libros_fin(&f)) {
         if (alterna == 0)
-            copiar_secuencia(f, f1, &reg); ///< Copia una secuencia al aux1
+            copiar_secuencia(&f, &f1, &reg); ///< Copia una secuencia al aux1
         else
-            copiar_secuencia(f, f2, &reg); ///< Copia una secuencia al aux2
+            copiar_secuencia(&f, &f2, &reg); ///< Copia una secuencia al aux2
         alterna = 1 - alterna; ///< Cambia de archivo
     }
 
-    fclose(f);
-    fclose(f1);
-    fclose(f2);
+    libros_cerrar(&f);
+    libros_cerrar(&f1);
+    libros_cerrar(&f2);
+}
+
+/**
+ * @brief Archivos auxiliares de destino de las secuencias generadas.
+ */
+typedef struct {
+    ArchivoLibros *aux[2];
+} RepartoSecuencias;
+
+/**
+ * @brief Escribe cada registro en el auxiliar de su secuencia (pares en aux1, impares en aux2).
+ */
+static int repartir_secuencia(const Libro *reg, long secuencia, void *ctx) {
+    RepartoSecuencias *r = (RepartoSecuencias *)ctx;
+    return libros_anadir(r->aux[secuencia % 2], reg);
+}
+
+/**
+ * @brief Genera las secuencias iniciales por selección con reemplazo.
+ * @param nombreF Nombre del archivo principal.
+ * @param nombreF1 Nombre del primer archivo auxiliar.
+ * @param nombreF2 Nombre del segundo archivo auxiliar.
+ * @param memoria Registros que caben en el montículo.
+ * @return Número de secuencias generadas.
+ */
+long separar_seleccion_reemplazo(const char *nombreF, const char *nombreF1, const char *nombreF2, long memoria) {
+    ArchivoLibros f, f1, f2;
+    if (!libros_abrir(&f, nombreF) ||
+        !libros_crear(&f1, nombreF1, ORDEN_NINGUNO) ||
+        !libros_crear(&f2, nombreF2, ORDEN_NINGUNO)) { perror("fopen separar"); exit(1); }
+
+    RepartoSecuencias r = { { &f1, &f2 } };
+    long s = seleccion_reemplazo(&f, memoria, comparar_libros_anio, repartir_secuencia, &r);
+
+    libros_cerrar(&f);
+    if (!libros_cerrar(&f1) || !libros_cerrar(&f2) || s < 0) { perror("seleccion_reemplazo"); exit(1); }
+    return s;
 }
 
 /**
@@ -183,10 +282,10 @@ void separar(const char *nombreF, const char *nombreF1, const char *nombreF2) {
  * @param f_destino Archivo destino.
  * @param reg Registro actual que se está copiando.
  */
-void copiar_secuencia(FILE *f_origen, FILE *f_destino, Libro *reg) {
+void copiar_secuencia(ArchivoLibros *f_origen, ArchivoLibros *f_destino, Libro *reg) {
     int parar = 0; ///< Indicador de fin de secuencia
     do {
-        fwrite(reg, sizeof(Libro), 1, f_destino); ///< Escribe registro en el destino
+        libros_anadir(f_destino, reg);            ///< Escribe registro en el destino
         leer_y_chequear(f_origen, reg, &parar);   ///< Lee el siguiente y comprueba orden
     } while (!parar);
 }
@@ -197,9 +296,9 @@ void copiar_secuencia(FILE *f_origen, FILE *f_destino, Libro *reg) {
  * @param reg Registro actual.
  * @param parar Bandera que indica el fin de una secuencia (1 si termina).
  */
-void leer_y_chequear(FILE *f, Libro *reg, int *parar) {
+void leer_y_chequear(ArchivoLibros *f, Libro *reg, int *parar) {
     Libro reg_sig;
-    if (fread(&reg_sig, sizeof(Libro), 1, f) == 1) {
+    if (libros_leer(f, &reg_sig)) {
         if (reg->anioPublicacion > reg_sig.anioPublicacion)
             *parar = 1; ///< Detecta ruptura de orden
         *reg = reg_sig; ///< Actualiza registro actual
@@ -216,45 +315,47 @@ void leer_y_chequear(FILE *f, Libro *reg, int *parar) {
  * @param L Puntero a un entero donde se guarda el número de secuencias resultantes.
  */
 void mezcla_natural(const char *nombreF, const char *nombreF1, const char *nombreF2, int *L) {
-    FILE *f1 = fopen(nombreF1, "rb");
-    FILE *f2 = fopen(nombreF2, "rb");
-    FILE *f  = fopen(nombreF, "wb");
-    if (!f || !f1 || !f2) { perror("fopen mezcla"); exit(1); }
+    ArchivoLibros f1, f2, f;
+    if (!libros_abrir(&f1, nombreF1) ||
+        !libros_abrir(&f2, nombreF2) ||
+        !libros_crear(&f, nombreF, ORDEN_NINGUNO)) { perror("fopen mezcla"); exit(1); }
 
     *L = 0;
     Libro R1, R2;
-    int fin1 = fread(&R1, sizeof(Libro), 1, f1) != 1;
-    int fin2 = fread(&R2, sizeof(Libro), 1, f2) != 1;
+    int fin1 = !libros_leer(&f1, &R1);
+    int fin2 = !libros_leer(&f2, &R2);
 
     while (!fin1 && !fin2) {
         int fin_orden = 0;
         while (!fin_orden) {
             if (R1.anioPublicacion <= R2.anioPublicacion) {
-                fwrite(&R1, sizeof(Libro), 1, f);
-                leer_y_chequear(f1, &R1, &fin_orden);
-                if (fin_orden) copiar_secuencia(f2, f, &R2);
+                libros_anadir(&f, &R1);
+                leer_y_chequear(&f1, &R1, &fin_orden);
+                if (fin_orden) copiar_secuencia(&f2, &f, &R2);
             } else {
-                fwrite(&R2, sizeof(Libro), 1, f);
-                leer_y_chequear(f2, &R2, &fin_orden);
-                if (fin_orden) copiar_secuencia(f1, f, &R1);
+                libros_anadir(&f, &R2);
+                leer_y_chequear(&f2, &R2, &fin_orden);
+                if (fin_orden) copiar_secuencia(&f1, &f, &R1);
             }
         }
         (*L)++;
-        fin1 = feof(f1);
-        fin2 = feof(f2);
+        fin1 = libros_fin(&f1);
+        fin2 = libros_fin(&f2);
     }
 
     /// Copiar colas restantes
-    while (!feof(f1)) {
-        copiar_secuencia(f1, f, &R1);
+    while (!libros_fin(&f1)) {
+        copiar_secuencia(&f1, &f, &R1);
         (*L)++;
     }
-    while (!feof(f2)) {
-        copiar_secuencia(f2, f, &R2);
+    while (!libros_fin(&f2)) {
+        copiar_secuencia(&f2, &f, &R2);
         (*L)++;
     }
 
-    fclose(f);
-    fclose(f1);
-    fclose(f2);
+    if (*L <= 1) libros_fijar_orden(&f, ORDEN_ANIO); ///< Una sola secuencia: archivo ordenado
+
+    libros_cerrar(&f);
+    libros_cerrar(&f1);
+    libros_cerrar(&f2);
 }
@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "libros_io.h"
+#include "ordenacion_externa.h"
+
+/**
+ * @file ordenar_externo.c
+ * @brief Ordena un archivo binario de libros de cualquier tamaño por año, precio o título.
+ *
+ * Usa la ordenación externa de `ordenacion_externa.h`: secuencias iniciales
+ * por selección con reemplazo y mezcla de K vías con árbol de perdedores,
+ * equilibrada o polifásica.
+ *
+ * Uso:
+ *     ordenar_externo [--clave=anio|precio|titulo] [--memoria=M] [--vias=K]
+ *                     [--polifasica] [--radix] [ENTRADA [SALIDA]]
+ *
+ *  - `--clave`: campo de ordenación (por defecto el año).
+ *  - `--memoria`: registros que se mantienen en memoria (por defecto 262144).
+ *  - `--vias`: secuencias que se mezclan a la vez (por defecto 16).
+ *  - `--polifasica`: reparte las secuencias con la distribución polifásica.
+ *  - `--radix`: genera las secuencias ordenando bloques de M registros por
+ *    residuos (solo año y precio).
+ *  - ENTRADA: archivo a ordenar (por defecto `libros_biblioteca.bin`).
+ *  - SALIDA: archivo ordenado (por defecto el mismo que la entrada).
+ *
+ * @return 0 si la ordenación termina correctamente, 1 en caso de error.
+ */
+int main(int argc, char *argv[]) {
+    OpcionesOrdenacion op;
+    EstadisticasOrdenacion est;
+    const char *entrada = NULL, *salida = NULL;
+
+    opciones_ordenacion_defecto(&op, ORDEN_ANIO);
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--clave=", 8) == 0) {
+            const char *c = argv[i] + 8;
+            if (strcmp(c, "anio") == 0) op.clave = ORDEN_ANIO;
+            else if (strcmp(c, "precio") == 0) op.clave = ORDEN_PRECIO;
+            else if (strcmp(c, "titulo") == 0) op.clave = ORDEN_TITULO;
+            else {
+                fprintf(stderr, "Clave no válida: %s (use anio, precio o titulo)\n", c);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--memoria=", 10) == 0) {
+            op.memoria = atol(argv[i] + 10);
+        } else if (strncmp(argv[i], "--vias=", 7) == 0) {
+            op.fan_in = atoi(argv[i] + 7);
+        } else if (strcmp(argv[i], "--polifasica") == 0) {
+            op.polifasica = 1;
+        } else if (strcmp(argv[i], "--radix") == 0) {
+            op.radix = 1;
+        } else if (!entrada) {
+            entrada = argv[i];
+        } else {
+            salida = argv[i];
+        }
+    }
+    if (!entrada) entrada = NOMBRE_ARCHIVO;
+    if (!salida) salida = entrada;
+
+    printf("Ordenando '%s' por %s (M=%ld registros, K=%d, secuencias por %s, mezcla %s)...\n",
+           entrada, libros_nombre_orden(op.clave), op.memoria, op.fan_in,
+           op.radix && radix_admite(op.clave) ? "residuos" : "selección con reemplazo",
+           op.polifasica ? "polifásica" : "multivía equilibrada");
+
+    if (!ordenar_externo(entrada, salida, &op, &est)) {
+        fprintf(stderr, "Error durante la ordenación externa.\n");
+        return 1;
+    }
+
+    printf("OK: %ld registros ordenados en '%s'\n", est.registros, salida);
+    printf("Secuencias iniciales: %ld | %s de mezcla: %d | Registros escritos: %lld (%.2f pasadas)\n",
+           est.secuencias, op.polifasica ? "Fases" : "Pasadas", est.pasadas, est.escritos,
+           est.registros > 0 ? (double)est.escritos / est.registros : 0.0);
+    return 0;
+}
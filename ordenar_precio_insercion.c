@@ -1,21 +1,21 @@
 /**
  * @file ordenar_precio_insercion.c
- * @brief Ordenación de archivos binarios de libros por año mediante mezcla natural.
+ * @brief Ordenación híbrida de archivos binarios de libros (en memoria o externa).
  *
- * Este programa implementa la técnica de clasificación por mezcla natural para
- * ordenar registros de tipo `Libro` almacenados en un archivo binario.
- * La ordenación se realiza sin cargar todos los registros en memoria, usando
- * dos archivos auxiliares para dividir y mezclar secuencias ordenadas.
+ * Este programa ordena los registros de tipo `Libro` de un archivo binario
+ * por año (por defecto), precio o título, eligiendo el método según el tamaño:
  *
- * Funcionalidades principales:
- *  - Separación del archivo original en secuencias ordenadas alternas.
- *  - Mezcla de las secuencias mediante archivos auxiliares hasta obtener
- *    un archivo completamente ordenado.
- *  - Carga y visualización de los libros ordenados.
+ *  - Si el archivo cabe en el presupuesto de memoria, se carga con una sola
+ *    lectura y se ordenan pares (clave, índice) en lugar de los registros de
+ *    152 bytes (ver `ordenacion_memoria.h`): por residuos el año y el precio,
+ *    y con mezcla en paralelo el título. El resultado se escribe con una
+ *    única pasada secuencial.
+ *  - Si no cabe, se usa la ordenación externa con mezcla de K vías de
+ *    `ordenacion_externa.h`, con las secuencias iniciales también ordenadas
+ *    por residuos para el año y el precio.
  *
- * Archivos auxiliares:
- *  - AUX1 ("aux1.bin"): primer archivo temporal para secuencias.
- *  - AUX2 ("aux2.bin"): segundo archivo temporal para secuencias.
+ * Archivos:
+ *  - NOMBRE_ARCHIVO ("libros_biblioteca.bin"): archivo original a ordenar.
  *  - ARCHIVO_ORDENADO ("libros_biblioteca_anio.bin"): archivo final ordenado.
  *
  * Autor: Kun Chen Lin
@@ -24,54 +24,40 @@
  *
  * Requisitos:
  *  - common.h: definición de la estructura `Libro` y macros de archivo.
+ *  - libros_io.h: lectura y escritura del formato binario con cabecera.
+ *  - ordenacion_memoria.h, ordenacion_radix.h y ordenacion_externa.h: los métodos de ordenación.
  *
  * Ejemplo de uso:
- *  Ejecutar el programa para ordenar 'biblioteca.bin' y mostrar resultados:
- *      ./ordenar_precio_insercion.out
+ *  Ordenar 'libros_biblioteca.bin' y mostrar resultados (compilar con -pthread):
+ *      ./ordenar_precio_insercion.out [--clave=anio|precio|titulo] [--memoria=MB]
+ *                                     [--hilos=N] [--externa] [--sin-radix] [ENTRADA [SALIDA]]
  */
 
-
-
-
 #include "common.h"
+#include "libros_io.h"
+#include "ordenacion_memoria.h"
+#include "ordenacion_externa.h"
 
-#define AUX1 "aux1.bin"                  ///< Nombre del primer archivo auxiliar
-#define AUX2 "aux2.bin"                  ///< Nombre del segundo archivo auxiliar
 #define ARCHIVO_ORDENADO "libros_biblioteca_anio.bin" ///< Archivo final ordenado
-#define NOMBRE_ARCHIVO "biblioteca.bin"  ///< Archivo original a ordenar
 
 // ------------------------------------------------------
 // Prototipos de funciones
 // ------------------------------------------------------
 
 /**
- * @brief Ordena un archivo binario de libros mediante el método de mezcla natural.
- * @param NOMBRE_F Archivo principal.
- * @param NOMBRE_F1 Primer archivo auxiliar.
- * @param NOMBRE_F2 Segundo archivo auxiliar.
+ * @brief Ordena un archivo de libros en memoria si cabe en el presupuesto
+ *        y, si no, con la ordenación externa.
+ * @param entrada Archivo a ordenar.
+ * @param salida Archivo ordenado.
+ * @param clave Campo de ordenación.
+ * @param presupuesto Bytes de memoria disponibles para ordenar.
+ * @param hilos Hilos de la ordenación en memoria (<= 0 para todos los núcleos).
+ * @param forzar_externa 1 para usar siempre la ordenación externa.
+ * @param radix 1 para ordenar por residuos las claves numéricas.
+ * @return 1 si la ordenación termina correctamente, 0 en caso de error.
  */
-void clasificacion_mezcla_natural(const char *NOMBRE_F,
-                                  const char *NOMBRE_F1,
-                                  const char *NOMBRE_F2);
-
-/**
- * @brief Divide el archivo original en dos archivos auxiliares según las secuencias ordenadas.
- * @param NOMBRE_F Archivo principal.
- * @param NOMBRE_F1 Primer archivo auxiliar.
- * @param NOMBRE_F2 Segundo archivo auxiliar.
- */
-void separar(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2);
-
-/**
- * @brief Mezcla las subsecuencias ordenadas de los archivos auxiliares en un archivo de salida.
- * @param NOMBRE_F Archivo destino de la mezcla.
- * @param NOMBRE_F1 Primer archivo auxiliar.
- * @param NOMBRE_F2 Segundo archivo auxiliar.
- * @return Número de subsecuencias mezcladas.
- */
-int mezcla_natural(const char *NOMBRE_F,
-                   const char *NOMBRE_F1,
-                   const char *NOMBRE_F2);
+int ordenar_hibrido(const char *entrada, const char *salida, ClaveOrden clave,
+                    long presupuesto, int hilos, int forzar_externa, int radix);
 
 /**
  * @brief Carga todos los libros de un archivo binario en memoria.
@@ -83,33 +69,64 @@ Libro *cargar_libros(const char *nombre_f, int *n);
 
 /**
  * @brief Cuenta el número de libros en un archivo binario.
+ *
+ * El número se lee de la cabecera del archivo, sin recorrerlo.
+ *
  * @param nombre_f Archivo binario.
  * @return Número de registros de tipo Libro.
  */
 int contar_libros(const char *nombre_f);
 
+/**
+ * @brief Muestra en pantalla un vector de libros.
+ * @param libros Vector de libros.
+ * @param n Número de libros.
+ */
+void mostrar_libros(const Libro *libros, int n);
+
 // ------------------------------------------------------
 // Función principal
 // ------------------------------------------------------
 
 /**
- * @brief Función principal que ordena un archivo de libros por año
- *        usando mezcla natural y muestra el resultado.
- * @return 0 si todo va bien.
+ * @brief Función principal que ordena un archivo de libros y muestra el resultado.
+ * @return 0 si todo va bien, 1 en caso de error.
  */
-int main(void) {
-    printf("Ordenando archivo '%s' por año de publicación...\n", NOMBRE_ARCHIVO);
+int main(int argc, char *argv[]) {
+    const char *entrada = NULL, *salida = NULL;
+    ClaveOrden clave = ORDEN_ANIO;
+    long presupuesto = ORDEN_MEM_PRESUPUESTO_DEFECTO;
+    int hilos = 0, forzar_externa = 0, radix = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--clave=precio") == 0) clave = ORDEN_PRECIO;
+        else if (strcmp(argv[i], "--clave=titulo") == 0) clave = ORDEN_TITULO;
+        else if (strcmp(argv[i], "--clave=anio") == 0) clave = ORDEN_ANIO;
+        else if (strncmp(argv[i], "--memoria=", 10) == 0) presupuesto = atol(argv[i] + 10) * 1024L * 1024L;
+        else if (strncmp(argv[i], "--hilos=", 8) == 0) hilos = atoi(argv[i] + 8);
+        else if (strcmp(argv[i], "--externa") == 0) forzar_externa = 1;
+        else if (strcmp(argv[i], "--sin-radix") == 0) radix = 0;
+        else if (!entrada) entrada = argv[i];
+        else salida = argv[i];
+    }
+    if (!entrada) entrada = NOMBRE_ARCHIVO;
+    if (!salida) salida = ARCHIVO_ORDENADO;
+
+    printf("Ordenando archivo '%s' por %s...\n", entrada, libros_nombre_orden(clave));
 
     // Ordenar archivo
-    clasificacion_mezcla_natural(NOMBRE_ARCHIVO, AUX1, AUX2);
+    if (!ordenar_hibrido(entrada, salida, clave, presupuesto, hilos, forzar_externa, radix)) {
+        fprintf(stderr, "No se pudo ordenar el archivo '%s'.\n", entrada);
+        return 1;
+    }
 
-    printf("\nArchivo ordenado guardado como '%s'\n", ARCHIVO_ORDENADO);
+    printf("\nArchivo ordenado guardado como '%s'\n", salida);
 
     // Mostrar el resultado
     int n;
-    Libro *libros = cargar_libros(ARCHIVO_ORDENADO, &n);
+    Libro *libros = cargar_libros(salida, &n);
     if (libros && n > 0) {
-        printf("\nLibros ordenados por año:\n\n");
+        printf("\nLibros ordenados por %s:\n\n", libros_nombre_orden(clave));
         mostrar_libros(libros, n);
         free(libros);
     } else {
@@ -120,102 +137,34 @@ int main(void) {
 }
 
 // ------------------------------------------------------
-// Implementación de mezcla natural
+// Ordenación híbrida
 // ------------------------------------------------------
 
-void clasificacion_mezcla_natural(const char *NOMBRE_F,
-                                  const char *NOMBRE_F1,
-                                  const char *NOMBRE_F2)
+int ordenar_hibrido(const char *entrada, const char *salida, ClaveOrden clave,
+                    long presupuesto, int hilos, int forzar_externa, int radix)
 {
-    int L;
-
-    do {
-        separar(NOMBRE_F, NOMBRE_F1, NOMBRE_F2);        ///< Separa en auxiliares
-        L = mezcla_natural(ARCHIVO_ORDENADO, NOMBRE_F1, NOMBRE_F2); ///< Mezcla las secuencias
-        rename(ARCHIVO_ORDENADO, NOMBRE_F);            ///< Reemplaza archivo original
-    } while (L > 1);
-
-    rename(NOMBRE_F, ARCHIVO_ORDENADO);               ///< Archivo final ordenado
-}
-
-void separar(const char *NOMBRE_F, const char *NOMBRE_F1, const char *NOMBRE_F2) {
-    FILE *f = fopen(NOMBRE_F, "rb");
-    FILE *f1 = fopen(NOMBRE_F1, "wb");
-    FILE *f2 = fopen(NOMBRE_F2, "wb");
-
-    if (!f || !f1 || !f2) {
-        perror("Error abriendo archivos en separar()");
-        exit(EXIT_FAILURE);
-    }
-
-    Libro actual, anterior;
-    int toggle = 0; ///< Alterna entre archivo f1 y f2
-
-    if (fread(&anterior, sizeof(Libro), 1, f)) {
-        fwrite(&anterior, sizeof(Libro), 1, toggle ? f2 : f1);
-        while (fread(&actual, sizeof(Libro), 1, f)) {
-            if (actual.anioPublicacion < anterior.anioPublicacion)
-                toggle = !toggle; ///< Detecta ruptura de secuencia
-            fwrite(&actual, sizeof(Libro), 1, toggle ? f2 : f1);
-            anterior = actual;
-        }
+    long n = contar_libros(entrada);
+    radix = radix && radix_admite(clave);
+
+    if (!forzar_externa && ordenacion_memoria_necesaria(n) <= presupuesto) {
+        if (radix) printf("Modo en memoria: %ld registros, ordenación por residuos\n", n);
+        else printf("Modo en memoria: %ld registros, mezcla con %d hilos\n", n,
+                    hilos > 0 ? hilos : ordenacion_num_hilos());
+        return ordenar_libros_memoria(entrada, salida, clave, hilos, radix) >= 0;
     }
 
-    fclose(f);
-    fclose(f1);
-    fclose(f2);
-}
-
-int mezcla_natural(const char *NOMBRE_F,
-                   const char *NOMBRE_F1,
-                   const char *NOMBRE_F2)
-{
-    FILE *f = fopen(NOMBRE_F, "wb");
-    FILE *f1 = fopen(NOMBRE_F1, "rb");
-    FILE *f2 = fopen(NOMBRE_F2, "rb");
-
-    if (!f || !f1 || !f2) {
-        perror("Error abriendo archivos en mezcla_natural()");
-        exit(EXIT_FAILURE);
-    }
-
-    Libro a, b;
-    int hayA = fread(&a, sizeof(Libro), 1, f1);
-    int hayB = fread(&b, sizeof(Libro), 1, f2);
-    int L = 0;
-
-    while (hayA || hayB) {
-        L++; ///< Cada mezcla forma una subsecuencia ordenada
-
-        // Mezcla hasta que se acaben los elementos de ambos
-        while (hayA && hayB) {
-            if (a.anioPublicacion <= b.anioPublicacion) {
-                fwrite(&a, sizeof(Libro), 1, f);
-                hayA = fread(&a, sizeof(Libro), 1, f1);
-            } else {
-                fwrite(&b, sizeof(Libro), 1, f);
-                hayB = fread(&b, sizeof(Libro), 1, f2);
-            }
-        }
-
-        // Copia colas restantes
-        while (hayA) {
-            fwrite(&a, sizeof(Libro), 1, f);
-            hayA = fread(&a, sizeof(Libro), 1, f1);
-        }
-        while (hayB) {
-            fwrite(&b, sizeof(Libro), 1, f);
-            hayB = fread(&b, sizeof(Libro), 1, f2);
-        }
-
-        hayA = fread(&a, sizeof(Libro), 1, f1);
-        hayB = fread(&b, sizeof(Libro), 1, f2);
-    }
-
-    fclose(f);
-    fclose(f1);
-    fclose(f2);
-    return L;
+    // No cabe: ordenación externa con el mismo presupuesto de memoria
+    OpcionesOrdenacion op;
+    EstadisticasOrdenacion est;
+    opciones_ordenacion_defecto(&op, clave);
+    op.radix = radix;
+    op.memoria = presupuesto / (long)(radix ? sizeof(Libro) + 2 * sizeof(ParClave) : sizeof(Libro));
+    if (op.memoria < 1) op.memoria = 1;
+
+    printf("Modo externo: %ld registros, %ld en memoria\n", n, op.memoria);
+    if (!ordenar_externo(entrada, salida, &op, &est)) return 0;
+    printf("Secuencias iniciales: %ld | Pasadas de mezcla: %d\n", est.secuencias, est.pasadas);
+    return 1;
 }
 
 // ------------------------------------------------------
@@ -223,17 +172,26 @@ int mezcla_natural(const char *NOMBRE_F,
 // ------------------------------------------------------
 
 int contar_libros(const char *nombre_f) {
-    FILE *f = fopen(nombre_f, "rb");
-    if (!f) return 0;
-    fseek(f, 0, SEEK_END);
-    long bytes = ftell(f);
-    fclose(f);
-    return (int)(bytes / sizeof(Libro));
+    ArchivoLibros f;
+    if (!libros_abrir(&f, nombre_f)) return 0;
+    int n = (int)libros_total(&f);
+    libros_cerrar(&f);
+    return n;
 }
 
 Libro *cargar_libros(const char *nombre_f, int *n) {
-    *n = contar_libros(nombre_f);
-    if (*n == 0) return NULL;
+    ArchivoLibros f;
+    if (!libros_abrir(&f, nombre_f)) {
+        perror("Error al abrir archivo para leer libros");
+        *n = 0;
+        return NULL;
+    }
+
+    *n = (int)libros_total(&f);
+    if (*n == 0) {
+        libros_cerrar(&f);
+        return NULL;
+    }
 
     Libro *V = malloc(sizeof(Libro) * (*n));
     if (!V) {
@@ -241,15 +199,16 @@ Libro *cargar_libros(const char *nombre_f, int *n) {
         exit(EXIT_FAILURE);
     }
 
-    FILE *f = fopen(nombre_f, "rb");
-    if (!f) {
-        perror("Error al abrir archivo para leer libros");
-        free(V);
-        *n = 0;
-        return NULL;
-    }
-
-    fread(V, sizeof(Libro), *n, f);
-    fclose(f);
+    *n = (int)libros_leer_varios(&f, V, (size_t)*n);
+    libros_cerrar(&f);
     return V;
 }
+
+void mostrar_libros(const Libro *libros, int n) {
+    printf("%-5s | %-5s | %-40s | %-25s | %-8s |\n", "POS", "AÑO", "TÍTULO", "AUTOR", "PRECIO");
+    printf("----------------------------------------------------------------------------------------------------\n");
+    for (int i = 0; i < n; i++) {
+        printf("%-5d | %-5d | %-40s | %-25s | %-8.2f |\n",
+               i + 1, libros[i].anioPublicacion, libros[i].titulo, libros[i].autor, libros[i].precio);
+    }
+}
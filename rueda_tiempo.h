@@ -0,0 +1,558 @@
+#ifndef RUEDA_TIEMPO_H
+#define RUEDA_TIEMPO_H
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+#include "monticulo_dario.h"
+
+/**
+ * @file rueda_tiempo.h
+ * @brief Rueda de tiempo jerárquica (cola de calendario) para claves AAAAMMDDHHMM.
+ *
+ * Las salidas llegan casi en orden de hora y se atienden en orden de hora,
+ * así que en lugar de un montículo se pueden repartir en cubetas por tiempo:
+ *
+ *  - 60 cubetas de minuto para la hora en curso (todas las claves de una
+ *    cubeta son iguales),
+ *  - 24 cubetas de hora para el resto del día en curso,
+ *  - @ref RUEDA_DIAS cubetas de día para los días siguientes,
+ *  - y dos montículos pequeños para lo que cae fuera de la rueda: las claves
+ *    más lejanas que la última cubeta de día y las que llegan tarde (menores
+ *    que el cursor, ya dejado atrás).
+ *
+ * El cursor `ahora` (en minutos) solo avanza mientras haya salidas. Al pasar de
+ * hora o de día la cubeta a la que se llega se reparte en el nivel inferior, así
+ * que cada salida baja como mucho dos veces; un mapa de bits por nivel encuentra
+ * la siguiente cubeta ocupada sin recorrerlas. Insertar y extraer el mínimo
+ * cuestan O(1) amortizado (O(log n) solo para las claves fuera de la rueda) y
+ * quitar una salida cualquiera, O(1) con su nodo.
+ *
+ * Cada cubeta es un vector de nodos con sus minutos al lado (como las claves del
+ * montículo d-ario), de modo que repartirla recorre memoria contigua y los nodos
+ * (32 bytes) solo se tocan para apuntar su nueva cubeta. Los nodos salen de una
+ * arena (arena.h) y no se mueven: sirven de handle para quitar o reprogramar una
+ * salida. El dato de cada salida es un puntero opaco que la rueda no libera.
+ */
+
+/** @brief Cubetas del nivel de minutos (una hora). */
+#define RUEDA_MINUTOS 60
+
+/** @brief Cubetas del nivel de horas (un día). */
+#define RUEDA_HORAS 24
+
+/** @brief Cubetas del nivel de días (una por bit del mapa de 64 bits). */
+#define RUEDA_DIAS 64
+
+/** @brief Nodos del primer bloque de la arena de la rueda. */
+#define RUEDA_NODOS_BLOQUE 256
+
+/** @brief Capacidad de una cubeta la primera vez que se usa. */
+#define RUEDA_CUBETA_INICIAL 8
+
+/** @brief Dónde está un nodo de la rueda (los tres primeros indexan `ocupados`). */
+enum { RUEDA_MINUTO, RUEDA_HORA, RUEDA_DIA, RUEDA_LEJANO, RUEDA_ATRASADO };
+
+/**
+ * @struct NodoRueda
+ * @brief Una salida programada en la rueda.
+ */
+typedef struct NodoRueda {
+    long long clave;   /**< Clave AAAAMMDDHHMM. */
+    void *dato;        /**< Dato asociado (el vuelo). */
+    int nivel;         /**< RUEDA_MINUTO .. RUEDA_ATRASADO. */
+    int cubeta;        /**< Cubeta dentro de su nivel (solo niveles de la rueda). */
+    int pos;           /**< Posición en la cubeta, o en el montículo si está fuera de la rueda. */
+} NodoRueda;
+
+/**
+ * @struct CubetaRueda
+ * @brief Vector de salidas de una cubeta, con el minuto de cada una aparte.
+ */
+typedef struct {
+    long long *minutos;  /**< minutos[i] es el minuto absoluto de nodos[i]. */
+    NodoRueda **nodos;   /**< Salidas de la cubeta, sin orden. */
+    int tamano;          /**< Salidas en la cubeta. */
+    int capacidad;       /**< Salidas que caben sin redimensionar. */
+} CubetaRueda;
+
+/** @brief Guarda en el nodo su posición en el montículo de lejanas o atrasadas. */
+#define RUEDA_POSICION(nodo, i) ((nodo)->pos = (i))
+
+MONTICULO_DEFINIR(rueda, long long, NodoRueda*, 4, RUEDA_POSICION)
+
+/**
+ * @struct RuedaTiempo
+ * @brief Rueda de tiempo con sus tres niveles de cubetas.
+ */
+typedef struct {
+    CubetaRueda minutos[RUEDA_MINUTOS];  /**< Minutos de la hora en curso. */
+    CubetaRueda horas[RUEDA_HORAS];      /**< Horas del día en curso. */
+    CubetaRueda dias[RUEDA_DIAS];        /**< Días siguientes (índice día % RUEDA_DIAS). */
+    uint64_t ocupados[3];                /**< Bit b de ocupados[nivel]: cubeta b del nivel no vacía. */
+    Monticulo_rueda lejanos;             /**< Claves más allá de la última cubeta de día. */
+    Monticulo_rueda atrasados;           /**< Claves anteriores al cursor. */
+    long long ahora;                     /**< Cursor en minutos absolutos. */
+    int tamano;                          /**< Salidas en la rueda. */
+    Arena nodos;                         /**< Arena de los NodoRueda. */
+} RuedaTiempo;
+
+/**
+ * @brief Convierte una clave AAAAMMDDHHMM en minutos desde una fecha fija.
+ *
+ * Los días se cuentan con el calendario gregoriano (años de marzo a febrero,
+ * para que el día bisiesto quede al final), así que dos claves consecutivas en
+ * el tiempo dan minutos consecutivos aunque cambie el mes o el año.
+ */
+static inline long long rueda_minuto_absoluto(long long clave) {
+    long long a = clave / 100000000LL;
+    int mes = (int)(clave / 1000000 % 100);
+    int dia = (int)(clave / 10000 % 100);
+    int hora = (int)(clave / 100 % 100);
+    int minuto = (int)(clave % 100);
+
+    if (mes <= 2) a--;
+    long long era = a / 400;
+    long long anio_era = a - era * 400;
+    long long dia_anio = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+    long long dia_era = anio_era * 365 + anio_era / 4 - anio_era / 100 + dia_anio;
+    long long dias = era * 146097 + dia_era;
+    return dias * 1440 + hora * 60 + minuto;
+}
+
+/** @brief Índice del bit menos significativo a 1 (@p x no puede ser 0). */
+static inline int rueda_primer_bit(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int b = 0;
+    while (!(x & 1)) { x >>= 1; b++; }
+    return b;
+#endif
+}
+
+/**
+ * @brief Prepara una rueda vacía.
+ * @return 1 si se crea, 0 si no hay memoria.
+ */
+static inline int rueda_crear(RuedaTiempo *r) {
+    memset(r, 0, sizeof(*r));
+    Arena nodos = ARENA_INICIAL(sizeof(NodoRueda), RUEDA_NODOS_BLOQUE);
+    r->nodos = nodos;
+    if (!monticulo_rueda_crear(&r->lejanos, 16) || !monticulo_rueda_crear(&r->atrasados, 16)) {
+        monticulo_rueda_liberar(&r->lejanos);
+        monticulo_rueda_liberar(&r->atrasados);
+        return 0;
+    }
+    return 1;
+}
+
+/** @brief Libera todos los nodos y cubetas de la rueda de una vez. */
+static inline void rueda_liberar(RuedaTiempo *r) {
+    for (int i = 0; i < RUEDA_MINUTOS; i++) { free(r->minutos[i].minutos); free(r->minutos[i].nodos); }
+    for (int i = 0; i < RUEDA_HORAS; i++) { free(r->horas[i].minutos); free(r->horas[i].nodos); }
+    for (int i = 0; i < RUEDA_DIAS; i++) { free(r->dias[i].minutos); free(r->dias[i].nodos); }
+    arena_destruir(&r->nodos);
+    monticulo_rueda_liberar(&r->lejanos);
+    monticulo_rueda_liberar(&r->atrasados);
+    memset(r, 0, sizeof(*r));
+}
+
+/** @brief Cubeta @p b del nivel @p nivel (RUEDA_MINUTO, RUEDA_HORA o RUEDA_DIA). */
+static inline CubetaRueda *rueda_cubeta(RuedaTiempo *r, int nivel, int b) {
+    if (nivel == RUEDA_MINUTO) return &r->minutos[b];
+    if (nivel == RUEDA_HORA) return &r->horas[b];
+    return &r->dias[b];
+}
+
+/**
+ * @brief Nivel y cubeta que le tocan a un minuto con el cursor actual.
+ * @param r Rueda.
+ * @param m Minuto absoluto.
+ * @param b Recibe la cubeta (solo niveles de la rueda).
+ * @return RUEDA_MINUTO .. RUEDA_ATRASADO.
+ */
+static inline int rueda_nivel(const RuedaTiempo *r, long long m, int *b) {
+    if (m < r->ahora) return RUEDA_ATRASADO;
+    if (m / 60 == r->ahora / 60) { *b = (int)(m % 60); return RUEDA_MINUTO; }
+    if (m / 1440 == r->ahora / 1440) { *b = (int)(m / 60 % 24); return RUEDA_HORA; }
+    if (m / 1440 - r->ahora / 1440 < RUEDA_DIAS) { *b = (int)(m / 1440 % RUEDA_DIAS); return RUEDA_DIA; }
+    return RUEDA_LEJANO;
+}
+
+/**
+ * @brief Asegura sitio en una cubeta para @p n salidas más.
+ * @return 1 si caben, 0 si no hay memoria (la cubeta no cambia).
+ */
+static inline int rueda_cubeta_reservar(CubetaRueda *c, int n) {
+    if (c->tamano + n <= c->capacidad) return 1;
+    int capacidad = c->capacidad > 0 ? c->capacidad * 2 : RUEDA_CUBETA_INICIAL;
+    if (capacidad < c->tamano + n) capacidad = c->tamano + n;
+
+    long long *minutos = realloc(c->minutos, sizeof(long long) * (size_t)capacidad);
+    if (minutos == NULL) return 0;
+    c->minutos = minutos;
+    NodoRueda **nodos = realloc(c->nodos, sizeof(NodoRueda *) * (size_t)capacidad);
+    if (nodos == NULL) return 0;
+    c->nodos = nodos;
+    c->capacidad = capacidad;
+    return 1;
+}
+
+/** @brief Añade un nodo a la cubeta @p b de @p nivel, que ya tiene sitio. */
+static inline void rueda_meter(RuedaTiempo *r, int nivel, int b, NodoRueda *n, long long m) {
+    CubetaRueda *c = rueda_cubeta(r, nivel, b);
+    c->minutos[c->tamano] = m;
+    c->nodos[c->tamano] = n;
+    n->nivel = nivel;
+    n->cubeta = b;
+    n->pos = c->tamano++;
+    r->ocupados[nivel] |= 1ULL << b;
+}
+
+/**
+ * @brief Coloca un nodo en el nivel que le toca según el cursor.
+ * @param r Rueda.
+ * @param n Nodo.
+ * @param m Su clave en minutos absolutos.
+ * @return 1 si se coloca, 0 si no hay memoria (el nodo queda fuera de la rueda).
+ */
+static inline int rueda_colocar(RuedaTiempo *r, NodoRueda *n, long long m) {
+    int b = 0;
+    int nivel = rueda_nivel(r, m, &b);
+    if (nivel == RUEDA_ATRASADO || nivel == RUEDA_LEJANO) {
+        if (!monticulo_rueda_insertar(nivel == RUEDA_ATRASADO ? &r->atrasados : &r->lejanos, n->clave, n)) return 0;
+        n->nivel = nivel;
+        return 1;
+    }
+    if (!rueda_cubeta_reservar(rueda_cubeta(r, nivel, b), 1)) return 0;
+    rueda_meter(r, nivel, b, n, m);
+    return 1;
+}
+
+/** @brief Desengancha un nodo de su cubeta o de su montículo, sin liberarlo. */
+static inline void rueda_desenganchar(RuedaTiempo *r, NodoRueda *n) {
+    if (n->nivel == RUEDA_ATRASADO) { monticulo_rueda_quitar(&r->atrasados, n->pos); return; }
+    if (n->nivel == RUEDA_LEJANO) { monticulo_rueda_quitar(&r->lejanos, n->pos); return; }
+
+    /// La última salida de la cubeta ocupa su hueco.
+    CubetaRueda *c = rueda_cubeta(r, n->nivel, n->cubeta);
+    int ultima = --c->tamano;
+    if (n->pos < ultima) {
+        c->minutos[n->pos] = c->minutos[ultima];
+        c->nodos[n->pos] = c->nodos[ultima];
+        c->nodos[n->pos]->pos = n->pos;
+    }
+    if (c->tamano == 0) r->ocupados[n->nivel] &= ~(1ULL << n->cubeta);
+}
+
+/**
+ * @brief Mueve el cursor a @p nuevo y reparte la cubeta @p b de @p nivel en los niveles inferiores.
+ *
+ * Primero se cuentan las salidas que van a cada cubeta de destino y se reserva el
+ * sitio, así que si falta memoria no se mueve nada (ni el cursor).
+ *
+ * @return 1 si se reparte, 0 si no hay memoria.
+ */
+static inline int rueda_repartir(RuedaTiempo *r, int nivel, int b, long long nuevo) {
+    CubetaRueda *c = rueda_cubeta(r, nivel, b);
+    long long anterior = r->ahora;
+    int cuenta[RUEDA_MINUTOS + RUEDA_HORAS] = {0};
+    int d = 0;
+
+    r->ahora = nuevo;
+    for (int i = 0; i < c->tamano; i++) {
+        int destino = rueda_nivel(r, c->minutos[i], &d); // Siempre minuto u hora del nuevo cursor
+        cuenta[destino == RUEDA_MINUTO ? d : RUEDA_MINUTOS + d]++;
+    }
+    for (int i = 0; i < RUEDA_MINUTOS + RUEDA_HORAS; i++) {
+        if (cuenta[i] == 0) continue;
+        CubetaRueda *destino = i < RUEDA_MINUTOS ? &r->minutos[i] : &r->horas[i - RUEDA_MINUTOS];
+        if (!rueda_cubeta_reservar(destino, cuenta[i])) {
+            r->ahora = anterior;
+            return 0;
+        }
+    }
+
+    for (int i = 0; i < c->tamano; i++) {
+        int destino = rueda_nivel(r, c->minutos[i], &d);
+        rueda_meter(r, destino, d, c->nodos[i], c->minutos[i]);
+    }
+    c->tamano = 0;
+    r->ocupados[nivel] &= ~(1ULL << b);
+    return 1;
+}
+
+/**
+ * @brief Pasa a la rueda las salidas lejanas que ya caben en ella.
+ * @return 1 si se pasan todas, 0 si falta memoria (las que quedan siguen en lejanos).
+ */
+static inline int rueda_traer_lejanos(RuedaTiempo *r) {
+    while (r->lejanos.tamano > 0 &&
+           rueda_minuto_absoluto(r->lejanos.claves[0]) / 1440 - r->ahora / 1440 < RUEDA_DIAS) {
+        long long clave;
+        NodoRueda *n = monticulo_rueda_extraer(&r->lejanos, &clave);
+        if (!rueda_colocar(r, n, rueda_minuto_absoluto(clave))) {
+            monticulo_rueda_insertar(&r->lejanos, n->clave, n); // Cabe: acaba de salir
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Avanza el cursor hasta la primera cubeta de minuto ocupada, sin pasar de @p limite.
+ *
+ * Se busca primero en la hora en curso, luego en las horas siguientes del día,
+ * luego en los días siguientes y por último entre las lejanas; cada vez que se
+ * cambia de hora o de día se reparte la cubeta a la que se llega. El cursor no
+ * pasa del límite para que las salidas que se programen hasta entonces no
+ * queden por detrás de él.
+ *
+ * @param r Rueda.
+ * @param limite Minuto absoluto máximo del cursor.
+ * @return 1 si avanza, 0 si falta memoria para repartir una cubeta.
+ */
+static inline int rueda_avanzar(RuedaTiempo *r, long long limite) {
+    while (r->tamano > r->atrasados.tamano) {
+        int minuto = (int)(r->ahora % 60);
+        uint64_t resto = r->ocupados[RUEDA_MINUTO] >> minuto;
+        if (resto != 0) {
+            if (r->ahora + rueda_primer_bit(resto) <= limite) r->ahora += rueda_primer_bit(resto);
+            return 1;
+        }
+
+        long long hora = r->ahora / 60;
+        int h = (int)(hora % 24);
+        resto = h + 1 < RUEDA_HORAS ? r->ocupados[RUEDA_HORA] >> (h + 1) : 0;
+        if (resto != 0) {
+            int b = h + 1 + rueda_primer_bit(resto);
+            if ((hora - h + b) * 60 > limite) return 1;
+            if (!rueda_repartir(r, RUEDA_HORA, b, (hora - h + b) * 60)) return 0;
+            continue;
+        }
+
+        long long dia = r->ahora / 1440;
+        int d = (int)(dia % RUEDA_DIAS);
+        /// Días siguientes en orden circular: se gira el mapa para que el bit 0 sea mañana.
+        uint64_t dias = r->ocupados[RUEDA_DIA];
+        uint64_t girado = (dias >> ((d + 1) % RUEDA_DIAS)) | (d + 1 == RUEDA_DIAS ? 0 : dias << (RUEDA_DIAS - 1 - d));
+        if (girado != 0) {
+            long long nuevo = dia + 1 + rueda_primer_bit(girado);
+            if (nuevo * 1440 > limite) return 1;
+            if (!rueda_repartir(r, RUEDA_DIA, (int)(nuevo % RUEDA_DIAS), nuevo * 1440)) return 0;
+            if (!rueda_traer_lejanos(r)) return 0;
+            continue;
+        }
+
+        /// Rueda vacía: se salta al día de la lejana más próxima.
+        long long nuevo = rueda_minuto_absoluto(r->lejanos.claves[0]) / 1440 * 1440;
+        if (nuevo > limite) return 1;
+        r->ahora = nuevo;
+        if (!rueda_traer_lejanos(r)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Programa una salida.
+ * @param r Rueda.
+ * @param clave Clave AAAAMMDDHHMM.
+ * @param dato Dato asociado.
+ * @return El nodo de la salida (para quitarla con rueda_quitar), o NULL si no hay memoria.
+ */
+static inline NodoRueda *rueda_insertar(RuedaTiempo *r, long long clave, void *dato) {
+    NodoRueda *n = arena_reservar(&r->nodos);
+    if (n == NULL) return NULL;
+    long long m = rueda_minuto_absoluto(clave);
+    n->clave = clave;
+    n->dato = dato;
+    if (r->tamano == 0) r->ahora = m / 1440 * 1440; // Rueda vacía: el cursor empieza en su día
+    if (!rueda_colocar(r, n, m)) {
+        arena_liberar(&r->nodos, n);
+        return NULL;
+    }
+    r->tamano++;
+    return n;
+}
+
+/** @brief Quita una salida cualquiera de la rueda y libera su nodo. */
+static inline void rueda_quitar(RuedaTiempo *r, NodoRueda *n) {
+    rueda_desenganchar(r, n);
+    arena_liberar(&r->nodos, n);
+    r->tamano--;
+}
+
+/**
+ * @brief Salida con la menor clave si no pasa de @p limite (en minutos), sin quitarla.
+ * @return Su nodo, o NULL si no hay ninguna hasta el límite o falta memoria para repartir una cubeta.
+ */
+static inline NodoRueda *rueda_primera(RuedaTiempo *r, long long limite) {
+    if (r->atrasados.tamano > 0) {
+        return rueda_minuto_absoluto(r->atrasados.claves[0]) <= limite ? r->atrasados.datos[0] : NULL;
+    }
+    if (r->tamano == 0 || !rueda_avanzar(r, limite)) return NULL;
+
+    /// Vacía si el cursor se ha parado antes del límite.
+    CubetaRueda *c = &r->minutos[r->ahora % 60];
+    return c->tamano > 0 && c->minutos[0] <= limite ? c->nodos[c->tamano - 1] : NULL;
+}
+
+/**
+ * @brief Salida con la menor clave, sin quitarla (puede avanzar el cursor hasta ella).
+ * @return Su nodo, o NULL si la rueda está vacía o falta memoria para repartir una cubeta.
+ */
+static inline NodoRueda *rueda_minimo(RuedaTiempo *r) {
+    return rueda_primera(r, LLONG_MAX);
+}
+
+/**
+ * @brief Salida con la menor clave si ya ha llegado su hora, sin quitarla.
+ *
+ * Es la consulta de cada tic del reloj: el cursor avanza como mucho hasta
+ * @p ahora, así que las salidas que se programen después para más tarde
+ * siguen entrando en las cubetas.
+ *
+ * @param r Rueda.
+ * @param ahora Clave AAAAMMDDHHMM de la hora actual.
+ * @return Su nodo, o NULL si ninguna salida tiene clave menor o igual que @p ahora.
+ */
+static inline NodoRueda *rueda_vencida(RuedaTiempo *r, long long ahora) {
+    return rueda_primera(r, rueda_minuto_absoluto(ahora));
+}
+
+/**
+ * @brief Quita la salida con la menor clave.
+ * @param r Rueda (no vacía).
+ * @param clave Si no es NULL, recibe la clave de la salida.
+ * @return El dato de la salida, o NULL si falta memoria para repartir una cubeta.
+ */
+static inline void *rueda_extraer(RuedaTiempo *r, long long *clave) {
+    NodoRueda *n = rueda_minimo(r);
+    if (n == NULL) return NULL;
+    void *dato = n->dato;
+    if (clave != NULL) *clave = n->clave;
+    rueda_quitar(r, n);
+    return dato;
+}
+
+/**
+ * @struct RecorridoRueda
+ * @brief Recorrido en orden de una rueda sin modificarla.
+ *
+ * Las cubetas de minuto ya están en orden (todas sus claves son iguales); las
+ * de hora y de día se copian y se ordenan al llegar a ellas, y los dos
+ * montículos se recorren con la frontera de monticulo_dario.h.
+ */
+typedef struct {
+    const RuedaTiempo *r;
+    int fase;                       /**< Nivel que se está recorriendo (orden: atrasados, minutos, horas, días, lejanos). */
+    int indice;                     /**< Cubeta siguiente dentro del nivel. */
+    NodoRueda **cubeta;             /**< Copia de la cubeta actual, en orden. */
+    int tamano, usados, capacidad;  /**< Nodos en la copia, ya entregados y que caben. */
+    RecorridoMonticulo_rueda monticulo;
+} RecorridoRueda;
+
+/** @brief Compara dos nodos por clave (para qsort). */
+static inline int rueda_comparar_nodos(const void *a, const void *b) {
+    long long x = (*(NodoRueda *const *)a)->clave, y = (*(NodoRueda *const *)b)->clave;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Empieza un recorrido en orden. La rueda no debe cambiar mientras dure.
+ * @return 1 si se inicia, 0 si no hay memoria.
+ */
+static inline int rueda_recorrido_iniciar(RecorridoRueda *it, const RuedaTiempo *r) {
+    memset(it, 0, sizeof(*it));
+    it->r = r;
+    it->fase = RUEDA_ATRASADO;
+    return monticulo_rueda_recorrido_iniciar(&it->monticulo, &r->atrasados);
+}
+
+/** @brief Libera la memoria del recorrido. */
+static inline void rueda_recorrido_liberar(RecorridoRueda *it) {
+    monticulo_rueda_recorrido_liberar(&it->monticulo);
+    free(it->cubeta);
+    it->cubeta = NULL;
+}
+
+/** @brief Copia (y ordena si hace falta) una cubeta en el recorrido. */
+static inline int rueda_recorrido_cargar(RecorridoRueda *it, const CubetaRueda *c, int ordenar) {
+    if (c->tamano > it->capacidad) {
+        NodoRueda **copia = realloc(it->cubeta, sizeof(NodoRueda *) * (size_t)c->tamano);
+        if (copia == NULL) return 0;
+        it->cubeta = copia;
+        it->capacidad = c->tamano;
+    }
+    if (c->tamano > 0) memcpy(it->cubeta, c->nodos, sizeof(NodoRueda *) * (size_t)c->tamano);
+    if (ordenar && c->tamano > 1) qsort(it->cubeta, (size_t)c->tamano, sizeof(NodoRueda *), rueda_comparar_nodos);
+    it->tamano = c->tamano;
+    it->usados = 0;
+    return 1;
+}
+
+/**
+ * @brief Siguiente salida del recorrido en orden de clave.
+ * @param it Recorrido.
+ * @param nodo Recibe el nodo de la salida.
+ * @return 1 si hay salida, 0 si se ha terminado, -1 si no hay memoria.
+ */
+static inline int rueda_recorrido_siguiente(RecorridoRueda *it, NodoRueda **nodo) {
+    const RuedaTiempo *r = it->r;
+    for (;;) {
+        if (it->usados < it->tamano) {
+            *nodo = it->cubeta[it->usados++];
+            return 1;
+        }
+
+        int p;
+        switch (it->fase) {
+        case RUEDA_ATRASADO:
+        case RUEDA_LEJANO:
+            p = monticulo_rueda_recorrido_siguiente(&it->monticulo);
+            if (p == -2) return -1;
+            if (p >= 0) {
+                *nodo = (it->fase == RUEDA_ATRASADO ? &r->atrasados : &r->lejanos)->datos[p];
+                return 1;
+            }
+            monticulo_rueda_recorrido_liberar(&it->monticulo);
+            if (it->fase == RUEDA_LEJANO) return 0;
+            it->fase = RUEDA_MINUTO;
+            it->indice = (int)(r->ahora % 60);
+            break;
+
+        case RUEDA_MINUTO:
+            if (it->indice >= RUEDA_MINUTOS) {
+                it->fase = RUEDA_HORA;
+                it->indice = (int)(r->ahora / 60 % 24) + 1;
+            } else if (!rueda_recorrido_cargar(it, &r->minutos[it->indice++], 0)) {
+                return -1;
+            }
+            break;
+
+        case RUEDA_HORA:
+            if (it->indice >= RUEDA_HORAS) {
+                it->fase = RUEDA_DIA;
+                it->indice = 1;
+            } else if (!rueda_recorrido_cargar(it, &r->horas[it->indice++], 1)) {
+                return -1;
+            }
+            break;
+
+        case RUEDA_DIA:
+            if (it->indice >= RUEDA_DIAS) {
+                it->fase = RUEDA_LEJANO;
+                if (!monticulo_rueda_recorrido_iniciar(&it->monticulo, &r->lejanos)) return -1;
+            } else {
+                int b = (int)((r->ahora / 1440 + it->indice++) % RUEDA_DIAS);
+                if (!rueda_recorrido_cargar(it, &r->dias[b], 1)) return -1;
+            }
+            break;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef SELECCION_REEMPLAZO_H
+#define SELECCION_REEMPLAZO_H
+
+#include "libros_io.h"
+
+/**
+ * @file seleccion_reemplazo.h
+ * @brief Generación de secuencias iniciales por selección con reemplazo.
+ *
+ * Se mantiene en memoria un montículo de mínimos con a lo sumo M registros.
+ * En cada paso se emite el menor y se sustituye por el siguiente registro de
+ * la entrada: si es mayor o igual que el emitido aún cabe en la secuencia
+ * actual; si es menor, se marca para la secuencia siguiente. El montículo
+ * ordena por (secuencia, clave), así que una secuencia termina cuando todos
+ * los registros que quedan pertenecen ya a la siguiente.
+ *
+ * Con entradas aleatorias las secuencias miden de media 2·M registros, y una
+ * entrada ya ordenada produce una única secuencia. Los registros no se mueven
+ * dentro del búfer: el montículo guarda solo índices.
+ */
+
+/** @brief Registros en memoria por defecto (M) para la selección con reemplazo. */
+#define SELECCION_MEMORIA_DEFECTO 4096
+
+/**
+ * @brief Compara dos libros según la clave de ordenación.
+ * @return <0, 0 o >0 como strcmp.
+ */
+typedef int (*CompararLibros)(const Libro *a, const Libro *b);
+
+/**
+ * @brief Recibe cada registro emitido junto con el número de su secuencia (desde 0).
+ * @return 1 si se ha procesado correctamente, 0 para abortar.
+ */
+typedef int (*EmitirLibro)(const Libro *libro, long secuencia, void *ctx);
+
+/**
+ * @brief Compara libros por año de publicación.
+ */
+static inline int comparar_libros_anio(const Libro *a, const Libro *b) {
+    return (a->anioPublicacion > b->anioPublicacion) - (a->anioPublicacion < b->anioPublicacion);
+}
+
+/**
+ * @brief Compara libros por precio.
+ */
+static inline int comparar_libros_precio(const Libro *a, const Libro *b) {
+    return (a->precio > b->precio) - (a->precio < b->precio);
+}
+
+/**
+ * @brief Compara libros por título (orden de strcmp).
+ */
+static inline int comparar_libros_titulo(const Libro *a, const Libro *b) {
+    return strcmp(a->titulo, b->titulo);
+}
+
+/**
+ * @brief Devuelve la función de comparación de una clave de orden.
+ * @return El comparador, o NULL si la clave no es ordenable.
+ */
+static inline CompararLibros comparador_libros(ClaveOrden clave) {
+    switch (clave) {
+        case ORDEN_ANIO:   return comparar_libros_anio;
+        case ORDEN_PRECIO: return comparar_libros_precio;
+        case ORDEN_TITULO: return comparar_libros_titulo;
+        default:           return NULL;
+    }
+}
+
+/**
+ * @brief Estado del montículo de selección con reemplazo.
+ */
+typedef struct {
+    Libro *registros;     /**< Búfer de M registros. */
+    long *secuencia;      /**< Secuencia asignada a cada hueco del búfer. */
+    int *monticulo;       /**< Índices de huecos ordenados como montículo de mínimos. */
+    long n;               /**< Elementos en el montículo. */
+    CompararLibros cmp;   /**< Clave de ordenación. */
+} SeleccionReemplazo;
+
+/**
+ * @brief Indica si el hueco @p a debe salir antes que el hueco @p b.
+ */
+static inline int seleccion_menor(const SeleccionReemplazo *s, int a, int b) {
+    if (s->secuencia[a] != s->secuencia[b]) return s->secuencia[a] < s->secuencia[b];
+    return s->cmp(&s->registros[a], &s->registros[b]) < 0;
+}
+
+/**
+ * @brief Hunde el elemento de la posición @p i hasta restaurar el montículo.
+ */
+static inline void seleccion_hundir(SeleccionReemplazo *s, long i) {
+    int hueco = s->monticulo[i];
+    for (;;) {
+        long hijo = 2 * i + 1;
+        if (hijo >= s->n) break;
+        if (hijo + 1 < s->n && seleccion_menor(s, s->monticulo[hijo + 1], s->monticulo[hijo])) hijo++;
+        if (!seleccion_menor(s, s->monticulo[hijo], hueco)) break;
+        s->monticulo[i] = s->monticulo[hijo];
+        i = hijo;
+    }
+    s->monticulo[i] = hueco;
+}
+
+/**
+ * @brief Genera secuencias ordenadas a partir de @p entrada por selección con reemplazo.
+ *
+ * @param entrada Archivo de libros abierto para lectura.
+ * @param memoria Número máximo de registros en memoria (M).
+ * @param cmp Clave de ordenación.
+ * @param emitir Función que recibe cada registro con su número de secuencia,
+ *        en orden no decreciente dentro de cada secuencia.
+ * @param ctx Contexto para @p emitir.
+ * @return Número de secuencias generadas, o -1 si hubo un error.
+ */
+static inline long seleccion_reemplazo(ArchivoLibros *entrada, long memoria, CompararLibros cmp,
+                                       EmitirLibro emitir, void *ctx) {
+    SeleccionReemplazo s = {0};
+    if (memoria < 1) memoria = 1;
+    s.cmp = cmp;
+    s.registros = malloc(sizeof(Libro) * memoria);
+    s.secuencia = malloc(sizeof(long) * memoria);
+    s.monticulo = malloc(sizeof(int) * memoria);
+    if (!s.registros || !s.secuencia || !s.monticulo) {
+        perror("Error al reservar memoria para la selección con reemplazo");
+        free(s.registros); free(s.secuencia); free(s.monticulo);
+        return -1;
+    }
+
+    // 1. Llenar el búfer con los primeros M registros, todos de la secuencia 0
+    while (s.n < memoria && libros_leer(entrada, &s.registros[s.n])) {
+        s.secuencia[s.n] = 0;
+        s.monticulo[s.n] = (int)s.n;
+        s.n++;
+    }
+    for (long i = s.n / 2 - 1; i >= 0; i--) seleccion_hundir(&s, i);
+
+    // 2. Emitir el mínimo y reemplazarlo por el siguiente registro de la entrada
+    long secuencias = s.n > 0 ? 1 : 0;
+    int ok = 1;
+    Libro ultimo;
+    while (ok && s.n > 0) {
+        int hueco = s.monticulo[0];
+        long sec = s.secuencia[hueco];
+        if (sec + 1 > secuencias) secuencias = sec + 1;
+
+        ultimo = s.registros[hueco];
+        ok = emitir(&ultimo, sec, ctx);
+
+        if (libros_leer(entrada, &s.registros[hueco])) {
+            // Si es menor que el emitido ya no cabe en la secuencia actual
+            s.secuencia[hueco] = cmp(&s.registros[hueco], &ultimo) < 0 ? sec + 1 : sec;
+        } else {
+            // Entrada agotada: el montículo se va vaciando
+            s.monticulo[0] = s.monticulo[--s.n];
+        }
+        if (s.n > 0) seleccion_hundir(&s, 0);
+    }
+    if (libros_error(entrada)) ok = 0;
+
+    free(s.registros);
+    free(s.secuencia);
+    free(s.monticulo);
+    return ok ? secuencias : -1;
+}
+
+#endif // SELECCION_REEMPLAZO_H
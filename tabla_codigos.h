@@ -0,0 +1,274 @@
+#ifndef TABLA_CODIGOS_H
+#define TABLA_CODIGOS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @file tabla_codigos.h
+ * @brief Tabla hash de direccionamiento abierto (estilo Swiss table) indexada por códigos cortos.
+ *
+ * Los códigos de hasta @ref TABLA_CODIGO_MAX caracteres (los de vuelo son de
+ * 5) se empaquetan en un `uint64_t`, así que comparar dos claves es una sola
+ * comparación de enteros en lugar de un `strcmp`.
+ *
+ * Junto a las entradas se guarda un byte de control por hueco: vacío,
+ * borrado, o los 7 bits bajos del hash de la clave que lo ocupa. Los huecos
+ * se agrupan de 16 en 16 y una búsqueda compara los 16 bytes de control de
+ * un grupo a la vez (con SSE2 si está disponible, o byte a byte si no);
+ * solo se mira la clave de los huecos cuyo byte coincide. Si el grupo tiene
+ * algún hueco vacío la clave no está más allá; si no, se sigue por el grupo
+ * siguiente de la secuencia de sondeo (saltos triangulares entre grupos).
+ *
+ * El valor asociado a cada clave es un puntero opaco que la tabla no libera.
+ */
+
+/** @brief Caracteres máximos de un código que cabe en la clave de 64 bits. */
+#define TABLA_CODIGO_MAX 8
+
+/** @brief Huecos por grupo (los bytes de control que se comparan a la vez). */
+#define TABLA_GRUPO 16
+
+/** @brief Byte de control de un hueco que nunca se ha usado. */
+#define TABLA_VACIO ((int8_t)-128)
+
+/** @brief Byte de control de un hueco cuya clave se eliminó (lápida). */
+#define TABLA_BORRADO ((int8_t)-2)
+
+/**
+ * @struct EntradaTabla
+ * @brief Clave empaquetada y valor asociado.
+ */
+typedef struct {
+    uint64_t clave;
+    void *valor;
+} EntradaTabla;
+
+/**
+ * @struct TablaCodigos
+ * @brief Tabla hash de códigos empaquetados.
+ */
+typedef struct {
+    int8_t *control;        /**< Un byte por hueco, alineado a TABLA_GRUPO. */
+    EntradaTabla *entradas; /**< Huecos (capacidad). */
+    size_t capacidad;       /**< Número de huecos (potencia de 2, múltiplo de TABLA_GRUPO). */
+    size_t tamano;          /**< Claves almacenadas. */
+    size_t borrados;        /**< Lápidas, que también cuentan para la carga. */
+} TablaCodigos;
+
+/**
+ * @brief Empaqueta un código en una clave de 64 bits.
+ * @param codigo Cadena del código.
+ * @param clave Clave resultante.
+ * @return 1 si el código cabe, 0 si tiene más de TABLA_CODIGO_MAX caracteres.
+ */
+static inline int tabla_codigo_clave(const char *codigo, uint64_t *clave) {
+    size_t len = strlen(codigo);
+    if (len > TABLA_CODIGO_MAX) return 0;
+    uint64_t c = 0;
+    memcpy(&c, codigo, len);
+    *clave = c;
+    return 1;
+}
+
+/** @brief Mezcla los bits de la clave (finalizador de splitmix64). */
+static inline uint64_t tabla_hash(uint64_t x) {
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief Máscaras de un grupo: huecos cuyo control es @p h2, y huecos vacíos.
+ * @param control Los TABLA_GRUPO bytes de control del grupo.
+ * @param h2 Los 7 bits bajos del hash buscado.
+ * @param vacios Bit i a 1 si el hueco i está vacío.
+ * @return Bit i a 1 si el control del hueco i coincide con @p h2.
+ */
+static inline unsigned tabla_grupo_coincidencias(const int8_t *control, int8_t h2, unsigned *vacios) {
+#if defined(__SSE2__)
+    __m128i g = _mm_load_si128((const __m128i *)control);
+    *vacios = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(TABLA_VACIO)));
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(h2)));
+#else
+    unsigned m = 0, v = 0;
+    for (int i = 0; i < TABLA_GRUPO; i++) {
+        m |= (unsigned)(control[i] == h2) << i;
+        v |= (unsigned)(control[i] == TABLA_VACIO) << i;
+    }
+    *vacios = v;
+    return m;
+#endif
+}
+
+/**
+ * @brief Huecos libres (vacíos o borrados) de un grupo: los de control negativo.
+ */
+static inline unsigned tabla_grupo_libres(const int8_t *control) {
+#if defined(__SSE2__)
+    return (unsigned)_mm_movemask_epi8(_mm_load_si128((const __m128i *)control));
+#else
+    unsigned m = 0;
+    for (int i = 0; i < TABLA_GRUPO; i++) m |= (unsigned)(control[i] < 0) << i;
+    return m;
+#endif
+}
+
+/** @brief Índice del bit a 1 más bajo de una máscara no nula. */
+static inline int tabla_primer_bit(unsigned m) {
+#if defined(__GNUC__)
+    return __builtin_ctz(m);
+#else
+    int i = 0;
+    while (!(m & 1u)) { m >>= 1; i++; }
+    return i;
+#endif
+}
+
+/**
+ * @brief Reserva una tabla vacía con al menos @p capacidad huecos.
+ * @return 1 si se ha reservado, 0 sin memoria.
+ */
+static inline int tabla_crear(TablaCodigos *t, size_t capacidad) {
+    size_t cap = TABLA_GRUPO;
+    while (cap < capacidad) cap *= 2;
+    memset(t, 0, sizeof(*t));
+    t->control = aligned_alloc(TABLA_GRUPO, cap);
+    t->entradas = malloc(sizeof(EntradaTabla) * cap);
+    if (!t->control || !t->entradas) {
+        free(t->control); free(t->entradas);
+        t->control = NULL; t->entradas = NULL;
+        return 0;
+    }
+    memset(t->control, TABLA_VACIO, cap);
+    t->capacidad = cap;
+    return 1;
+}
+
+/** @brief Libera la tabla (no los valores). */
+static inline void tabla_liberar(TablaCodigos *t) {
+    free(t->control); free(t->entradas);
+    memset(t, 0, sizeof(*t));
+}
+
+/**
+ * @brief Posición de una clave en la tabla.
+ * @return Índice del hueco, o -1 si la clave no está.
+ */
+static inline long tabla_posicion(const TablaCodigos *t, uint64_t clave) {
+    uint64_t h = tabla_hash(clave);
+    int8_t h2 = (int8_t)(h & 0x7f);
+    size_t grupos = t->capacidad / TABLA_GRUPO;
+    size_t g = (size_t)(h >> 7) & (grupos - 1);
+
+    for (size_t salto = 1; salto <= grupos; salto++) {
+        const int8_t *control = t->control + g * TABLA_GRUPO;
+        unsigned vacios;
+        unsigned m = tabla_grupo_coincidencias(control, h2, &vacios);
+        while (m) {
+            size_t i = g * TABLA_GRUPO + (size_t)tabla_primer_bit(m);
+            if (t->entradas[i].clave == clave) return (long)i;
+            m &= m - 1;
+        }
+        if (vacios) return -1;
+        g = (g + salto) & (grupos - 1);
+    }
+    return -1;
+}
+
+/**
+ * @brief Busca una clave.
+ * @return El valor asociado, o NULL si la clave no está.
+ */
+static inline void *tabla_buscar(const TablaCodigos *t, uint64_t clave) {
+    long i = tabla_posicion(t, clave);
+    return i < 0 ? NULL : t->entradas[i].valor;
+}
+
+/** @brief Coloca una clave que se sabe ausente en el primer hueco libre de su secuencia de sondeo. */
+static inline void tabla_colocar(TablaCodigos *t, uint64_t clave, void *valor) {
+    uint64_t h = tabla_hash(clave);
+    size_t grupos = t->capacidad / TABLA_GRUPO;
+    size_t g = (size_t)(h >> 7) & (grupos - 1);
+
+    for (size_t salto = 1; ; salto++) {
+        unsigned libres = tabla_grupo_libres(t->control + g * TABLA_GRUPO);
+        if (libres) {
+            size_t i = g * TABLA_GRUPO + (size_t)tabla_primer_bit(libres);
+            if (t->control[i] == TABLA_BORRADO) t->borrados--;
+            t->control[i] = (int8_t)(h & 0x7f);
+            t->entradas[i].clave = clave;
+            t->entradas[i].valor = valor;
+            t->tamano++;
+            return;
+        }
+        g = (g + salto) & (grupos - 1);
+    }
+}
+
+/**
+ * @brief Reconstruye la tabla con @p capacidad huecos, descartando las lápidas.
+ * @return 1 si se ha reconstruido, 0 sin memoria (la tabla queda como estaba).
+ */
+static inline int tabla_redimensionar(TablaCodigos *t, size_t capacidad) {
+    TablaCodigos nueva;
+    if (!tabla_crear(&nueva, capacidad)) return 0;
+    for (size_t i = 0; i < t->capacidad; i++) {
+        if (t->control[i] >= 0) tabla_colocar(&nueva, t->entradas[i].clave, t->entradas[i].valor);
+    }
+    tabla_liberar(t);
+    *t = nueva;
+    return 1;
+}
+
+/**
+ * @brief Inserta una clave con su valor.
+ *
+ * Si la carga (claves más lápidas) llega a 7/8 de la capacidad, la tabla se
+ * reconstruye: al doble si está llena de claves, o del mismo tamaño si lo que
+ * sobra son lápidas.
+ *
+ * @return 1 si se inserta, 0 si la clave ya estaba, -1 sin memoria.
+ */
+static inline int tabla_insertar(TablaCodigos *t, uint64_t clave, void *valor) {
+    if (tabla_posicion(t, clave) >= 0) return 0;
+    if ((t->tamano + t->borrados + 1) * 8 > t->capacidad * 7) {
+        size_t cap = (t->tamano + 1) * 8 > t->capacidad * 4 ? t->capacidad * 2 : t->capacidad;
+        if (!tabla_redimensionar(t, cap)) return -1;
+    }
+    tabla_colocar(t, clave, valor);
+    return 1;
+}
+
+/**
+ * @brief Elimina una clave.
+ *
+ * Si el grupo del hueco conserva algún hueco vacío, ninguna secuencia de
+ * sondeo ha pasado de largo por él y el hueco vuelve a quedar vacío; si no,
+ * se deja una lápida.
+ *
+ * @return 1 si se elimina, 0 si la clave no estaba.
+ */
+static inline int tabla_eliminar(TablaCodigos *t, uint64_t clave) {
+    long i = tabla_posicion(t, clave);
+    if (i < 0) return 0;
+    const int8_t *grupo = t->control + (size_t)i / TABLA_GRUPO * TABLA_GRUPO;
+    unsigned vacios;
+    tabla_grupo_coincidencias(grupo, 0, &vacios);
+    if (vacios) {
+        t->control[i] = TABLA_VACIO;
+    } else {
+        t->control[i] = TABLA_BORRADO;
+        t->borrados++;
+    }
+    t->tamano--;
+    return 1;
+}
+
+#endif // TABLA_CODIGOS_H
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include "common.h"
+#include "libros_io.h"
+#include "indice_titulos.h"
+#include "indice_prestado.h"
 
 /**
  * @file txt_a_bin.c
@@ -15,8 +18,8 @@
  *     titulo;autor;anio;prestado;precio
  *
  * Campos:
- *  - titulo: hasta 99 caracteres.
- *  - autor: hasta 99 caracteres.
+ *  - titulo: hasta 80 caracteres (CAD_TITULO - 1).
+ *  - autor: hasta 50 caracteres (CAD_AUTOR - 1).
  *  - anio: año de publicación (entero).
  *  - prestado: cadena indicando si el libro está prestado (sí/no).
  *  - precio: valor en punto flotante (double).
@@ -27,8 +30,14 @@
  * Funcionamiento:
  *  - Se leen todas las líneas del archivo de texto.
  *  - Se valida que cada línea contenga los 5 campos requeridos.
- *  - Se escriben los registros correctamente formateados en el archivo binario.
+ *  - Se escriben los registros correctamente formateados en el archivo binario,
+ *    precedidos de la cabecera con versión, número de registros y suma de control
+ *    (ver `libros_io.h`).
  *  - Las líneas mal formadas se omiten con aviso en stderr.
+ *  - Al terminar se reconstruyen el índice de títulos (`libros_biblioteca.idx`,
+ *    ver `indice_titulos.h`) y los mapas de bits de préstamo
+ *    (`libros_biblioteca_prestado.idx`, ver `indice_prestado.h`) para que
+ *    sigan correspondiendo a los datos.
  *
  * @return 0 si la conversión se realiza correctamente, 1 en caso de error.
  */
@@ -41,10 +50,9 @@ int main(void) {
         return 1;
     }
     
-    // Abrir archivo binario para escritura
-    FILE *fout = fopen("libros_biblioteca.bin", "wb");
-    if (!fout) {
-        perror("fopen libros_biblioteca.bin");
+    // Crear archivo binario con cabecera
+    ArchivoLibros fout;
+    if (!libros_crear(&fout, NOMBRE_ARCHIVO, ORDEN_NINGUNO)) {
         fclose(fin);
         return 1;
     }
@@ -61,8 +69,9 @@ int main(void) {
         memset(&L, 0, sizeof(L)); 
         
         // Leer campos separados por ';'
-        // %99[^;] lee hasta 99 caracteres o hasta encontrar ';' (para evitar desbordamiento)
-        int n = fscanf(fin, "%99[^;];%99[^;];%d;%2[^;];%lf",
+        // El espacio inicial descarta el salto de línea del registro anterior;
+        // %80[^;] lee hasta 80 caracteres o hasta encontrar ';' (para evitar desbordamiento)
+        int n = fscanf(fin, " %80[^;];%50[^;];%d;%2[^;];%lf",
                        L.titulo, L.autor, &L.anioPublicacion, L.prestado, &L.precio);
         
         if (n == EOF) break; // Fin de archivo
@@ -78,20 +87,36 @@ int main(void) {
         }
         
         // Escribir registro en archivo binario
-        if (fwrite(&L, sizeof(Libro), 1, fout) != 1) {
+        if (!libros_anadir(&fout, &L)) {
             perror("fwrite");
             fclose(fin);
-            fclose(fout);
+            libros_cerrar(&fout);
             return 1;
         }
         
         ++escritos;
     }
     
-    // Cerrar archivos
+    // Cerrar archivos (al cerrar se actualiza la cabecera)
     fclose(fin);
-    fclose(fout);
+    if (!libros_cerrar(&fout)) {
+        perror("Error al escribir la cabecera de " NOMBRE_ARCHIVO);
+        return 1;
+    }
 
     printf("OK: escritos %d registros en 'libros_biblioteca.bin'\n", escritos);
+
+    // Mantener sincronizado el índice de títulos con los datos recién escritos
+    if (indice_titulos_construir(NOMBRE_ARCHIVO, NOMBRE_INDICE_TITULOS) < 0) {
+        fprintf(stderr, "Aviso: no se pudo actualizar '" NOMBRE_INDICE_TITULOS "'.\n");
+        return 1;
+    }
+    printf("OK: índice de títulos actualizado en '" NOMBRE_INDICE_TITULOS "'\n");
+
+    if (indice_prestado_construir(NOMBRE_ARCHIVO, NOMBRE_INDICE_PRESTADO) < 0) {
+        fprintf(stderr, "Aviso: no se pudo actualizar '" NOMBRE_INDICE_PRESTADO "'.\n");
+        return 1;
+    }
+    printf("OK: mapas de préstamo actualizados en '" NOMBRE_INDICE_PRESTADO "'\n");
     return 0;
 }
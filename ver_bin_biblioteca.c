@@ -1,4 +1,5 @@
 #include "common.h"
+#include "libros_io.h"
 
 /**
  * @file ver_bin_biblioteca.c
@@ -17,7 +18,8 @@
  *
  * Requisitos:
  *  - El archivo binario debe existir y contener registros válidos de tipo `Libro`.
- *  - Incluye la cabecera `common.h` donde se define la estructura `Libro`.
+ *  - Incluye la cabecera `common.h` donde se define la estructura `Libro`
+ *    y `libros_io.h` para leer la cabecera del archivo.
  *
  * Funciones principales:
  *  - `void mostrar_libros(const char *nombreArchivo)`: Muestra en pantalla todos los libros.
@@ -25,8 +27,8 @@
 
 void mostrar_libros(const char *nombreArchivo) {
     // Abrir archivo en modo lectura binaria
-    FILE *f = fopen(nombreArchivo, "rb");
-    if (!f) { 
+    ArchivoLibros f;
+    if (!libros_abrir(&f, nombreArchivo)) { 
         printf("¡ERROR! Archivo '%s' no encontrado. Asegúrate de que existe.\n", nombreArchivo);
         return; 
     }
@@ -35,6 +37,10 @@ void mostrar_libros(const char *nombreArchivo) {
     // Separador para la tabla (~86 caracteres)
     const char *separador = "--------------------------------------------------------------------------------------";
     
+    // El número de registros se lee de la cabecera, sin recorrer el archivo
+    printf("Registros: %ld | Formato: v%u | Orden: %s\n",
+           libros_total(&f), f.cab.version, libros_nombre_orden((ClaveOrden)f.cab.clave_orden));
+
     // Imprimir cabecera de la tabla
     printf("%s\n", separador);
     printf("%-5s | %-5s | %-35s | %-20s | %-8s | %-8s |\n", 
@@ -43,7 +49,7 @@ void mostrar_libros(const char *nombreArchivo) {
 
     int i = 0;  ///< Contador de registros
     // Leer registros hasta fin de archivo
-    while (fread(&libro, sizeof(Libro), 1, f) == 1) {
+    while (libros_leer(&f, &libro)) {
         // Imprimir cada libro en fila con columnas alineadas
         printf("%-5d | %-5d | %-35s | %-20s | %-8s | %-8.2f |\n",
                ++i, 
@@ -56,5 +62,5 @@ void mostrar_libros(const char *nombreArchivo) {
 
     // Imprimir línea final y cerrar archivo
     printf("%s\n", separador);
-    fclose(f);
+    libros_cerrar(&f);
 }